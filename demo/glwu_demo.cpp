@@ -26,6 +26,8 @@ int main() {
 	glwu::Line* _line = _server->fetch_object<glwu::Line>();
 	glwu::LinedRect* _lined_rect = _server->fetch_object<glwu::LinedRect>();
 	glwu::RoundedColorRect* _rounded_color_rect = _server->fetch_object<glwu::RoundedColorRect>();
+	glwu::Polyline* _polyline = _server->fetch_object<glwu::Polyline>();
+	glwu::ParticleSystem* _particles = _server->fetch_object<glwu::ParticleSystem>();
 
 	_cam->set_position({ _window_width / 2, _window_height / 2 });
 
@@ -39,11 +41,34 @@ int main() {
 	_rounded_color_rect->set_outline_width(2.0f);
 	_rounded_color_rect->set_outline_color({1.0f, 1.0f, 1.0f, 1.0f});
 
+	_polyline->set_capacity(256);
+	_polyline->set_width(3.0f);
+	_polyline->set_join(glwu::LineJoin::Round);
+	_polyline->set_cap(glwu::LineCap::Round);
+
+	glwu::ParticleEmitterConfig _particle_cfg; {
+		_particle_cfg.Rate = 2000.0f;
+		_particle_cfg.Spread = 0.8f;
+		_particle_cfg.SpeedRange = { 150.0f, 300.0f };
+		_particle_cfg.LifetimeRange = { 0.5f, 1.5f };
+		_particle_cfg.Acceleration = { 0.0f, 400.0f };
+		_particle_cfg.StartColor = { 1.0f, 0.8f, 0.3f, 1.0f };
+		_particle_cfg.EndColor = { 1.0f, 0.2f, 0.0f, 0.0f };
+		_particle_cfg.Additive = true;
+	}
+	_particles->set_capacity(4096);
+	_particles->set_config(_particle_cfg);
+	_particles->set_position({ _window_width / 2, _window_height - 100.0f });
+
 	_objects.emplace_back(_cam);
 	_objects.emplace_back(_color_rect);
 	_objects.emplace_back(_line);
 	_objects.emplace_back(_lined_rect);
 	_objects.emplace_back(_rounded_color_rect);
+	_objects.emplace_back(_polyline);
+	_objects.emplace_back(_particles);
+
+	float _polyline_phase = 0.0f;
 
 	glw::Context::clear_color(0.4f, 0.5f, 0.3f, 1.0f);
 
@@ -83,6 +108,8 @@ int main() {
 			if (_window->get_key_is_held(glw::Key::E)) {
 				_cam->set_rotation(_cam->get_rotation() + _angular_speed);
 			}
+			_polyline_phase += 0.002f;
+			_polyline->push_back({ _window_width / 2 + std::cos(_polyline_phase) * 200.0f, _window_height / 2 + std::sin(_polyline_phase * 3.0f) * 120.0f });
 			for (auto& _object : _objects) {
 				_object->update();
 			}
@@ -93,6 +120,7 @@ int main() {
 				_object->draw(_cam);
 			}
 		}
+		_server->end_frame();
 		glw::Context::swap_buffers(_window);
 		glw::Context::poll_events();
 	}
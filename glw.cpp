@@ -13,6 +13,10 @@ namespace glw {
 		glfwMakeContextCurrent(_target->get());
 	}
 
+	void Context::release_current() {
+		glfwMakeContextCurrent(nullptr);
+	}
+
 	void Context::activate() {
 		int _glad_err_code = gladLoadGLLoader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress));
 		if (_glad_err_code != 1) {
@@ -36,6 +40,23 @@ namespace glw {
 		return static_cast<ErrorType>(glGetError());
 	}
 
+	ContextState* Context::get_state() noexcept {
+		GLFWwindow* _current = glfwGetCurrentContext();
+		if (_current == nullptr) {
+			return nullptr;
+		}
+		Window* _window = reinterpret_cast<Window*>(glfwGetWindowUserPointer(_current));
+		return (_window != nullptr) ? &_window->get_context_state() : nullptr;
+	}
+
+	void Context::flush() {
+		glFlush();
+	}
+
+	void Context::finish() {
+		glFinish();
+	}
+
 	void Context::swap_buffers(Window* _target) {
 		glfwSwapBuffers(_target->get());
 	}
@@ -44,6 +65,47 @@ namespace glw {
 		glfwPollEvents();
 	}
 
+	void Context::wait_events() noexcept {
+		glfwWaitEvents();
+	}
+
+	void Context::wait_events_timeout(double _seconds) noexcept {
+		glfwWaitEventsTimeout(_seconds);
+	}
+
+	void Context::post_empty_event() noexcept {
+		glfwPostEmptyEvent();
+	}
+
+	void Context::run_render_thread(Window* _target, const std::function<bool()>& _frame) {
+		std::atomic<bool> _running { true };
+		std::exception_ptr _error = nullptr;
+
+		/* A context can only be current on one thread at a time */
+		glfwMakeContextCurrent(nullptr);
+		std::thread _render_thread([&]() {
+			glfwMakeContextCurrent(_target->get());
+			try {
+				while (_frame()) { }
+			}
+			catch (...) {
+				_error = std::current_exception();
+			}
+			glfwMakeContextCurrent(nullptr);
+			_running.store(false, std::memory_order_release);
+			glfwPostEmptyEvent();
+		});
+		while (_running.load(std::memory_order_acquire)) {
+			glfwWaitEvents();
+		}
+		_render_thread.join();
+		glfwMakeContextCurrent(_target->get());
+
+		if (_error != nullptr) {
+			std::rethrow_exception(_error);
+		}
+	}
+
 	void Context::viewport(int _xpos, int _ypos, uint32_t _width, uint32_t _height) {
 		glViewport(_xpos, _ypos, static_cast<int>(_width), static_cast<int>(_height));
 	}
@@ -57,6 +119,12 @@ namespace glw {
 		_out_height = static_cast<uint32_t>(_vp[3]);
 	}
 
+	uint32_t Context::get_frame_buffer_binding() {
+		GLint _id = 0;
+		glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &_id);
+		return static_cast<uint32_t>(_id);
+	}
+
 	bool Context::get_is_enabled(CapabilityType _type) {
 		return glIsEnabled(static_cast<GLenum>(_type));
 	}
@@ -111,6 +179,14 @@ namespace glw {
 		glVertexAttribPointer(_offset_index, _count, static_cast<uint32_t>(_type), _norm, static_cast<GLsizei>(_stride), reinterpret_cast<const GLvoid*>(_offset));
 	}
 
+	void Context::vertex_attrib_divisor(const uint32_t& _offset_index, const uint32_t& _divisor) {
+		glVertexAttribDivisor(_offset_index, _divisor);
+	}
+
+	void Context::set_vertex_attrib_vec4(const uint32_t& _offset_index, float _x, float _y, float _z, float _w) {
+		glVertexAttrib4f(_offset_index, _x, _y, _z, _w);
+	}
+
 	void Context::delete_vertex_array(const uint32_t& _id) {
 		glDeleteVertexArrays(1, &_id);
 	}
@@ -137,6 +213,14 @@ namespace glw {
 		glBufferSubData(static_cast<GLenum>(_type), _offset, _data.get_length(), _data.get_pointer());
 	}
 
+	void Context::bind_array_buffer_sub_data(const ArrayBufferType& _type, const void* _data, const size_t& _length, const size_t& _offset) {
+		glBufferSubData(static_cast<GLenum>(_type), _offset, _length, _data);
+	}
+
+	void Context::bind_buffer_base(const ArrayBufferType& _type, const uint32_t& _index, const uint32_t& _id) {
+		glBindBufferBase(static_cast<GLenum>(_type), _index, _id);
+	}
+
 	void Context::delete_buffer(const uint32_t& _id) {
 		glDeleteBuffers(1, &_id);
 	}
@@ -151,8 +235,13 @@ namespace glw {
 		glBindFramebuffer(GL_FRAMEBUFFER, _id);
 	}
 
-	void Context::attach_texture_2d(const uint32_t& _fbo, AttachmentType _type, const uint32_t& _id) {
-		glFramebufferTexture2D(GL_FRAMEBUFFER, static_cast<GLenum>(_type), GL_TEXTURE_2D, _id, 0);
+	void Context::attach_texture_2d(const uint32_t& _fbo, AttachmentType _type, const uint32_t& _id, TextureTarget _target) {
+		glFramebufferTexture2D(GL_FRAMEBUFFER, static_cast<GLenum>(_type), static_cast<GLenum>(_target), _id, 0);
+		Context::check_framebuffer_link_status();
+	}
+
+	void Context::attach_texture_layer(const uint32_t&, AttachmentType _type, const uint32_t& _id, const uint32_t& _layer) {
+		glFramebufferTextureLayer(GL_FRAMEBUFFER, static_cast<GLenum>(_type), _id, 0, static_cast<GLint>(_layer));
 		Context::check_framebuffer_link_status();
 	}
 
@@ -172,10 +261,34 @@ namespace glw {
 		glDeleteFramebuffers(1, &_id);
 	}
 
+	void Context::invalidate_frame_buffer(const std::vector<AttachmentType>& _attachments) {
+		if (_attachments.empty() || (GLAD_GL_VERSION_4_3 == 0 && GLAD_GL_ARB_invalidate_subdata == 0)) {
+			return;
+		}
+		glInvalidateFramebuffer(GL_FRAMEBUFFER, static_cast<GLsizei>(_attachments.size()), reinterpret_cast<const GLenum*>(_attachments.data()));
+	}
+
+	void Context::blit_frame_buffer(const uint32_t& _src, const uint32_t& _dst, int _src_x0, int _src_y0, int _src_x1, int _src_y1, int _dst_x0, int _dst_y0, int _dst_x1, int _dst_y1, BufferType _mask, FilterType _filter) {
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, _src);
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, _dst);
+		glBlitFramebuffer(_src_x0, _src_y0, _src_x1, _src_y1, _dst_x0, _dst_y0, _dst_x1, _dst_y1, static_cast<GLbitfield>(_mask), static_cast<GLenum>(_filter));
+		glBindFramebuffer(GL_FRAMEBUFFER, _dst);
+	}
+
+	uint32_t Context::get_max_samples() {
+		GLint _samples = 0;
+		glGetIntegerv(GL_MAX_SAMPLES, &_samples);
+		return static_cast<uint32_t>(_samples);
+	}
+
 	void Context::read_buffer(ReadBufferType _type) {
 		glReadBuffer(static_cast<GLenum>(_type));
 	}
 
+	void Context::draw_buffers(const std::vector<AttachmentType>& _attachments) {
+		glDrawBuffers(static_cast<GLsizei>(_attachments.size()), reinterpret_cast<const GLenum*>(_attachments.data()));
+	}
+
 	void Context::draw_buffer(DrawBufferType _type) {
 		glDrawBuffer(static_cast<GLenum>(_type));
 	}
@@ -194,6 +307,10 @@ namespace glw {
 		glRenderbufferStorage(GL_RENDERBUFFER, static_cast<GLenum>(_format), _width, _height);
 	}
 
+	void Context::set_render_buffer_storage_multisample(InternalFormat _format, const uint32_t& _width, const uint32_t& _height, const uint32_t& _samples) {
+		glRenderbufferStorageMultisample(GL_RENDERBUFFER, static_cast<GLsizei>(_samples), static_cast<GLenum>(_format), _width, _height);
+	}
+
 	void Context::delete_render_buffer(const uint32_t& _id) {
 		glDeleteRenderbuffers(1, &_id);
 	}
@@ -204,22 +321,81 @@ namespace glw {
 		return _id;
 	}
 
-	void Context::set_filter(FilterType _mag, FilterType _min) {
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, static_cast<GLint>(_mag));
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, static_cast<GLint>(_min));
+	void Context::set_filter(FilterType _mag, FilterType _min, TextureTarget _target) {
+		glTexParameteri(static_cast<GLenum>(_target), GL_TEXTURE_MAG_FILTER, static_cast<GLint>(_mag));
+		glTexParameteri(static_cast<GLenum>(_target), GL_TEXTURE_MIN_FILTER, static_cast<GLint>(_min));
 	}
 
-	void Context::set_wrapping_mode(WrappingType _s, WrappingType _t) {
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, static_cast<GLint>(_s));
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, static_cast<GLint>(_t));
+	void Context::set_wrapping_mode(WrappingType _s, WrappingType _t, TextureTarget _target) {
+		glTexParameteri(static_cast<GLenum>(_target), GL_TEXTURE_WRAP_S, static_cast<GLint>(_s));
+		glTexParameteri(static_cast<GLenum>(_target), GL_TEXTURE_WRAP_T, static_cast<GLint>(_t));
 	}
 
 	void Context::set_image(const unsigned char* _data, uint32_t _width, uint32_t _height, InternalFormat _i_format, TextureFormat _t_format, DataType _type) {
 		glTexImage2D(GL_TEXTURE_2D, 0, static_cast<GLint>(_i_format), _width, _height, 0, static_cast<GLenum>(_t_format), static_cast<GLenum>(_type), _data);
 	}
 
-	void Context::generate_mipmap() {
-		glGenerateMipmap(GL_TEXTURE_2D);
+	void Context::set_image_multisample(uint32_t _width, uint32_t _height, uint32_t _samples, InternalFormat _i_format) {
+		glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, static_cast<GLsizei>(_samples), static_cast<GLenum>(_i_format), _width, _height, GL_TRUE);
+	}
+
+	void Context::set_image_layers(const unsigned char* _data, uint32_t _width, uint32_t _height, uint32_t _layers, InternalFormat _i_format, TextureFormat _t_format, DataType _type) {
+		glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, static_cast<GLint>(_i_format), _width, _height, _layers, 0, static_cast<GLenum>(_t_format), static_cast<GLenum>(_type), _data);
+	}
+
+	void Context::set_image_layer(const unsigned char* _data, uint32_t _layer, uint32_t _width, uint32_t _height, TextureFormat _t_format, DataType _type) {
+		glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, static_cast<GLint>(_layer), _width, _height, 1, static_cast<GLenum>(_t_format), static_cast<GLenum>(_type), _data);
+	}
+
+	void Context::set_image_level(const unsigned char* _data, uint32_t _level, uint32_t _width, uint32_t _height, InternalFormat _i_format, TextureFormat _t_format, DataType _type) {
+		glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(_level), static_cast<GLint>(_i_format), _width, _height, 0, static_cast<GLenum>(_t_format), static_cast<GLenum>(_type), _data);
+	}
+
+	void Context::set_compressed_image(const void* _data, size_t _length, uint32_t _level, uint32_t _width, uint32_t _height, InternalFormat _i_format) {
+		glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(_level), static_cast<GLenum>(_i_format), _width, _height, 0, static_cast<GLsizei>(_length), _data);
+	}
+
+	void Context::set_unpack_alignment(uint32_t _alignment) {
+		glPixelStorei(GL_UNPACK_ALIGNMENT, static_cast<GLint>(_alignment));
+	}
+
+	void Context::set_level_range(uint32_t _base, uint32_t _max, TextureTarget _target) {
+		glTexParameteri(static_cast<GLenum>(_target), GL_TEXTURE_BASE_LEVEL, static_cast<GLint>(_base));
+		glTexParameteri(static_cast<GLenum>(_target), GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(_max));
+	}
+
+	void Context::get_level_size(uint32_t _level, uint32_t& _out_width, uint32_t& _out_height, TextureTarget _target) {
+		int _width = 0, _height = 0;
+		glGetTexLevelParameteriv(static_cast<GLenum>(_target), static_cast<GLint>(_level), GL_TEXTURE_WIDTH, &_width);
+		glGetTexLevelParameteriv(static_cast<GLenum>(_target), static_cast<GLint>(_level), GL_TEXTURE_HEIGHT, &_height);
+		_out_width = static_cast<uint32_t>(_width);
+		_out_height = static_cast<uint32_t>(_height);
+	}
+
+	bool Context::get_level_is_compressed(uint32_t _level, TextureTarget _target) {
+		int _compressed = 0;
+		glGetTexLevelParameteriv(static_cast<GLenum>(_target), static_cast<GLint>(_level), GL_TEXTURE_COMPRESSED, &_compressed);
+		return _compressed != 0;
+	}
+
+	InternalFormat Context::get_level_internal_format(uint32_t _level, TextureTarget _target) {
+		int _format = 0;
+		glGetTexLevelParameteriv(static_cast<GLenum>(_target), static_cast<GLint>(_level), GL_TEXTURE_INTERNAL_FORMAT, &_format);
+		return static_cast<InternalFormat>(_format);
+	}
+
+	size_t Context::get_compressed_image_size(uint32_t _level, TextureTarget _target) {
+		int _size = 0;
+		glGetTexLevelParameteriv(static_cast<GLenum>(_target), static_cast<GLint>(_level), GL_TEXTURE_COMPRESSED_IMAGE_SIZE, &_size);
+		return static_cast<size_t>(_size);
+	}
+
+	void Context::get_compressed_image(uint32_t _level, void* _out, TextureTarget _target) {
+		glGetCompressedTexImage(static_cast<GLenum>(_target), static_cast<GLint>(_level), _out);
+	}
+
+	void Context::generate_mipmap(TextureTarget _target) {
+		glGenerateMipmap(static_cast<GLenum>(_target));
 	}
 
 	void Context::activate_texture(const TextureSlot& _slot) {
@@ -230,6 +406,10 @@ namespace glw {
 		glBindTexture(GL_TEXTURE_2D, _id);
 	}
 
+	void Context::bind_texture(const TextureTarget& _target, const uint32_t& _id) {
+		glBindTexture(static_cast<GLenum>(_target), _id);
+	}
+
 	void Context::delete_texture(const uint32_t& _id) {
 		glDeleteTextures(1, &_id);
 	}
@@ -247,10 +427,42 @@ namespace glw {
 		Context::check_shader_compile_status(_type, _id);
 	}
 
+	void Context::compile_shader_deferred(const uint32_t& _id) {
+		glCompileShader(_id);
+	}
+
+	bool Context::get_shader_compile_completion(const uint32_t& _id) {
+		if (Context::get_parallel_shader_compile_supported() == false) {
+			return true;
+		}
+		int _complete = 0;
+		glGetShaderiv(_id, GL_COMPLETION_STATUS_KHR, &_complete);
+		return _complete != 0;
+	}
+
 	void Context::delete_shader(const uint32_t& _id) {
 		glDeleteShader(_id);
 	}
 
+	bool Context::get_parallel_shader_compile_supported() {
+		ContextState* _state = Context::get_state();
+		return (_state != nullptr) ? _state->get_parallel_shader_compile_supported() : Context::_query_parallel_shader_compile_supported();
+	}
+
+	bool Context::_query_parallel_shader_compile_supported() {
+#ifdef GL_KHR_parallel_shader_compile
+		if (GLAD_GL_KHR_parallel_shader_compile != 0) {
+			return true;
+		}
+#endif
+#ifdef GL_ARB_parallel_shader_compile
+		if (GLAD_GL_ARB_parallel_shader_compile != 0) {
+			return true;
+		}
+#endif
+		return false;
+	}
+
 	void Context::check_shader_compile_status(const ShaderType& _type, const uint32_t& _id) {
 		int _success = 0;
 		glGetShaderiv(_id, GL_COMPILE_STATUS, &_success);
@@ -291,6 +503,10 @@ namespace glw {
 		glUniform1f(_loc, _value);
 	}
 
+	void Context::set_uniform_floats(const int& _loc, const float* _ptr, uint32_t _count) {
+		glUniform1fv(_loc, static_cast<GLsizei>(_count), _ptr);
+	}
+
 	void Context::set_uniform_vec2(const int& _loc, float _x, float _y) {
 		glUniform2f(_loc, _x, _y);
 	}
@@ -315,6 +531,14 @@ namespace glw {
 		glUniformMatrix4fv(_loc, 1, GL_FALSE, _ptr);
 	}
 
+	void Context::get_compute_work_group_size(const uint32_t& _id, uint32_t& _out_x, uint32_t& _out_y, uint32_t& _out_z) {
+		int _size[3] = { 0 };
+		glGetProgramiv(_id, GL_COMPUTE_WORK_GROUP_SIZE, &_size[0]);
+		_out_x = static_cast<uint32_t>(_size[0]);
+		_out_y = static_cast<uint32_t>(_size[1]);
+		_out_z = static_cast<uint32_t>(_size[2]);
+	}
+
 	void Context::use_program(const uint32_t& _id) {
 		glUseProgram(_id);
 	}
@@ -323,15 +547,82 @@ namespace glw {
 		glAttachShader(_program, _shader);
 	}
 
+	void Context::transform_feedback_varyings(const uint32_t& _id, const char* const* _varyings, const uint32_t& _count, TransformFeedbackBufferMode _mode) {
+		glTransformFeedbackVaryings(_id, static_cast<GLsizei>(_count), _varyings, static_cast<GLenum>(_mode));
+	}
+
 	void Context::link_program(const uint32_t& _id) {
 		glLinkProgram(_id);
 		Context::check_program_link_status(_id);
 	}
 
+	void Context::link_program_deferred(const uint32_t& _id) {
+		glLinkProgram(_id);
+	}
+
+	bool Context::get_program_link_completion(const uint32_t& _id) {
+		if (Context::get_parallel_shader_compile_supported() == false) {
+			return true;
+		}
+		int _complete = 0;
+		glGetProgramiv(_id, GL_COMPLETION_STATUS_KHR, &_complete);
+		return _complete != 0;
+	}
+
 	void Context::delete_program(const uint32_t& _id) {
 		glDeleteProgram(_id);
 	}
 
+	bool Context::get_program_binary_supported() {
+		ContextState* _state = Context::get_state();
+		return (_state != nullptr) ? _state->get_program_binary_supported() : Context::_query_program_binary_supported();
+	}
+
+	bool Context::_query_program_binary_supported() {
+		if (GLAD_GL_VERSION_4_1 == 0 && GLAD_GL_ARB_get_program_binary == 0) {
+			return false;
+		}
+		int _format_count = 0;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &_format_count);
+		return _format_count > 0;
+	}
+
+	void Context::set_program_binary_retrievable(const uint32_t& _id) {
+		glProgramParameteri(_id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	}
+
+	void Context::get_program_binary(const uint32_t& _id, std::vector<unsigned char>& _out, uint32_t& _out_format) {
+		int _length = 0;
+		glGetProgramiv(_id, GL_PROGRAM_BINARY_LENGTH, &_length);
+		_out.resize(static_cast<size_t>(_length));
+		GLenum _format = 0;
+		GLsizei _written = 0;
+		if (_length > 0) {
+			glGetProgramBinary(_id, _length, &_written, &_format, _out.data());
+		}
+		_out.resize(static_cast<size_t>(_written));
+		_out_format = static_cast<uint32_t>(_format);
+	}
+
+	bool Context::program_binary(const uint32_t& _id, uint32_t _format, const void* _data, size_t _length) {
+		glProgramBinary(_id, static_cast<GLenum>(_format), _data, static_cast<GLsizei>(_length));
+		int _success = 0;
+		glGetProgramiv(_id, GL_LINK_STATUS, &_success);
+		return _success != 0;
+	}
+
+	const char* Context::get_vendor() {
+		return reinterpret_cast<const char*>(glGetString(GL_VENDOR));
+	}
+
+	const char* Context::get_renderer() {
+		return reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+	}
+
+	const char* Context::get_version() {
+		return reinterpret_cast<const char*>(glGetString(GL_VERSION));
+	}
+
 	void Context::draw_arrays(
 		const PrimitiveType& _mode,
 		const int& _offset,
@@ -340,6 +631,15 @@ namespace glw {
 		glDrawArrays(static_cast<GLenum>(_mode), _offset, _index_count);
 	}
 
+	void Context::draw_arrays_instanced(
+		const PrimitiveType& _mode,
+		const int& _offset,
+		const uint32_t& _index_count,
+		const uint32_t& _instance_count
+	) {
+		glDrawArraysInstanced(static_cast<GLenum>(_mode), _offset, static_cast<GLsizei>(_index_count), static_cast<GLsizei>(_instance_count));
+	}
+
 	void Context::draw_elements(
 		const PrimitiveType& _mode,
 		const uint32_t& _index_count,
@@ -349,6 +649,84 @@ namespace glw {
 		glDrawElements(static_cast<GLenum>(_mode), static_cast<GLsizei>(_index_count), static_cast<GLenum>(_type), reinterpret_cast<const GLvoid*>(_offset));
 	}
 
+	void Context::draw_elements_instanced(
+		const PrimitiveType& _mode,
+		const uint32_t& _index_count,
+		const NumericType& _type,
+		const intptr_t& _offset,
+		const uint32_t& _instance_count
+	) {
+		glDrawElementsInstanced(static_cast<GLenum>(_mode), static_cast<GLsizei>(_index_count), static_cast<GLenum>(_type), reinterpret_cast<const GLvoid*>(_offset), static_cast<GLsizei>(_instance_count));
+	}
+
+	void Context::draw_elements_indirect(
+		const PrimitiveType& _mode,
+		const NumericType& _type,
+		const intptr_t& _offset
+	) {
+		glDrawElementsIndirect(static_cast<GLenum>(_mode), static_cast<GLenum>(_type), reinterpret_cast<const GLvoid*>(_offset));
+	}
+
+	void Context::multi_draw_elements_indirect(
+		const PrimitiveType& _mode,
+		const NumericType& _type,
+		const intptr_t& _offset,
+		const uint32_t& _draw_count,
+		const size_t& _stride
+	) {
+		glMultiDrawElementsIndirect(static_cast<GLenum>(_mode), static_cast<GLenum>(_type), reinterpret_cast<const GLvoid*>(_offset), static_cast<GLsizei>(_draw_count), static_cast<GLsizei>(_stride));
+	}
+
+	void Context::begin_transform_feedback(const PrimitiveType& _mode) {
+		glBeginTransformFeedback(static_cast<GLenum>(_mode));
+	}
+
+	void Context::end_transform_feedback() {
+		glEndTransformFeedback();
+	}
+
+	void Context::dispatch_compute(const uint32_t& _group_x, const uint32_t& _group_y, const uint32_t& _group_z) {
+		glDispatchCompute(_group_x, _group_y, _group_z);
+	}
+
+	void Context::dispatch_compute_indirect(const intptr_t& _offset) {
+		glDispatchComputeIndirect(static_cast<GLintptr>(_offset));
+	}
+
+	void Context::memory_barrier(MemoryBarrierType _flags) {
+		glMemoryBarrier(static_cast<GLbitfield>(_flags));
+	}
+
+	GLsync Context::fence_sync() {
+		return glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	}
+
+	SyncWaitResult Context::client_wait_sync(GLsync _sync, uint64_t _timeout_nanoseconds) {
+		return static_cast<SyncWaitResult>(glClientWaitSync(_sync, GL_SYNC_FLUSH_COMMANDS_BIT, static_cast<GLuint64>(_timeout_nanoseconds)));
+	}
+
+	void Context::delete_sync(GLsync _sync) {
+		glDeleteSync(_sync);
+	}
+
+	void Context::wait_sync(GLsync _sync) {
+		glWaitSync(_sync, 0, GL_TIMEOUT_IGNORED);
+	}
+
+	bool Context::get_adaptive_vsync_supported() noexcept {
+		return glfwExtensionSupported("GLX_EXT_swap_control_tear") == GLFW_TRUE
+			|| glfwExtensionSupported("WGL_EXT_swap_control_tear") == GLFW_TRUE;
+	}
+
+	ErrorQueue& ErrorQueue::get_instance() {
+		ContextState* _state = Context::get_state();
+		if (_state != nullptr) {
+			return _state->get_error_queue();
+		}
+		static ErrorQueue _instance;
+		return _instance;
+	}
+
 	void ErrorQueue::check() {
 		ErrorType _gl_err_type = static_cast<ErrorType>(Context::get_error());
 		if (_gl_err_type != ErrorType::NoError) {
@@ -374,6 +752,79 @@ namespace glw {
 		}
 	}
 
+	ErrorQueue& ContextState::get_error_queue() {
+		return m_error_queue;
+	}
+
+	bool ContextState::get_parallel_shader_compile_supported() {
+		if (m_parallel_shader_compile_supported.has_value() == false) {
+			m_parallel_shader_compile_supported = Context::_query_parallel_shader_compile_supported();
+		}
+		return m_parallel_shader_compile_supported.value();
+	}
+
+	bool ContextState::get_program_binary_supported() {
+		if (m_program_binary_supported.has_value() == false) {
+			m_program_binary_supported = Context::_query_program_binary_supported();
+		}
+		return m_program_binary_supported.value();
+	}
+
+	EventRingBuffer::EventRingBuffer(size_t _capacity) {
+		size_t _size = 1ULL;
+		while (_size < _capacity) {
+			_size <<= 1;
+		}
+		m_events.resize(_size);
+		m_mask = _size - 1ULL;
+	}
+
+	bool EventRingBuffer::push(const Event& _event) {
+		const size_t _tail = m_tail.load(std::memory_order_relaxed);
+		if (_tail - m_head.load(std::memory_order_acquire) == m_events.size()) {
+			m_dropped_count.fetch_add(1ULL, std::memory_order_relaxed);
+			return false;
+		}
+		m_events[_tail & m_mask] = _event;
+		m_tail.store(_tail + 1ULL, std::memory_order_release);
+		return true;
+	}
+
+	bool EventRingBuffer::pop(Event& _out_event) {
+		const size_t _head = m_head.load(std::memory_order_relaxed);
+		if (_head == m_tail.load(std::memory_order_acquire)) {
+			return false;
+		}
+		_out_event = m_events[_head & m_mask];
+		m_head.store(_head + 1ULL, std::memory_order_release);
+		return true;
+	}
+
+	bool EventRingBuffer::peek(Event& _out_event) const {
+		const size_t _head = m_head.load(std::memory_order_relaxed);
+		if (_head == m_tail.load(std::memory_order_acquire)) {
+			return false;
+		}
+		_out_event = m_events[_head & m_mask];
+		return true;
+	}
+
+	size_t EventRingBuffer::capacity() const {
+		return m_events.size();
+	}
+
+	size_t EventRingBuffer::size() const {
+		return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+	}
+
+	bool EventRingBuffer::empty() const {
+		return this->size() == 0ULL;
+	}
+
+	uint64_t EventRingBuffer::dropped_count() const {
+		return m_dropped_count.load(std::memory_order_relaxed);
+	}
+
 	void Window::callback_window_pos_changed(GLFWwindow* window, int xpos, int ypos) {
 		glw::Window* _window = reinterpret_cast<glw::Window*>(glfwGetWindowUserPointer(window));
 		glw::Event _event; {
@@ -381,7 +832,7 @@ namespace glw {
 			_event.data.moved_window.xpos = xpos;
 			_event.data.moved_window.ypos = ypos;
 		}
-		_window->m_event_queue.push(_event);
+		_window->_push_event(_event);
 	}
 
 	void Window::callback_window_size_changed(GLFWwindow* window, int width, int height) {
@@ -391,9 +842,9 @@ namespace glw {
 			_event.data.resized_window.width = static_cast<uint32_t>(width);
 			_event.data.resized_window.height = static_cast<uint32_t>(height);
 		}
-		_window->m_config.Width = width;
-		_window->m_config.Height = height;
-		_window->m_event_queue.push(_event);
+		_window->m_width.store(width);
+		_window->m_height.store(height);
+		_window->_push_event(_event);
 	}
 
 	void Window::callback_buffer_size_changed(GLFWwindow* window, int width, int height) {
@@ -403,7 +854,7 @@ namespace glw {
 			_event.data.resized_framebuffer.width = static_cast<uint32_t>(width);
 			_event.data.resized_framebuffer.height = static_cast<uint32_t>(height);
 		}
-		_window->m_event_queue.push(_event);
+		_window->_push_event(_event);
 	}
 
 	void Window::callback_key_detected(GLFWwindow* window, int key, int scancode, int action, int mods) {
@@ -425,7 +876,7 @@ namespace glw {
 			}
 			}
 		}
-		_window->m_event_queue.push(_event);
+		_window->_push_event(_event);
 	}
 
 	void Window::callback_mouse_scrolled(GLFWwindow* window, double xoffset, double yoffset) {
@@ -435,24 +886,22 @@ namespace glw {
 			_event.data.scrolled_mouse.amount_x = xoffset;
 			_event.data.scrolled_mouse.amount_y = yoffset;
 		}
-		_window->m_event_queue.push(_event);
+		_window->_push_event(_event);
 	}
 
 
 	void Window::callback_mouse_moved(GLFWwindow* window, double xposIn, double yposIn) {
-		static double _lastMousePosX = 0.0;
-		static double _lastMousePosY = 0.0f;
 		glw::Window* _window = reinterpret_cast<glw::Window*>(glfwGetWindowUserPointer(window));
 		glw::Event _event; {
 			_event.type = EventType::MousePositionChanged;
 			_event.data.changed_mouse_position.x = xposIn;
 			_event.data.changed_mouse_position.y = yposIn;
-			_event.data.changed_mouse_position.relx = _event.data.changed_mouse_position.x - _lastMousePosX;
-			_event.data.changed_mouse_position.rely = _lastMousePosY - _event.data.changed_mouse_position.y;
-			_lastMousePosX = xposIn;
-			_lastMousePosY = yposIn;
+			_event.data.changed_mouse_position.relx = _event.data.changed_mouse_position.x - _window->m_last_mouse_xpos;
+			_event.data.changed_mouse_position.rely = _window->m_last_mouse_ypos - _event.data.changed_mouse_position.y;
+			_window->m_last_mouse_xpos = xposIn;
+			_window->m_last_mouse_ypos = yposIn;
 		}
-		_window->m_event_queue.push(_event);
+		_window->_push_event(_event);
 	}
 
 	void Window::callback_mouse_button_detected(GLFWwindow* window, int button, int action, int mods) {
@@ -471,7 +920,7 @@ namespace glw {
 			}
 			}
 		}
-		_window->m_event_queue.push(_event);
+		_window->_push_event(_event);
 	}
 
 	void Window::callback_termination_requested(GLFWwindow* window) {
@@ -479,7 +928,7 @@ namespace glw {
 		glw::Event _event; {
 			_event.type = EventType::TerminationRequested;
 		}
-		_window->m_event_queue.push(_event);
+		_window->_push_event(_event);
 	}
 
 	void Window::callback_char_inputted(GLFWwindow* window, unsigned int codepoint) {
@@ -488,7 +937,7 @@ namespace glw {
 			_event.type = glw::EventType::CharInputted;
 			_event.data.inputted_char.codepoint = codepoint;
 		}
-		_window->m_event_queue.push(_event);
+		_window->_push_event(_event);
 	}
 
 	void Window::callback_window_minimized(GLFWwindow* window, int value) {
@@ -497,7 +946,7 @@ namespace glw {
 			_event.type = glw::EventType::WindowMinimized;
 			_event.data.minimized_window.toggle = value;
 		}
-		_window->m_event_queue.push(_event);
+		_window->_push_event(_event);
 	}
 
 	void Window::callback_window_maximized(GLFWwindow* window, int value) {
@@ -506,14 +955,19 @@ namespace glw {
 			_event.type = glw::EventType::WindowMaximized;
 			_event.data.maximized_window.toggle = value;
 		}
-		_window->m_event_queue.push(_event);
+		_window->_push_event(_event);
 	}
 
 	Window::Window(const WindowConfig& _cfg)
 		: m_config(_cfg),
 		m_origin_width(_cfg.Width),
-		m_origin_height(_cfg.Height)
+		m_origin_height(_cfg.Height),
+		m_width(_cfg.Width),
+		m_height(_cfg.Height),
+		m_event_queue(_cfg.EventQueueCapacity)
 	{
+		m_coalesced_events.reserve(m_config.CoalescedEventCapacity);
+
 		int _monitorWidth = 0, _monitorHeight = 0;
 		this->get_monitor_resolution(_monitorWidth, _monitorHeight);
 
@@ -538,7 +992,8 @@ namespace glw {
 
 		glfwWindowHint(GLFW_SAMPLES, m_config.MSAAFactor);
 
-		m_window = glfwCreateWindow(m_config.Width, m_config.Height, m_config.Title.c_str(), nullptr, nullptr);
+		GLFWwindow* _share = (m_config.SharedWindow != nullptr) ? m_config.SharedWindow->get() : nullptr;
+		m_window = glfwCreateWindow(m_config.Width, m_config.Height, m_config.Title.c_str(), nullptr, _share);
 		if (m_window == nullptr) {
 			_GLW_THROW_GLFW_ERROR;
 		}
@@ -598,14 +1053,83 @@ namespace glw {
 	}
 
 	bool Window::pop_event(Event& _out_event) {
-		if (m_event_queue.empty()) {
+		m_coalesced_events.clear();
+		if (m_event_queue.pop(_out_event) == false) {
 			return false;
 		}
-		_out_event = m_event_queue.front();
-		m_event_queue.pop();
+		if (m_config.EventCoalescingEnabled == false) {
+			return true;
+		}
+		if (_out_event.type != EventType::MousePositionChanged && _out_event.type != EventType::MouseScrollDetected) {
+			return true;
+		}
+
+		/* Merged here rather than in the callbacks, since the producer may not rewrite a slot it has already published */
+		if (m_coalesced_events.size() < m_config.CoalescedEventCapacity) {
+			m_coalesced_events.emplace_back(_out_event);
+		}
+		Event _next;
+		while (m_event_queue.peek(_next) && _next.type == _out_event.type) {
+			m_event_queue.pop(_next);
+			if (m_coalesced_events.size() < m_config.CoalescedEventCapacity) {
+				m_coalesced_events.emplace_back(_next);
+			}
+			switch (_out_event.type) {
+			case (EventType::MousePositionChanged): {
+				_out_event.data.changed_mouse_position.x = _next.data.changed_mouse_position.x;
+				_out_event.data.changed_mouse_position.y = _next.data.changed_mouse_position.y;
+				_out_event.data.changed_mouse_position.relx += _next.data.changed_mouse_position.relx;
+				_out_event.data.changed_mouse_position.rely += _next.data.changed_mouse_position.rely;
+				break;
+			}
+			case (EventType::MouseScrollDetected): {
+				_out_event.data.scrolled_mouse.amount_x += _next.data.scrolled_mouse.amount_x;
+				_out_event.data.scrolled_mouse.amount_y += _next.data.scrolled_mouse.amount_y;
+				break;
+			}
+			default: {
+				break;
+			}
+			}
+			_out_event.timestamp = _next.timestamp;
+		}
 		return true;
 	}
 
+	uint64_t Window::get_dropped_event_count() const {
+		return m_event_queue.dropped_count();
+	}
+
+	const std::vector<Event>& Window::get_coalesced_events() const {
+		return m_coalesced_events;
+	}
+
+	WindowConfig Window::get_worker_config() {
+		WindowConfig _cfg;
+		_cfg.GLMajorVersion = m_config.GLMajorVersion;
+		_cfg.GLMinorVersion = m_config.GLMinorVersion;
+		_cfg.GLCoreProfileEnabled = m_config.GLCoreProfileEnabled;
+		_cfg.Title = m_config.Title + " (worker)";
+		_cfg.Width = 1;
+		_cfg.Height = 1;
+		_cfg.MSAAFactor = 0;
+		_cfg.Visible = false;
+		_cfg.FocusOnShow = false;
+		_cfg.Centered = false;
+		_cfg.SharedWindow = this;
+		_cfg.EventQueueCapacity = 16U;
+		return _cfg;
+	}
+
+	ContextState& Window::get_context_state() {
+		return m_context_state;
+	}
+
+	void Window::_push_event(Event& _event) {
+		_event.timestamp = glfwGetTime();
+		m_event_queue.push(_event);
+	}
+
 	void Window::set_icon(unsigned char* _data) {
 		GLFWimage _images[1];
 		_images[0].pixels = _data;
@@ -619,15 +1143,15 @@ namespace glw {
 		auto _mode = glfwGetVideoMode(_monitor);
 		if (_value) {
 			glfwSetWindowMonitor(m_window, _monitor, 0, 0, _mode->width, _mode->height, _mode->refreshRate);
-			m_config.Width = _mode->width;
-			m_config.Height = _mode->height;
+			m_width.store(_mode->width);
+			m_height.store(_mode->height);
 		}
 		else {
 			int originW = m_origin_width;
 			int originH = m_origin_height;
 			glfwSetWindowMonitor(m_window, nullptr, (_mode->width / 2) - (originW / 2), (_mode->height / 2) - (originH / 2), originW, originH, GLFW_DONT_CARE);
-			m_config.Width = originW;
-			m_config.Height = originH;
+			m_width.store(originW);
+			m_height.store(originH);
 		}
 	}
 
@@ -636,6 +1160,10 @@ namespace glw {
 		glfwSetInputMode(m_window, GLFW_CURSOR, _value);
 	}
 
+	void Window::set_event_coalescing_enabled(bool _value) {
+		m_config.EventCoalescingEnabled = _value;
+	}
+
 	void Window::set_title(const char* _value) {
 		m_config.Title = _value;
 		glfwSetWindowTitle(m_window, _value);
@@ -658,18 +1186,18 @@ namespace glw {
 
 	void Window::set_size(int _width, int _height) {
 		glfwSetWindowSize(m_window, _width, _height);
-		m_config.Width = _width;
-		m_config.Height = _height;
+		m_width.store(_width);
+		m_height.store(_height);
 	}
 
 	void Window::set_width(int _value) {
-		glfwSetWindowSize(m_window, _value, m_config.Height);
-		m_config.Width = _value;
+		glfwSetWindowSize(m_window, _value, m_height.load());
+		m_width.store(_value);
 	}
 
 	void Window::set_height(int _value) {
-		glfwSetWindowSize(m_window, m_config.Width, _value);
-		m_config.Height = _value;
+		glfwSetWindowSize(m_window, m_width.load(), _value);
+		m_height.store(_value);
 	}
 
 	void Window::set_position(int _xpos, int _ypos) {
@@ -759,12 +1287,12 @@ namespace glw {
 		return m_config.Visible;
 	}
 
-	const int& Window::get_width() const {
-		return m_config.Width;
+	int Window::get_width() const {
+		return m_width.load();
 	}
 
-	const int& Window::get_height() const {
-		return m_config.Height;
+	int Window::get_height() const {
+		return m_height.load();
 	}
 
 	const int& Window::get_origin_width() const {
@@ -783,6 +1311,10 @@ namespace glw {
 		return m_config.CursorDisabled;
 	}
 
+	const bool& Window::get_event_coalescing_enabled() const {
+		return m_config.EventCoalescingEnabled;
+	}
+
 	void BufferData::add_int32(const int& _data) {
 		this->_add(reinterpret_cast<const unsigned char*>(&_data), sizeof(_data));
 	}
@@ -795,10 +1327,20 @@ namespace glw {
 		this->_add(reinterpret_cast<const unsigned char*>(&_data), sizeof(_data));
 	}
 
+	void BufferData::add_floats(const float* _data, size_t _count) {
+		this->_add(reinterpret_cast<const unsigned char*>(_data), sizeof(float) * _count);
+	}
+
+	void BufferData::reserve(size_t _length) {
+		m_data.reserve(_length);
+	}
+
+	void BufferData::clear() {
+		m_data.clear();
+	}
+
 	void BufferData::_add(const unsigned char* _data, size_t _count) {
-		for (size_t i = 0; i < _count; i++) {
-			m_data.emplace_back(_data[i]);
-		}
+		m_data.insert(m_data.end(), _data, _data + _count);
 	}
 
 	const void* BufferData::get_pointer() const {
@@ -815,6 +1357,18 @@ namespace glw {
 
 	}
 
+	Handle::Handle(Handle&& _other) noexcept
+		: m_ID(_other.m_ID)
+	{
+		_other.m_ID = 0U;
+	}
+
+	Handle& Handle::operator=(Handle&& _other) noexcept {
+		/* The previous name goes to _other, whose destructor deletes it */
+		std::swap(m_ID, _other.m_ID);
+		return *this;
+	}
+
 	Handle::~Handle() {
 
 	}
@@ -846,6 +1400,10 @@ namespace glw {
 		glw::Context::vertex_attrib_pointer(_offset_index, _count, _type, false, _stride, _offset);
 	}
 
+	void VertexArrayObject::attrib_divisor(const uint32_t& _offset_index, const uint32_t& _divisor) const {
+		glw::Context::vertex_attrib_divisor(_offset_index, _divisor);
+	}
+
 	void VertexArrayObject::bind_default() {
 		glw::Context::bind_vertex_array(0U);
 	}
@@ -880,6 +1438,14 @@ namespace glw {
 		glw::Context::bind_array_buffer_sub_data(glw::ArrayBufferType::VertexBuffer, _data, _offset);
 	}
 
+	void VertexBufferObject::bind_sub_data(const void* _data, size_t _length, size_t _offset) const {
+		glw::Context::bind_array_buffer_sub_data(glw::ArrayBufferType::VertexBuffer, _data, _length, _offset);
+	}
+
+	void VertexBufferObject::bind_base(ArrayBufferType _type, uint32_t _index) const {
+		glw::Context::bind_buffer_base(_type, _index, m_ID);
+	}
+
 	ElementBufferObject::ElementBufferObject()
 		: Handle(glw::Context::generate_buffer())
 	{
@@ -910,6 +1476,82 @@ namespace glw {
 		glw::Context::bind_array_buffer_sub_data(glw::ArrayBufferType::ElementBuffer, _data, _offset);
 	}
 
+	ShaderStorageBufferObject::ShaderStorageBufferObject()
+		: Handle(glw::Context::generate_buffer())
+	{
+
+	}
+
+	ShaderStorageBufferObject::~ShaderStorageBufferObject() {
+		glw::Context::delete_buffer(m_ID);
+	}
+
+	void ShaderStorageBufferObject::bind() const {
+		glw::Context::bind_array_buffer(glw::ArrayBufferType::ShaderStorageBuffer, m_ID);
+	}
+
+	void ShaderStorageBufferObject::bind_default() {
+		glw::Context::bind_array_buffer(glw::ArrayBufferType::ShaderStorageBuffer, 0);
+	}
+
+	void ShaderStorageBufferObject::bind_data(const BufferData& _data, BufferUsage _usage) const {
+		glw::Context::bind_array_buffer_data(glw::ArrayBufferType::ShaderStorageBuffer, _data, _usage);
+	}
+
+	void ShaderStorageBufferObject::bind_empty_data(const size_t& _length, BufferUsage _usage) const {
+		glw::Context::bind_empty_array_buffer_data(glw::ArrayBufferType::ShaderStorageBuffer, _length, _usage);
+	}
+
+	void ShaderStorageBufferObject::bind_sub_data(const BufferData& _data, size_t _offset) const {
+		glw::Context::bind_array_buffer_sub_data(glw::ArrayBufferType::ShaderStorageBuffer, _data, _offset);
+	}
+
+	void ShaderStorageBufferObject::bind_sub_data(const void* _data, size_t _length, size_t _offset) const {
+		glw::Context::bind_array_buffer_sub_data(glw::ArrayBufferType::ShaderStorageBuffer, _data, _length, _offset);
+	}
+
+	void ShaderStorageBufferObject::bind_base(uint32_t _index) const {
+		glw::Context::bind_buffer_base(glw::ArrayBufferType::ShaderStorageBuffer, _index, m_ID);
+	}
+
+	DrawIndirectBufferObject::DrawIndirectBufferObject()
+		: Handle(glw::Context::generate_buffer())
+	{
+
+	}
+
+	DrawIndirectBufferObject::~DrawIndirectBufferObject() {
+		glw::Context::delete_buffer(m_ID);
+	}
+
+	void DrawIndirectBufferObject::bind() const {
+		glw::Context::bind_array_buffer(glw::ArrayBufferType::DrawIndirectBuffer, m_ID);
+	}
+
+	void DrawIndirectBufferObject::bind_default() {
+		glw::Context::bind_array_buffer(glw::ArrayBufferType::DrawIndirectBuffer, 0);
+	}
+
+	void DrawIndirectBufferObject::bind_data(const BufferData& _data, BufferUsage _usage) const {
+		glw::Context::bind_array_buffer_data(glw::ArrayBufferType::DrawIndirectBuffer, _data, _usage);
+	}
+
+	void DrawIndirectBufferObject::bind_empty_data(const size_t& _length, BufferUsage _usage) const {
+		glw::Context::bind_empty_array_buffer_data(glw::ArrayBufferType::DrawIndirectBuffer, _length, _usage);
+	}
+
+	void DrawIndirectBufferObject::bind_sub_data(const BufferData& _data, size_t _offset) const {
+		glw::Context::bind_array_buffer_sub_data(glw::ArrayBufferType::DrawIndirectBuffer, _data, _offset);
+	}
+
+	void DrawIndirectBufferObject::bind_sub_data(const void* _data, size_t _length, size_t _offset) const {
+		glw::Context::bind_array_buffer_sub_data(glw::ArrayBufferType::DrawIndirectBuffer, _data, _length, _offset);
+	}
+
+	void DrawIndirectBufferObject::bind_base(ArrayBufferType _type, uint32_t _index) const {
+		glw::Context::bind_buffer_base(_type, _index, m_ID);
+	}
+
 	FrameBufferObject::FrameBufferObject()
 		: Handle(glw::Context::generate_frame_buffer())
 	{
@@ -929,7 +1571,12 @@ namespace glw {
 	}
 
 	void FrameBufferObject::attach_texture(AttachmentType _type, const Texture* _tex) {
-		glw::Context::attach_texture_2d(m_ID, _type, _tex->id());
+		glw::Context::attach_texture_2d(m_ID, _type, _tex->id(), _tex->target());
+		m_texture_attachments[_type] = _tex;
+	}
+
+	void FrameBufferObject::attach_texture_layer(AttachmentType _type, const Texture* _tex, uint32_t _layer) {
+		glw::Context::attach_texture_layer(m_ID, _type, _tex->id(), _layer);
 		m_texture_attachments[_type] = _tex;
 	}
 
@@ -937,6 +1584,22 @@ namespace glw {
 		glw::Context::attach_render_buffer(m_ID, _type, _rbo->id());
 	}
 
+	void FrameBufferObject::set_draw_buffers(const std::vector<AttachmentType>& _attachments) {
+		glw::Context::draw_buffers(_attachments);
+	}
+
+	void FrameBufferObject::invalidate(const std::vector<AttachmentType>& _attachments) const {
+		glw::Context::invalidate_frame_buffer(_attachments);
+	}
+
+	void FrameBufferObject::blit_to(const FrameBufferObject* _target, uint32_t _width, uint32_t _height, BufferType _mask, FilterType _filter) const {
+		this->blit_to(_target, 0, 0, static_cast<int>(_width), static_cast<int>(_height), 0, 0, static_cast<int>(_width), static_cast<int>(_height), _mask, _filter);
+	}
+
+	void FrameBufferObject::blit_to(const FrameBufferObject* _target, int _src_x0, int _src_y0, int _src_x1, int _src_y1, int _dst_x0, int _dst_y0, int _dst_x1, int _dst_y1, BufferType _mask, FilterType _filter) const {
+		glw::Context::blit_frame_buffer(m_ID, (_target != nullptr ? _target->id() : 0U), _src_x0, _src_y0, _src_x1, _src_y1, _dst_x0, _dst_y0, _dst_x1, _dst_y1, _mask, _filter);
+	}
+
 	const Texture* FrameBufferObject::get_attached_texture(AttachmentType _type) const {
 		if (m_texture_attachments.find(_type) != m_texture_attachments.end()) {
 			return m_texture_attachments.at(_type);
@@ -1011,6 +1674,10 @@ namespace glw {
 		glw::Context::set_render_buffer_storage(_format, _width, _height);
 	}
 
+	void RenderBufferObject::set_storage(InternalFormat _format, uint32_t _width, uint32_t _height, uint32_t _samples) {
+		glw::Context::set_render_buffer_storage_multisample(_format, _width, _height, _samples);
+	}
+
 	Texture::Texture(const TextureConfig& _cfg, const uint32_t& _width, const uint32_t& _height, const uint32_t& _channels)
 		: Handle(glw::Context::generate_texture()),
 		m_config(_cfg),
@@ -1018,12 +1685,22 @@ namespace glw {
 		m_height(_height),
 		m_channels(_channels)
 	{
+		if (m_config.Samples > 1U) {
+			m_target = TextureTarget::Texture2DMultisample;
+			this->bind();
+			glw::Context::set_image_multisample(m_width, m_height, m_config.Samples, m_config.FormatInternal);
+			Texture::bind_default(m_target);
+			return;
+		}
 		this->bind();
 		glw::Context::set_filter(m_config.MagFilter, m_config.MinFilter);
 		glw::Context::set_wrapping_mode(m_config.WrappingS, m_config.WrappingT);
 		glw::Context::set_image(nullptr, m_width, m_height, m_config.FormatInternal, m_config.FormatTexture, m_config.FormatData);
 		if (m_config.MipmapGeneration) {
 			glw::Context::generate_mipmap();
+			for (uint32_t _size = (m_width > m_height ? m_width : m_height); _size > 1U; _size >>= 1U) {
+				m_levels++;
+			}
 		}
 		Texture::bind_default();
 	}
@@ -1041,6 +1718,50 @@ namespace glw {
 		glw::Context::set_image(_data, m_width, m_height, m_config.FormatInternal, m_config.FormatTexture, m_config.FormatData);
 		if (m_config.MipmapGeneration) {
 			glw::Context::generate_mipmap();
+			for (uint32_t _size = (m_width > m_height ? m_width : m_height); _size > 1U; _size >>= 1U) {
+				m_levels++;
+			}
+		}
+		Texture::bind_default();
+	}
+
+	Texture::Texture(const TextureConfig& _cfg, const uint32_t& _width, const uint32_t& _height, const uint32_t& _layers, const uint32_t& _channels)
+		: Handle(glw::Context::generate_texture()),
+		m_config(_cfg),
+		m_target(TextureTarget::Texture2DArray),
+		m_width(_width),
+		m_height(_height),
+		m_layers(_layers),
+		m_channels(_channels)
+	{
+		this->bind();
+		glw::Context::set_filter(m_config.MagFilter, m_config.MinFilter, m_target);
+		glw::Context::set_wrapping_mode(m_config.WrappingS, m_config.WrappingT, m_target);
+		glw::Context::set_image_layers(nullptr, m_width, m_height, m_layers, m_config.FormatInternal, m_config.FormatTexture, m_config.FormatData);
+		Texture::bind_default(m_target);
+	}
+
+	Texture::Texture(const TextureConfig& _cfg, const CompressedTextureLevel* _levels, const uint32_t& _level_count, const uint32_t& _first_level)
+		: Handle(glw::Context::generate_texture()),
+		m_config(_cfg),
+		m_width(_levels[0].Width),
+		m_height(_levels[0].Height),
+		m_levels(_level_count),
+		m_base_level(_first_level < _level_count ? _first_level : _level_count - 1),
+		m_channels(Texture::is_compressed(_cfg.FormatInternal) ? 0U : Texture::_get_channel_count(_cfg.FormatTexture))
+	{
+		this->bind();
+		glw::Context::set_filter(m_config.MagFilter, m_config.MinFilter);
+		glw::Context::set_wrapping_mode(m_config.WrappingS, m_config.WrappingT);
+		for (uint32_t i = m_base_level; i < m_levels; i++) {
+			this->_upload_level(i, _levels[i]);
+		}
+		/* Data without a mip chain of its own, such as float images, still gets one from the driver */
+		if (m_levels == 1U && m_config.MipmapGeneration && Texture::is_compressed(m_config.FormatInternal) == false) {
+			glw::Context::generate_mipmap();
+		}
+		else {
+			glw::Context::set_level_range(m_base_level, m_levels - 1);
 		}
 		Texture::bind_default();
 	}
@@ -1050,13 +1771,68 @@ namespace glw {
 	}
 
 	void Texture::bind() const {
-		glw::Context::bind_texture_2d(m_ID);
+		glw::Context::bind_texture(m_target, m_ID);
 	}
 
 	void Texture::bind_default() {
 		glw::Context::bind_texture_2d(0);
 	}
 
+	void Texture::bind_default(const TextureTarget& _target) {
+		glw::Context::bind_texture(_target, 0);
+	}
+
+	bool Texture::read_compressed_level(const uint32_t& _level, std::vector<unsigned char>& _out, uint32_t& _out_width, uint32_t& _out_height, InternalFormat& _out_format) const {
+		this->bind();
+		if (glw::Context::get_level_is_compressed(_level, m_target) == false) {
+			Texture::bind_default(m_target);
+			return false;
+		}
+		glw::Context::get_level_size(_level, _out_width, _out_height, m_target);
+		_out_format = glw::Context::get_level_internal_format(_level, m_target);
+		_out.resize(glw::Context::get_compressed_image_size(_level, m_target));
+		glw::Context::get_compressed_image(_level, _out.data(), m_target);
+		Texture::bind_default(m_target);
+		return true;
+	}
+
+	void Texture::set_layer(const uint32_t& _layer, const unsigned char* _data) const {
+		this->bind();
+		glw::Context::set_image_layer(_data, _layer, m_width, m_height, m_config.FormatTexture, m_config.FormatData);
+		Texture::bind_default(m_target);
+		m_need_to_generate_mipmap = m_config.MipmapGeneration;
+	}
+
+	void Texture::generate_pending_mipmap() const {
+		if (m_need_to_generate_mipmap == false) {
+			return;
+		}
+		m_need_to_generate_mipmap = false;
+		this->bind();
+		glw::Context::generate_mipmap(m_target);
+		Texture::bind_default(m_target);
+	}
+
+	void Texture::set_level(const uint32_t& _level, const CompressedTextureLevel& _data) {
+		this->bind();
+		this->_upload_level(_level, _data);
+		if (_level < m_base_level) {
+			m_base_level = _level;
+		}
+		glw::Context::set_level_range(m_base_level, m_levels - 1);
+		Texture::bind_default();
+	}
+
+	void Texture::release() {
+		glw::Context::delete_texture(m_ID);
+		m_ID = glw::Context::generate_texture();
+		m_base_level = m_levels;
+		this->bind();
+		glw::Context::set_filter(m_config.MagFilter, m_config.MinFilter, m_target);
+		glw::Context::set_wrapping_mode(m_config.WrappingS, m_config.WrappingT, m_target);
+		Texture::bind_default(m_target);
+	}
+
 	const uint32_t& Texture::width() const {
 		return m_width;
 	}
@@ -1065,10 +1841,89 @@ namespace glw {
 		return m_height;
 	}
 
+	const uint32_t& Texture::layers() const {
+		return m_layers;
+	}
+
+	const uint32_t& Texture::levels() const {
+		return m_levels;
+	}
+
+	const uint32_t& Texture::base_level() const {
+		return m_base_level;
+	}
+
 	const uint32_t& Texture::channels() const {
 		return m_channels;
 	}
 
+	const TextureTarget& Texture::target() const {
+		return m_target;
+	}
+
+	const TextureConfig& Texture::config() const {
+		return m_config;
+	}
+
+	bool Texture::is_compressed(const InternalFormat& _format) {
+		switch (_format) {
+		case (InternalFormat::CompressedRGBS3TCDXT1):
+		case (InternalFormat::CompressedRGBAS3TCDXT1):
+		case (InternalFormat::CompressedRGBAS3TCDXT5):
+		case (InternalFormat::CompressedSRGBAS3TCDXT1):
+		case (InternalFormat::CompressedSRGBAS3TCDXT5):
+		case (InternalFormat::CompressedRGBABPTC):
+		case (InternalFormat::CompressedSRGBABPTC):
+		case (InternalFormat::CompressedRGB8ETC2):
+		case (InternalFormat::CompressedSRGB8ETC2):
+		case (InternalFormat::CompressedRGBA8ETC2EAC):
+		case (InternalFormat::CompressedSRGB8A8ETC2EAC): {
+			return true;
+		}
+		default: {
+			break;
+		}
+		}
+		return false;
+	}
+
+	void Texture::_upload_level(const uint32_t& _level, const CompressedTextureLevel& _data) const {
+		if (Texture::is_compressed(m_config.FormatInternal)) {
+			glw::Context::set_compressed_image(_data.Data, _data.Length, _level, _data.Width, _data.Height, m_config.FormatInternal);
+			return;
+		}
+		/* Levels are tightly packed, which breaks the default 4 byte row alignment for 1 and 3 channels */
+		glw::Context::set_unpack_alignment(1U);
+		glw::Context::set_image_level(_data.Data, _level, _data.Width, _data.Height, m_config.FormatInternal, m_config.FormatTexture, m_config.FormatData);
+		glw::Context::set_unpack_alignment(4U);
+	}
+
+	uint32_t Texture::_get_channel_count(const TextureFormat& _format) {
+		switch (_format) {
+		case (TextureFormat::RGBA):
+		case (TextureFormat::BGRA):
+		case (TextureFormat::RGBAInteger):
+		case (TextureFormat::BGRAInteger): {
+			return 4U;
+		}
+		case (TextureFormat::RGB):
+		case (TextureFormat::BGR):
+		case (TextureFormat::RGBInteger):
+		case (TextureFormat::BGRInteger): {
+			return 3U;
+		}
+		case (TextureFormat::RG):
+		case (TextureFormat::RGInteger):
+		case (TextureFormat::DepthStencil): {
+			return 2U;
+		}
+		default: {
+			break;
+		}
+		}
+		return 1U;
+	}
+
 	Shader::Shader(const ShaderType& _type, const char* _src)
 		: m_ID(glw::Context::create_shader(_type)),
 		m_type(_type)
@@ -1077,10 +1932,44 @@ namespace glw {
 		glw::Context::compile_shader(_type, m_ID);
 	}
 
+	Shader::Shader(const ShaderType& _type, const char* _src, bool _deferred)
+		: m_type(_type),
+		m_ID(glw::Context::create_shader(_type))
+	{
+		glw::Context::set_source(m_ID, _src);
+		if (_deferred) {
+			glw::Context::compile_shader_deferred(m_ID);
+		}
+		else {
+			glw::Context::compile_shader(_type, m_ID);
+		}
+	}
+
+	Shader::Shader(Shader&& _other) noexcept
+		: m_type(_other.m_type),
+		m_ID(_other.m_ID)
+	{
+		_other.m_ID = 0U;
+	}
+
+	Shader& Shader::operator=(Shader&& _other) noexcept {
+		std::swap(m_type, _other.m_type);
+		std::swap(m_ID, _other.m_ID);
+		return *this;
+	}
+
 	Shader::~Shader() {
 		glw::Context::delete_shader(m_ID);
 	}
 
+	bool Shader::is_compile_complete() const {
+		return glw::Context::get_shader_compile_completion(m_ID);
+	}
+
+	void Shader::check_compile_status() const {
+		glw::Context::check_shader_compile_status(m_type, m_ID);
+	}
+
 	const uint32_t& Shader::id() const {
 		return m_ID;
 	}
@@ -1132,6 +2021,19 @@ namespace glw {
 
 	}
 
+	Program::Program(Program&& _other) noexcept
+		: m_ID(_other.m_ID),
+		m_uniform_locations(std::move(_other.m_uniform_locations))
+	{
+		_other.m_ID = 0U;
+	}
+
+	Program& Program::operator=(Program&& _other) noexcept {
+		std::swap(m_ID, _other.m_ID);
+		std::swap(m_uniform_locations, _other.m_uniform_locations);
+		return *this;
+	}
+
 	Program::~Program() {
 		glw::Context::delete_program(m_ID);
 	}
@@ -1148,14 +2050,49 @@ namespace glw {
 		glw::Context::attach_shader(m_ID, _shader->id());
 	}
 
+	void Program::set_transform_feedback_varyings(const char* const* _varyings, uint32_t _count, TransformFeedbackBufferMode _mode) const {
+		glw::Context::transform_feedback_varyings(m_ID, _varyings, _count, _mode);
+	}
+
 	void Program::link() const {
 		glw::Context::link_program(m_ID);
 	}
 
+	void Program::link_deferred() const {
+		glw::Context::link_program_deferred(m_ID);
+	}
+
+	bool Program::is_link_complete() const {
+		return glw::Context::get_program_link_completion(m_ID);
+	}
+
+	void Program::check_link_status() const {
+		glw::Context::check_program_link_status(m_ID);
+	}
+
+	void Program::set_binary_retrievable() const {
+		glw::Context::set_program_binary_retrievable(m_ID);
+	}
+
+	bool Program::get_binary(std::vector<unsigned char>& _out, uint32_t& _out_format) const {
+		glw::Context::get_program_binary(m_ID, _out, _out_format);
+		return _out.empty() == false;
+	}
+
+	bool Program::load_binary(const void* _data, size_t _length, uint32_t _format) const {
+		return glw::Context::program_binary(m_ID, _format, _data, _length);
+	}
+
 	void Program::register_uniform(const std::string_view& _name) {
 		m_uniform_locations[_name] = glw::Context::get_uniform_location(m_ID, _name.data());
 	}
 
+	void Program::register_uniforms_from(const Program& _other) {
+		for (const auto& [_name, _location] : _other.m_uniform_locations) {
+			this->register_uniform(_name);
+		}
+	}
+
 	void Program::set_sampler2D(const std::string_view& _name, int _slot_id) const {
 		glw::Context::set_uniform_int(m_uniform_locations.at(_name), _slot_id);
 	}
@@ -1172,6 +2109,10 @@ namespace glw {
 		glw::Context::set_uniform_float(m_uniform_locations.at(_name), _value);
 	}
 
+	void Program::set_floats(const std::string_view& _name, const float* _ptr, uint32_t _count) const {
+		glw::Context::set_uniform_floats(m_uniform_locations.at(_name), _ptr, _count);
+	}
+
 	void Program::set_vec2(const std::string_view& _name, float _x, float _y)const {
 		glw::Context::set_uniform_vec2(m_uniform_locations.at(_name), _x, _y);
 	}
@@ -1200,4 +2141,235 @@ namespace glw {
 		return m_ID;
 	}
 
+	ComputeProgram::ComputeProgram(const Shader* _shader)
+		: Program()
+	{
+		if (_shader->type() != ShaderType::Compute) {
+			throw exception::GLInvalidShaderType(Shader::type_to_str(ShaderType::Compute), _shader->type_str());
+		}
+		this->attach(_shader);
+		this->link();
+		glw::Context::get_compute_work_group_size(id(), m_local_size[0], m_local_size[1], m_local_size[2]);
+	}
+
+	ComputeProgram::~ComputeProgram() {
+
+	}
+
+	void ComputeProgram::dispatch(uint32_t _group_x, uint32_t _group_y, uint32_t _group_z) const {
+		this->use();
+		glw::Context::dispatch_compute(_group_x, _group_y, _group_z);
+	}
+
+	void ComputeProgram::dispatch_indirect(const ShaderStorageBufferObject* _args, intptr_t _offset) const {
+		this->use();
+		glw::Context::bind_array_buffer(glw::ArrayBufferType::DispatchIndirectBuffer, _args->id());
+		glw::Context::dispatch_compute_indirect(_offset);
+		glw::Context::bind_array_buffer(glw::ArrayBufferType::DispatchIndirectBuffer, 0);
+	}
+
+	const uint32_t* ComputeProgram::get_local_size() const {
+		return m_local_size;
+	}
+
+	uint32_t ComputeProgram::get_group_count(uint32_t _invocations, size_t _axis) const {
+		const uint32_t _local = m_local_size[_axis];
+		return (_invocations + _local - 1U) / _local;
+	}
+
+	/* "GLWB" */
+	static constexpr uint32_t s_program_cache_magic = 0x42574C47U;
+	static constexpr uint32_t s_program_cache_version = 1U;
+
+	ProgramBinaryCache::ProgramBinaryCache(const std::string& _directory)
+		: m_directory(_directory)
+	{
+		const char* _vendor = glw::Context::get_vendor();
+		const char* _renderer = glw::Context::get_renderer();
+		const char* _version = glw::Context::get_version();
+		m_driver =
+			std::string(_vendor != nullptr ? _vendor : "") + "|" +
+			std::string(_renderer != nullptr ? _renderer : "") + "|" +
+			std::string(_version != nullptr ? _version : "");
+		m_supported = (m_directory.empty() == false && glw::Context::get_program_binary_supported());
+		if (m_supported) {
+			std::error_code _error;
+			std::filesystem::create_directories(m_directory, _error);
+		}
+	}
+
+	ProgramBinaryCache::~ProgramBinaryCache() {
+
+	}
+
+	bool ProgramBinaryCache::load(const Program* _program, const std::vector<const char*>& _sources) const {
+		if (m_supported == false) {
+			return false;
+		}
+		const uint64_t _source_hash = this->_hash_sources(_sources);
+		std::ifstream _file(this->_get_path(_source_hash), std::ios::binary);
+		if (_file.is_open() == false) {
+			return false;
+		}
+		auto _read = [&_file](void* _out, size_t _length) -> bool {
+			_file.read(reinterpret_cast<char*>(_out), static_cast<std::streamsize>(_length));
+			return _file.good();
+		};
+		uint32_t _magic = 0U, _version = 0U, _driver_length = 0U, _format = 0U;
+		uint64_t _stored_hash = 0ULL, _length = 0ULL;
+		if (_read(&_magic, sizeof(_magic)) == false || _read(&_version, sizeof(_version)) == false ||
+			_magic != s_program_cache_magic || _version != s_program_cache_version) {
+			return false;
+		}
+		if (_read(&_stored_hash, sizeof(_stored_hash)) == false || _stored_hash != _source_hash ||
+			_read(&_driver_length, sizeof(_driver_length)) == false || _driver_length != m_driver.size()) {
+			return false;
+		}
+		std::string _driver(_driver_length, '\0');
+		if (_read(_driver.data(), _driver.size()) == false || _driver != m_driver) {
+			return false;
+		}
+		if (_read(&_format, sizeof(_format)) == false || _read(&_length, sizeof(_length)) == false || _length == 0ULL) {
+			return false;
+		}
+		std::vector<unsigned char> _binary(static_cast<size_t>(_length));
+		if (_read(_binary.data(), _binary.size()) == false) {
+			return false;
+		}
+		return _program->load_binary(_binary.data(), _binary.size(), _format);
+	}
+
+	void ProgramBinaryCache::store(const Program* _program, const std::vector<const char*>& _sources) const {
+		if (m_supported == false) {
+			return;
+		}
+		std::vector<unsigned char> _binary;
+		uint32_t _format = 0U;
+		if (_program->get_binary(_binary, _format) == false) {
+			return;
+		}
+		const uint64_t _source_hash = this->_hash_sources(_sources);
+		std::ofstream _file(this->_get_path(_source_hash), std::ios::binary | std::ios::trunc);
+		if (_file.is_open() == false) {
+			return;
+		}
+		auto _write = [&_file](const void* _data, size_t _length) {
+			_file.write(reinterpret_cast<const char*>(_data), static_cast<std::streamsize>(_length));
+		};
+		const uint32_t _driver_length = static_cast<uint32_t>(m_driver.size());
+		const uint64_t _length = _binary.size();
+		_write(&s_program_cache_magic, sizeof(s_program_cache_magic));
+		_write(&s_program_cache_version, sizeof(s_program_cache_version));
+		_write(&_source_hash, sizeof(_source_hash));
+		_write(&_driver_length, sizeof(_driver_length));
+		_write(m_driver.data(), m_driver.size());
+		_write(&_format, sizeof(_format));
+		_write(&_length, sizeof(_length));
+		_write(_binary.data(), _binary.size());
+	}
+
+	const bool& ProgramBinaryCache::supported() const {
+		return m_supported;
+	}
+
+	uint64_t ProgramBinaryCache::_hash_sources(const std::vector<const char*>& _sources) const {
+		std::string _joined { };
+		for (const auto& _source : _sources) {
+			_joined += (_source != nullptr ? _source : "");
+			_joined += '\0';
+		}
+		return static_cast<uint64_t>(std::hash<std::string>{}(_joined));
+	}
+
+	std::filesystem::path ProgramBinaryCache::_get_path(uint64_t _source_hash) const {
+		const uint64_t _file_hash = static_cast<uint64_t>(std::hash<std::string>{}(m_driver + "|" + std::to_string(_source_hash)));
+		return m_directory / (std::to_string(_file_hash) + ".glwb");
+	}
+
+	FramePacer::FramePacer(Window* _target, const FramePacerConfig& _cfg)
+		: m_target(_target),
+		m_config(_cfg)
+	{
+		m_adaptive_vsync_active = m_config.AdaptiveVSync && Context::get_adaptive_vsync_supported();
+		Context::set_interval(m_adaptive_vsync_active ? -1 : m_config.SwapInterval);
+		m_last_present_time = Context::get_time();
+		m_next_deadline = m_last_present_time;
+	}
+
+	FramePacer::~FramePacer() {
+		for (auto& _fence : m_fences) {
+			Context::delete_sync(_fence);
+		}
+		m_fences.clear();
+	}
+
+	void FramePacer::present() {
+		/* The fence follows this frame's commands, so waiting on the oldest one caps how far the CPU runs ahead */
+		if (m_config.MaxFramesInFlight > 0U) {
+			m_fences.emplace_back(Context::fence_sync());
+			while (m_fences.size() > m_config.MaxFramesInFlight) {
+				/* A failed wait would fail forever, so the fence is dropped instead of retried */
+				while (Context::client_wait_sync(m_fences.front(), 1000000000ULL) == SyncWaitResult::TimeoutExpired) { }
+				Context::delete_sync(m_fences.front());
+				m_fences.pop_front();
+			}
+		}
+
+		if (m_config.TargetFrameRate > 0.0) {
+			const double _period = 1.0 / m_config.TargetFrameRate;
+			m_next_deadline += _period;
+			const double _now = Context::get_time();
+			/* After a hitch the schedule restarts instead of rushing frames out to catch up */
+			if (_now > m_next_deadline + _period) {
+				m_next_deadline = _now;
+			}
+			this->_wait_until(m_next_deadline);
+		}
+
+		Context::swap_buffers(m_target);
+
+		const double _now = Context::get_time();
+		m_last_frame_interval = _now - m_last_present_time;
+		m_last_present_time = _now;
+		m_average_frame_interval = (m_frame_count == 0ULL)
+			? m_last_frame_interval
+			: m_average_frame_interval + (m_last_frame_interval - m_average_frame_interval) * FramePacer::average_weight;
+		m_frame_count++;
+	}
+
+	void FramePacer::set_target_frame_rate(double _value) {
+		m_config.TargetFrameRate = _value;
+		m_next_deadline = Context::get_time();
+	}
+
+	const FramePacerConfig& FramePacer::get_config() const {
+		return m_config;
+	}
+
+	const bool& FramePacer::get_adaptive_vsync_active() const {
+		return m_adaptive_vsync_active;
+	}
+
+	const double& FramePacer::get_last_frame_interval() const {
+		return m_last_frame_interval;
+	}
+
+	const double& FramePacer::get_average_frame_interval() const {
+		return m_average_frame_interval;
+	}
+
+	const uint64_t& FramePacer::get_frame_count() const {
+		return m_frame_count;
+	}
+
+	void FramePacer::_wait_until(double _time) const {
+		const double _sleep = _time - Context::get_time() - m_config.SpinThreshold;
+		if (_sleep > 0.0) {
+			std::this_thread::sleep_for(std::chrono::duration<double>(_sleep));
+		}
+		while (Context::get_time() < _time) {
+			std::this_thread::yield();
+		}
+	}
+
 }
\ No newline at end of file
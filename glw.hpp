@@ -15,6 +15,11 @@
 			GLFW Window
 			OpenGL Objects (VAO, VBO, EBO ...)
 			OpenGL Shader & Program
+			OpenGL Compute Program & Shader Storage Buffer
+			OpenGL Program Binary Cache
+			Frame Pacer
+			Shared Contexts
+			Lock-free Event Queue & Decoupled Render Thread
 	
 	TODOs
 		Uniform Buffer Object
@@ -58,8 +63,39 @@
 #include <string>    // std::string
 #include <queue>     // std::queue
 #include <map>       // std::map
+#include <vector>    // std::vector
+#include <utility>   // std::swap
+#include <fstream>   // std::ifstream, std::ofstream
+#include <filesystem> // std::filesystem
+#include <atomic>    // std::atomic
+#include <thread>    // std::thread
+#include <functional> // std::function
+#include <exception> // std::exception_ptr
+#include <chrono>    // std::chrono
+#include <deque>     // std::deque
+#include <optional>  // std::optional
 /* GLAD */
 #include <GLAD/glad.h>
+/* S3TC is an extension, so not every GLAD build defines its tokens */
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT 0x8C4D
+#endif
+#ifndef GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT 0x8C4F
+#endif
+/* Same value for KHR_parallel_shader_compile and ARB_parallel_shader_compile */
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
 /* GLFW */
 #include <GLFW/glfw3.h>
 
@@ -91,6 +127,11 @@ namespace glw {
 			GLProgramLinkFailure(const char* _log)
 				: std::runtime_error("[GL] : Failed to link program : Log = " + std::string(_log)) { }
 		};
+		class GLInvalidShaderType : public std::runtime_error {
+		public:
+			GLInvalidShaderType(const char* _expected, const char* _type)
+				: std::runtime_error("[GL] : Invalid shader type : Expected = " + std::string(_expected) + " : Type = " + _type) { }
+		};
 	}
 	/* GLFW Flags */
 	enum class CursorType {
@@ -246,6 +287,10 @@ namespace glw {
 	enum class ArrayBufferType : uint32_t {
 		VertexBuffer = GL_ARRAY_BUFFER,
 		ElementBuffer = GL_ELEMENT_ARRAY_BUFFER,
+		TransformFeedbackBuffer = GL_TRANSFORM_FEEDBACK_BUFFER,
+		ShaderStorageBuffer = GL_SHADER_STORAGE_BUFFER,
+		DispatchIndirectBuffer = GL_DISPATCH_INDIRECT_BUFFER,
+		DrawIndirectBuffer = GL_DRAW_INDIRECT_BUFFER,
 	};
 
 	enum class DataType : uint32_t {
@@ -268,7 +313,9 @@ namespace glw {
 		UnsignedShort1555Rev = GL_UNSIGNED_SHORT_1_5_5_5_REV,
 		UnsignedInt8888 = GL_UNSIGNED_INT_8_8_8_8,
 		UnsignedInt8888Rev = GL_UNSIGNED_INT_8_8_8_8_REV,
-		UnsignedInt101010102 = GL_UNSIGNED_INT_10_10_10_2
+		UnsignedInt101010102 = GL_UNSIGNED_INT_10_10_10_2,
+		UnsignedInt248 = GL_UNSIGNED_INT_24_8,
+		Float32UnsignedInt248Rev = GL_FLOAT_32_UNSIGNED_INT_24_8_REV
 	};
 
 	enum class NumericType : uint32_t {
@@ -316,6 +363,8 @@ namespace glw {
 		CullFace = GL_CULL_FACE,
 		Blend = GL_BLEND,
 		Scissor = GL_SCISSOR_TEST,
+		RasterizerDiscard = GL_RASTERIZER_DISCARD,
+		ProgramPointSize = GL_PROGRAM_POINT_SIZE,
 	};
 
 	/*
@@ -392,6 +441,17 @@ namespace glw {
 		CompressedSignedRedRGTC1 = GL_COMPRESSED_SIGNED_RED_RGTC1,
 		CompressedSignedRGRGTC2 = GL_COMPRESSED_SIGNED_RG_RGTC2,
 		CompressedSRGB = GL_COMPRESSED_SRGB,
+		CompressedRGBS3TCDXT1 = GL_COMPRESSED_RGB_S3TC_DXT1_EXT,
+		CompressedRGBAS3TCDXT1 = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT,
+		CompressedRGBAS3TCDXT5 = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT,
+		CompressedSRGBAS3TCDXT1 = GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT,
+		CompressedSRGBAS3TCDXT5 = GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT,
+		CompressedRGBABPTC = GL_COMPRESSED_RGBA_BPTC_UNORM,
+		CompressedSRGBABPTC = GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM,
+		CompressedRGB8ETC2 = GL_COMPRESSED_RGB8_ETC2,
+		CompressedSRGB8ETC2 = GL_COMPRESSED_SRGB8_ETC2,
+		CompressedRGBA8ETC2EAC = GL_COMPRESSED_RGBA8_ETC2_EAC,
+		CompressedSRGB8A8ETC2EAC = GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC,
 		DepthStencil = GL_DEPTH_STENCIL,
 		Depth24Stencil8 = GL_DEPTH24_STENCIL8,
 		Depth32FStencil8 = GL_DEPTH32F_STENCIL8,
@@ -459,6 +519,12 @@ namespace glw {
 		SRGBA = GL_SRGB_ALPHA
 	};
 
+	enum class TextureTarget : uint32_t {
+		Texture2D = GL_TEXTURE_2D,
+		Texture2DArray = GL_TEXTURE_2D_ARRAY,
+		Texture2DMultisample = GL_TEXTURE_2D_MULTISAMPLE,
+	};
+
 	enum class TextureFormat : uint32_t {
 		Red = GL_RED,
 		Green = GL_GREEN,
@@ -642,6 +708,13 @@ namespace glw {
 		Undefined = GL_FRAMEBUFFER_UNDEFINED,
 	};
 
+	enum class SyncWaitResult : uint32_t {
+		AlreadySignaled = GL_ALREADY_SIGNALED,
+		ConditionSatisfied = GL_CONDITION_SATISFIED,
+		TimeoutExpired = GL_TIMEOUT_EXPIRED,
+		WaitFailed = GL_WAIT_FAILED
+	};
+
 	enum class ShaderType : uint32_t {
 		Vertex = GL_VERTEX_SHADER,
 		TessellationControl = GL_TESS_CONTROL_SHADER,
@@ -651,15 +724,40 @@ namespace glw {
 		Compute = GL_COMPUTE_SHADER,
 	};
 
+	enum class TransformFeedbackBufferMode : uint32_t {
+		Interleaved = GL_INTERLEAVED_ATTRIBS,
+		Separate = GL_SEPARATE_ATTRIBS,
+	};
+
+	enum class MemoryBarrierType : uint32_t {
+		VertexAttribArray = GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT,
+		ElementArray = GL_ELEMENT_ARRAY_BARRIER_BIT,
+		Uniform = GL_UNIFORM_BARRIER_BIT,
+		TextureFetch = GL_TEXTURE_FETCH_BARRIER_BIT,
+		ShaderImageAccess = GL_SHADER_IMAGE_ACCESS_BARRIER_BIT,
+		Command = GL_COMMAND_BARRIER_BIT,
+		PixelBuffer = GL_PIXEL_BUFFER_BARRIER_BIT,
+		TextureUpdate = GL_TEXTURE_UPDATE_BARRIER_BIT,
+		BufferUpdate = GL_BUFFER_UPDATE_BARRIER_BIT,
+		Framebuffer = GL_FRAMEBUFFER_BARRIER_BIT,
+		TransformFeedback = GL_TRANSFORM_FEEDBACK_BARRIER_BIT,
+		AtomicCounter = GL_ATOMIC_COUNTER_BARRIER_BIT,
+		ShaderStorage = GL_SHADER_STORAGE_BARRIER_BIT,
+		All = GL_ALL_BARRIER_BITS,
+	};
+
 	_GLW_FLAG_COMPOSITION(BufferType, uint32_t);
 	_GLW_FLAG_COMPOSITION(CapabilityType, uint32_t);
+	_GLW_FLAG_COMPOSITION(MemoryBarrierType, uint32_t);
 
 
 	/* GLFW & GLAD Wrappers */
 	class Context;
 	class ErrorQueue;
+	class ContextState;
 
 	struct Event;
+	class EventRingBuffer;
 	struct WindowConfig;
 	class Window;
 
@@ -670,16 +768,26 @@ namespace glw {
 	class VertexArrayObject;
 	class VertexBufferObject;
 	class ElementBufferObject;
+	class ShaderStorageBufferObject;
+	struct DrawElementsIndirectCommand;
+	class DrawIndirectBufferObject;
 	class FrameBufferObject;
 	class RenderBufferObject;
 
 	struct TextureConfig;
+	struct CompressedTextureLevel;
 	class Texture;
 
 	class Shader;
 	class Program;
+	class ComputeProgram;
+	class ProgramBinaryCache;
+
+	struct FramePacerConfig;
+	class FramePacer;
 	
 	class Context final {
+		friend class ContextState;
 	public:
 		Context() = delete;
 		Context(const Context&) = delete;
@@ -690,18 +798,37 @@ namespace glw {
 	public:
 		static void initialize();
 		static void make_current(Window* _target);
+		/* Detaches the calling thread's context, so another thread can make it current */
+		static void release_current();
 		static void activate();
 		static void set_interval(int _value) noexcept;
 		static void finalize() noexcept;
 	public:
 		static double get_time() noexcept;
 		static ErrorType get_error() noexcept;
+		/* State of the context current on the calling thread, nullptr if none or if it does not belong to a glw::Window */
+		static ContextState* get_state() noexcept;
+		static void flush();
+		static void finish();
 		static void swap_buffers(Window* _target);
 		static void poll_events() noexcept;
+		static void wait_events() noexcept;
+		static void wait_events_timeout(double _seconds) noexcept;
+		/* Wakes a wait_events() call. Safe from any thread. */
+		static void post_empty_event() noexcept;
+		/*
+			Runs _frame on a new thread with _target's context current until it returns false, while the calling thread
+			waits on events and feeds every window's event queue. GLFW only processes events on the main thread,
+			so call this from the main thread; it becomes the input thread and rendering never delays input.
+			glfw queries such as Window::get_key_is_held() belong to the main thread, so _frame should rely on events.
+			An exception thrown by _frame is rethrown here.
+		*/
+		static void run_render_thread(Window* _target, const std::function<bool()>& _frame);
 	public:
 		static void viewport(int _xpos, int _ypos, uint32_t _width, uint32_t _height);
 	public:
 		static void get_viewport(int& _out_xpos, int& _out_ypos, uint32_t& _out_width, uint32_t& _out_height);
+		static uint32_t get_frame_buffer_binding();
 		static bool get_is_enabled(CapabilityType _type);
 	public:
 		static void blend_func(BlendFuncType _src, BlendFuncType _dst);
@@ -717,6 +844,8 @@ namespace glw {
 		static void bind_vertex_array(const uint32_t& _id);
 		static void enable_vertex_attrib_array(const uint32_t& _offset_index);
 		static void vertex_attrib_pointer(const uint32_t& _offset_index, const uint32_t& _count, const NumericType& _type, bool _norm, const size_t& _stride, const intptr_t& _offset);
+		static void vertex_attrib_divisor(const uint32_t& _offset_index, const uint32_t& _divisor);
+		static void set_vertex_attrib_vec4(const uint32_t& _offset_index, float _x, float _y, float _z, float _w);
 		static void delete_vertex_array(const uint32_t& _id);
 	public:
 		static uint32_t generate_buffer();
@@ -724,79 +853,168 @@ namespace glw {
 		static void bind_array_buffer_data(const ArrayBufferType& _type, const BufferData& _data, BufferUsage _usage);
 		static void bind_empty_array_buffer_data(const ArrayBufferType& _type, const size_t& _length, BufferUsage _usage);
 		static void bind_array_buffer_sub_data(const ArrayBufferType& _type, const BufferData& _data, const size_t& _offset);
+		static void bind_array_buffer_sub_data(const ArrayBufferType& _type, const void* _data, const size_t& _length, const size_t& _offset);
+		static void bind_buffer_base(const ArrayBufferType& _type, const uint32_t& _index, const uint32_t& _id);
 		static void delete_buffer(const uint32_t& _id);
 	public:
 		static uint32_t generate_frame_buffer();
 		static void bind_frame_buffer(const uint32_t& _id);
-		static void attach_texture_2d(const uint32_t& _fbo, AttachmentType _type, const uint32_t& _id);
+		static void attach_texture_2d(const uint32_t& _fbo, AttachmentType _type, const uint32_t& _id, TextureTarget _target = TextureTarget::Texture2D);
+		static void attach_texture_layer(const uint32_t& _fbo, AttachmentType _type, const uint32_t& _id, const uint32_t& _layer);
 		static void attach_render_buffer(const uint32_t& _fbo, AttachmentType _type, const uint32_t& _rbo);
 		static void check_framebuffer_link_status();
 		static void delete_frame_buffer(const uint32_t& _id);
+		/* glInvalidateFramebuffer on the bound framebuffer (GL 4.3 / ARB_invalidate_subdata), a no-op without it */
+		static void invalidate_frame_buffer(const std::vector<AttachmentType>& _attachments);
+		/* Leaves _dst bound as both read and draw framebuffer */
+		static void blit_frame_buffer(const uint32_t& _src, const uint32_t& _dst, int _src_x0, int _src_y0, int _src_x1, int _src_y1, int _dst_x0, int _dst_y0, int _dst_x1, int _dst_y1, BufferType _mask, FilterType _filter);
+		static uint32_t get_max_samples();
 	public:
 		static void read_buffer(ReadBufferType _type);
 		static void draw_buffer(DrawBufferType _type);
+		static void draw_buffers(const std::vector<AttachmentType>& _attachments);
 	public:
 		static uint32_t generate_render_buffer();
 		static void bind_render_buffer(const uint32_t& _id);
 		static void set_render_buffer_storage(InternalFormat _format, const uint32_t& _width, const uint32_t& _height);
+		static void set_render_buffer_storage_multisample(InternalFormat _format, const uint32_t& _width, const uint32_t& _height, const uint32_t& _samples);
 		static void delete_render_buffer(const uint32_t& _id);
 	public:
 		static uint32_t generate_texture();
-		static void set_filter(FilterType _mag, FilterType _min);
-		static void set_wrapping_mode(WrappingType _s, WrappingType _t);
+		static void set_filter(FilterType _mag, FilterType _min, TextureTarget _target = TextureTarget::Texture2D);
+		static void set_wrapping_mode(WrappingType _s, WrappingType _t, TextureTarget _target = TextureTarget::Texture2D);
 		static void set_image(const unsigned char* _data, uint32_t _width, uint32_t _height, InternalFormat _i_format, TextureFormat _t_format, DataType _type);
-		static void generate_mipmap();
+		static void set_image_layers(const unsigned char* _data, uint32_t _width, uint32_t _height, uint32_t _layers, InternalFormat _i_format, TextureFormat _t_format, DataType _type);
+		static void set_image_multisample(uint32_t _width, uint32_t _height, uint32_t _samples, InternalFormat _i_format);
+		static void set_image_layer(const unsigned char* _data, uint32_t _layer, uint32_t _width, uint32_t _height, TextureFormat _t_format, DataType _type);
+		static void set_image_level(const unsigned char* _data, uint32_t _level, uint32_t _width, uint32_t _height, InternalFormat _i_format, TextureFormat _t_format, DataType _type);
+		static void set_compressed_image(const void* _data, size_t _length, uint32_t _level, uint32_t _width, uint32_t _height, InternalFormat _i_format);
+		static void set_unpack_alignment(uint32_t _alignment);
+		static void set_level_range(uint32_t _base, uint32_t _max, TextureTarget _target = TextureTarget::Texture2D);
+		static void get_level_size(uint32_t _level, uint32_t& _out_width, uint32_t& _out_height, TextureTarget _target = TextureTarget::Texture2D);
+		static bool get_level_is_compressed(uint32_t _level, TextureTarget _target = TextureTarget::Texture2D);
+		static InternalFormat get_level_internal_format(uint32_t _level, TextureTarget _target = TextureTarget::Texture2D);
+		static size_t get_compressed_image_size(uint32_t _level, TextureTarget _target = TextureTarget::Texture2D);
+		static void get_compressed_image(uint32_t _level, void* _out, TextureTarget _target = TextureTarget::Texture2D);
+		static void generate_mipmap(TextureTarget _target = TextureTarget::Texture2D);
 		static void activate_texture(const TextureSlot& _slot);
 		static void bind_texture_2d(const uint32_t& _id);
+		static void bind_texture(const TextureTarget& _target, const uint32_t& _id);
 		static void delete_texture(const uint32_t& _id);
 	public:
 		static uint32_t create_shader(const ShaderType& _type);
 		static void set_source(const uint32_t& _id, const char* _src);
 		static void compile_shader(const ShaderType& _type, const uint32_t& _id);
+		static void compile_shader_deferred(const uint32_t& _id);
+		static bool get_shader_compile_completion(const uint32_t& _id);
 		static void delete_shader(const uint32_t& _id);
 		static void check_shader_compile_status(const ShaderType& _type, const uint32_t& _id);
+		/* KHR/ARB_parallel_shader_compile. Without it completion queries report true and the first status check blocks. */
+		static bool get_parallel_shader_compile_supported();
 	public:
 		static uint32_t create_program();
 		static void attach_shader(const uint32_t& _program, const uint32_t& _shader);
+		static void transform_feedback_varyings(const uint32_t& _id, const char* const* _varyings, const uint32_t& _count, TransformFeedbackBufferMode _mode);
 		static void link_program(const uint32_t& _id);
+		static void link_program_deferred(const uint32_t& _id);
+		static bool get_program_link_completion(const uint32_t& _id);
 		static void check_program_link_status(const uint32_t& _id);
 		static int get_uniform_location(const uint32_t& _id, const char* _name);
 		static void set_uniform_int(const int& _loc, int _value);
 		static void set_uniform_uint(const int& _loc, uint32_t _value);
 		static void set_uniform_float(const int& _loc, float _value);
+		static void set_uniform_floats(const int& _loc, const float* _ptr, uint32_t _count);
 		static void set_uniform_vec2(const int& _loc, float _x, float _y);
 		static void set_uniform_vec3(const int& _loc, float _x, float _y, float _z);
 		static void set_uniform_vec4(const int& _loc, float _x, float _y, float _z, float _w);
 		static void set_uniform_mat2(const int& _loc, const float* _ptr);
 		static void set_uniform_mat3(const int& _loc, const float* _ptr);
 		static void set_uniform_mat4(const int& _loc, const float* _ptr);
+		static void get_compute_work_group_size(const uint32_t& _id, uint32_t& _out_x, uint32_t& _out_y, uint32_t& _out_z);
+		static bool get_program_binary_supported();
+		static void set_program_binary_retrievable(const uint32_t& _id);
+		static void get_program_binary(const uint32_t& _id, std::vector<unsigned char>& _out, uint32_t& _out_format);
+		/* Returns the link status instead of throwing, since drivers may reject binaries from older versions */
+		static bool program_binary(const uint32_t& _id, uint32_t _format, const void* _data, size_t _length);
 		static void use_program(const uint32_t& _id);
 		static void delete_program(const uint32_t& _id);
+	public:
+		static const char* get_vendor();
+		static const char* get_renderer();
+		static const char* get_version();
 	public:
 		static void draw_arrays(
 			const PrimitiveType& _mode,
 			const int& _offset,
 			const uint32_t& _index_count
 		);
+		static void draw_arrays_instanced(
+			const PrimitiveType& _mode,
+			const int& _offset,
+			const uint32_t& _index_count,
+			const uint32_t& _instance_count
+		);
 		static void draw_elements(
 			const PrimitiveType& _mode,
 			const uint32_t& _index_count,
 			const NumericType& _type,
 			const intptr_t& _offset
 		);
+		static void draw_elements_instanced(
+			const PrimitiveType& _mode,
+			const uint32_t& _index_count,
+			const NumericType& _type,
+			const intptr_t& _offset,
+			const uint32_t& _instance_count
+		);
+		static void draw_elements_indirect(
+			const PrimitiveType& _mode,
+			const NumericType& _type,
+			const intptr_t& _offset
+		);
+		static void multi_draw_elements_indirect(
+			const PrimitiveType& _mode,
+			const NumericType& _type,
+			const intptr_t& _offset,
+			const uint32_t& _draw_count,
+			const size_t& _stride
+		);
+	public:
+		static void begin_transform_feedback(const PrimitiveType& _mode);
+		static void end_transform_feedback();
+	public:
+		static void dispatch_compute(const uint32_t& _group_x, const uint32_t& _group_y, const uint32_t& _group_z);
+		static void dispatch_compute_indirect(const intptr_t& _offset);
+		static void memory_barrier(MemoryBarrierType _flags);
+	public:
+		static GLsync fence_sync();
+		/* TimeoutExpired if _timeout_nanoseconds passed first. WaitFailed never changes on retry. */
+		static SyncWaitResult client_wait_sync(GLsync _sync, uint64_t _timeout_nanoseconds);
+		static void delete_sync(GLsync _sync);
+		/*
+			Makes the current context's GPU queue wait for _sync, without blocking the CPU.
+			Objects written in a shared context are safe to use here after waiting on a fence that context flushed.
+		*/
+		static void wait_sync(GLsync _sync);
+	public:
+		/* Swap interval -1 (GLX / WGL_EXT_swap_control_tear) : vsync, but late frames tear instead of waiting a whole refresh */
+		static bool get_adaptive_vsync_supported() noexcept;
+	private:
+		/* Uncached, ContextState keeps the results */
+		static bool _query_parallel_shader_compile_supported();
+		static bool _query_program_binary_supported();
 	};
 
 	class ErrorQueue final {
+		friend class ContextState;
 	private:
 		std::queue<ErrorType> m_queue;
 	private:
 		ErrorQueue() = default;
 		~ErrorQueue() = default;
 	public:
-		static ErrorQueue& get_instance() {
-			static ErrorQueue _instance;
-			return _instance;
-		}
+		/* The queue of the current context, or a process-wide one when no glw::Window context is current */
+		static ErrorQueue& get_instance();
 	public:
 		void check();
 		void pop();
@@ -805,6 +1023,27 @@ namespace glw {
 		void flush();
 	};
 
+	/*
+		What glw remembers about one GL context. Every Window owns one, including worker contexts,
+		so threads rendering through different contexts never share it. See Context::get_state().
+	*/
+	class ContextState final {
+	private:
+		ErrorQueue m_error_queue { };
+		std::optional<bool> m_parallel_shader_compile_supported { };
+		std::optional<bool> m_program_binary_supported { };
+	public:
+		ContextState() = default;
+		ContextState(const ContextState&) = delete;
+		ContextState& operator=(const ContextState&) = delete;
+		~ContextState() = default;
+	public:
+		ErrorQueue& get_error_queue();
+		/* Queried once, on first use while this context is current */
+		bool get_parallel_shader_compile_supported();
+		bool get_program_binary_supported();
+	};
+
 	enum class EventType : uint32_t {
 		Unknown = 0,
 		KeyJustPressed,
@@ -880,6 +1119,40 @@ namespace glw {
 			} maximized_window;
 		} data { };
 		EventType type = EventType::Unknown;
+		/* Context::get_time() when the callback fired */
+		double timestamp = 0.0;
+	};
+
+	/* Fixed-capacity single-producer / single-consumer queue. Never locks, and never allocates after construction. */
+	class EventRingBuffer final {
+	public:
+		static constexpr size_t cache_line_size = 64ULL;
+	private:
+		std::vector<Event> m_events { };
+		size_t m_mask = 0ULL;
+		/* Written by the consumer only */
+		alignas(cache_line_size) std::atomic<size_t> m_head { 0ULL };
+		/* Written by the producer only */
+		alignas(cache_line_size) std::atomic<size_t> m_tail { 0ULL };
+		std::atomic<uint64_t> m_dropped_count { 0ULL };
+	public:
+		EventRingBuffer() = delete;
+		/* Rounded up to a power of two */
+		EventRingBuffer(size_t _capacity);
+		EventRingBuffer(const EventRingBuffer&) = delete;
+		EventRingBuffer& operator=(const EventRingBuffer&) = delete;
+		~EventRingBuffer() = default;
+	public:
+		/* Producer side. A full queue drops _event and counts it. */
+		bool push(const Event& _event);
+		/* Consumer side */
+		bool pop(Event& _out_event);
+		bool peek(Event& _out_event) const;
+	public:
+		size_t capacity() const;
+		size_t size() const;
+		bool empty() const;
+		uint64_t dropped_count() const;
 	};
 
 	struct WindowConfig {
@@ -905,6 +1178,16 @@ namespace glw {
 		bool FullscreenEnabled = false;
 		bool CursorDisabled = false;
 		bool RelativeCursorRequested = false;
+	public:
+		/* GL objects are shared with this window's context (textures, buffers, programs ... but not VAOs or FBOs) */
+		Window* SharedWindow = nullptr;
+	public:
+		/* Events beyond this many unread ones are dropped, see Window::get_dropped_event_count() */
+		uint32_t EventQueueCapacity = 1024U;
+		/* pop_event() merges consecutive MousePositionChanged and MouseScrollDetected events, accumulating their deltas */
+		bool EventCoalescingEnabled = false;
+		/* Samples merged into the last popped event are kept up to this count, see Window::get_coalesced_events(). 0 keeps none. */
+		uint32_t CoalescedEventCapacity = 0U;
 	};
 
 	class Window final {
@@ -920,10 +1203,17 @@ namespace glw {
 		static void callback_termination_requested(GLFWwindow* window);
 		static void callback_window_minimized(GLFWwindow* window, int value);
 		static void callback_window_maximized(GLFWwindow* window, int value);
+	private:
+		/* Stamps _event with the current time and queues it */
+		void _push_event(Event& _event);
 	private:
 		WindowConfig m_config { };
 		int          m_origin_width = 0;
 		int          m_origin_height = 0;
+	private:
+		/* Written by the size callback on the polling thread, read by get_width()/get_height() from any thread */
+		std::atomic<int> m_width { 0 };
+		std::atomic<int> m_height { 0 };
 	private:
 		GLFWwindow* m_window = nullptr;
 	private:
@@ -938,13 +1228,31 @@ namespace glw {
 		GLFWcursor* m_cursor_resize_all = nullptr;
 		GLFWcursor* m_cursor_not_allowed = nullptr;
 	private:
-		std::queue<Event> m_event_queue { };
+		/* Filled by the thread polling events, drained by the thread calling pop_event() */
+		EventRingBuffer m_event_queue;
+		std::vector<Event> m_coalesced_events { };
+	private:
+		/* Written by callback_mouse_moved only, so each window has its own relative motion */
+		double m_last_mouse_xpos = 0.0;
+		double m_last_mouse_ypos = 0.0;
+	private:
+		ContextState m_context_state { };
 	public:
 		Window() = delete;
 		Window(const WindowConfig& _cfg);
 		~Window();
 	public:
 		bool pop_event(Event& _out_event);
+		uint64_t get_dropped_event_count() const;
+		/* Every raw sample merged into the event last returned by pop_event(), oldest first */
+		const std::vector<Event>& get_coalesced_events() const;
+	public:
+		/*
+			Config of a hidden 1x1 window sharing this window's objects, for a worker thread's context
+			(background uploads ...). Create it on the main thread, then make it current on the worker.
+		*/
+		WindowConfig get_worker_config();
+		ContextState& get_context_state();
 	public:
 		void set_title(const char* _value);
 		void set_resizable(bool _value);
@@ -956,6 +1264,7 @@ namespace glw {
 		void set_mouse_position(double _xpos, double _ypos);
 		void set_fullscreen_enabled(bool _value);
 		void set_cursor_disabled(bool _value);
+		void set_event_coalescing_enabled(bool _value);
 	public:
 		void set_icon(unsigned char* _data);
 		void set_cursor(const CursorType& _type);
@@ -970,12 +1279,13 @@ namespace glw {
 		void get_monitor_resolution(int& _out_width, int& _out_height) const;
 	public:
 		const bool& get_visible() const;
-		const int& get_width() const;
-		const int& get_height() const;
+		int get_width() const;
+		int get_height() const;
 		const int& get_origin_width() const;
 		const int& get_origin_height() const;
 		const bool& get_fullscreen_enabled() const;
 		const bool& get_cursor_disabled() const;
+		const bool& get_event_coalescing_enabled() const;
 	};
 
 	class BufferData final {
@@ -988,6 +1298,10 @@ namespace glw {
 		void add_int32(const int& _data);
 		void add_uint32(const uint32_t& _data);
 		void add_float(const float& _data);
+		void add_floats(const float* _data, size_t _count);
+	public:
+		void reserve(size_t _length);
+		void clear();
 	private:
 		void _add(const unsigned char* _data, size_t _count);
 	public:
@@ -995,12 +1309,17 @@ namespace glw {
 		size_t get_length() const;
 	};
 	
+	/* Handles own their GL name: they can be moved but never copied, and a moved-from handle holds 0. */
 	class Handle abstract {
 	protected:
 		uint32_t m_ID = 0U;
 	public:
 		Handle() = delete;
 		Handle(const uint32_t& _id);
+		Handle(const Handle&) = delete;
+		Handle(Handle&& _other) noexcept;
+		Handle& operator=(const Handle&) = delete;
+		Handle& operator=(Handle&& _other) noexcept;
 		virtual ~Handle() = 0;
 	public:
 		virtual void bind() const = 0;
@@ -1011,11 +1330,14 @@ namespace glw {
 	class VertexArrayObject final : public Handle {
 	public:
 		VertexArrayObject();
+		VertexArrayObject(VertexArrayObject&&) = default;
+		VertexArrayObject& operator=(VertexArrayObject&&) = default;
 		~VertexArrayObject() override;
 	public:
 		void bind() const override;
 	public:
 		void attrib_pointer(const uint32_t& _offset_index, const uint32_t& _count, const NumericType& _type, const size_t& _stride, intptr_t _offset) const;
+		void attrib_divisor(const uint32_t& _offset_index, const uint32_t& _divisor) const;
 	public:
 		static void bind_default();
 	};
@@ -1023,6 +1345,8 @@ namespace glw {
 	class VertexBufferObject final : public Handle {
 	public:
 		VertexBufferObject();
+		VertexBufferObject(VertexBufferObject&&) = default;
+		VertexBufferObject& operator=(VertexBufferObject&&) = default;
 		~VertexBufferObject() override;
 	public:
 		void bind() const override;
@@ -1032,11 +1356,15 @@ namespace glw {
 		void bind_data(const BufferData& _data, BufferUsage _usage) const;
 		void bind_empty_data(const size_t& _length, BufferUsage _usage) const;
 		void bind_sub_data(const BufferData& _data, size_t _offset) const;
+		void bind_sub_data(const void* _data, size_t _length, size_t _offset) const;
+		void bind_base(ArrayBufferType _type, uint32_t _index) const;
 	};
 
 	class ElementBufferObject final : public Handle {
 	public:
 		ElementBufferObject();
+		ElementBufferObject(ElementBufferObject&&) = default;
+		ElementBufferObject& operator=(ElementBufferObject&&) = default;
 		~ElementBufferObject() override;
 	public:
 		void bind() const override;
@@ -1047,12 +1375,59 @@ namespace glw {
 		void bind_empty_data(const size_t& _length, BufferUsage _usage) const;
 		void bind_sub_data(const BufferData& _data, size_t _offset) const;
 	};
+
+	class ShaderStorageBufferObject final : public Handle {
+	public:
+		ShaderStorageBufferObject();
+		ShaderStorageBufferObject(ShaderStorageBufferObject&&) = default;
+		ShaderStorageBufferObject& operator=(ShaderStorageBufferObject&&) = default;
+		~ShaderStorageBufferObject() override;
+	public:
+		void bind() const override;
+	public:
+		static void bind_default();
+	public:
+		void bind_data(const BufferData& _data, BufferUsage _usage) const;
+		void bind_empty_data(const size_t& _length, BufferUsage _usage) const;
+		void bind_sub_data(const BufferData& _data, size_t _offset) const;
+		void bind_sub_data(const void* _data, size_t _length, size_t _offset) const;
+		void bind_base(uint32_t _index) const;
+	};
+
+	/* Laid out as GL expects in GL_DRAW_INDIRECT_BUFFER, so an array of these can be uploaded as is. */
+	struct DrawElementsIndirectCommand {
+		uint32_t Count = 0U;
+		uint32_t InstanceCount = 0U;
+		uint32_t FirstIndex = 0U;
+		int32_t  BaseVertex = 0;
+		uint32_t BaseInstance = 0U;
+	};
+
+	class DrawIndirectBufferObject final : public Handle {
+	public:
+		DrawIndirectBufferObject();
+		DrawIndirectBufferObject(DrawIndirectBufferObject&&) = default;
+		DrawIndirectBufferObject& operator=(DrawIndirectBufferObject&&) = default;
+		~DrawIndirectBufferObject() override;
+	public:
+		void bind() const override;
+	public:
+		static void bind_default();
+	public:
+		void bind_data(const BufferData& _data, BufferUsage _usage) const;
+		void bind_empty_data(const size_t& _length, BufferUsage _usage) const;
+		void bind_sub_data(const BufferData& _data, size_t _offset) const;
+		void bind_sub_data(const void* _data, size_t _length, size_t _offset) const;
+		void bind_base(ArrayBufferType _type, uint32_t _index) const;
+	};
 	
 	class FrameBufferObject : public Handle {
 	private:
 		std::map<AttachmentType, const Texture*> m_texture_attachments { };
 	public:
 		FrameBufferObject();
+		FrameBufferObject(FrameBufferObject&&) = default;
+		FrameBufferObject& operator=(FrameBufferObject&&) = default;
 		~FrameBufferObject() override;
 	public:
 		void bind() const override;
@@ -1060,7 +1435,20 @@ namespace glw {
 		static void bind_default();
 	public:
 		void attach_texture(AttachmentType _type, const Texture* _tex);
+		void attach_texture_layer(AttachmentType _type, const Texture* _tex, uint32_t _layer);
 		void attach_render_buffer(AttachmentType _type, const RenderBufferObject* _rbo);
+		/* The following act on the bound framebuffer, like the attach functions */
+		void set_draw_buffers(const std::vector<AttachmentType>& _attachments);
+		/* Tells the driver the contents of _attachments are no longer needed, so tiled GPUs skip loading or storing them */
+		void invalidate(const std::vector<AttachmentType>& _attachments) const;
+	public:
+		/*
+			Copies into _target, or the default framebuffer when nullptr, resolving multisampled sources on the way.
+			Depth and stencil need FilterType::Nearest, and a multisampled source needs equal source and destination rects.
+			Leaves _target bound.
+		*/
+		void blit_to(const FrameBufferObject* _target, uint32_t _width, uint32_t _height, BufferType _mask = BufferType::Color, FilterType _filter = FilterType::Nearest) const;
+		void blit_to(const FrameBufferObject* _target, int _src_x0, int _src_y0, int _src_x1, int _src_y1, int _dst_x0, int _dst_y0, int _dst_x1, int _dst_y1, BufferType _mask, FilterType _filter) const;
 	public:
 		const Texture* get_attached_texture(AttachmentType _type) const;
 	public:
@@ -1070,6 +1458,8 @@ namespace glw {
 	class RenderBufferObject : public Handle {
 	public:
 		RenderBufferObject();
+		RenderBufferObject(RenderBufferObject&&) = default;
+		RenderBufferObject& operator=(RenderBufferObject&&) = default;
 		~RenderBufferObject() override;
 	public:
 		void bind() const override;
@@ -1077,6 +1467,8 @@ namespace glw {
 		static void bind_default();
 	public:
 		void set_storage(InternalFormat _format, uint32_t _width, uint32_t _height);
+		/* Multisampled storage, resolved by blitting into a single-sampled framebuffer */
+		void set_storage(InternalFormat _format, uint32_t _width, uint32_t _height, uint32_t _samples);
 	};
 
 	struct TextureConfig {
@@ -1089,27 +1481,77 @@ namespace glw {
 		DataType FormatData = DataType::UnsignedByte;
 		bool MipmapGeneration = false;
 		bool FilpY = true;
+		/* Above 1, the empty-texture constructor allocates a GL_TEXTURE_2D_MULTISAMPLE, which ignores filters, wrapping and mipmaps */
+		uint32_t Samples = 1U;
+	};
+
+	struct CompressedTextureLevel {
+		const unsigned char* Data = nullptr;
+		size_t Length = 0ULL;
+		uint32_t Width = 0U;
+		uint32_t Height = 0U;
 	};
 
 	class Texture : public Handle {
 	private:
 		TextureConfig m_config { };
+		TextureTarget m_target = TextureTarget::Texture2D;
 	private:
 		uint32_t m_width = 0U;
 		uint32_t m_height = 0U;
+		uint32_t m_layers = 1U;
+		uint32_t m_levels = 1U;
+		uint32_t m_base_level = 0U;
 		uint32_t m_channels = 0U;
+	private:
+		/* Set by set_layer(), so filling an array regenerates its mip chain once instead of per layer */
+		mutable bool m_need_to_generate_mipmap = false;
 	public:
 		Texture(const TextureConfig& _cfg, const uint32_t& _width, const uint32_t& _height, const uint32_t& _channels);
 		Texture(const TextureConfig& _cfg, const unsigned char* _data, const uint32_t& _width, const uint32_t& _height, const uint32_t& _channels);
+		/* Creates an empty GL_TEXTURE_2D_ARRAY, filled with set_layer() */
+		Texture(const TextureConfig& _cfg, const uint32_t& _width, const uint32_t& _height, const uint32_t& _layers, const uint32_t& _channels);
+		/*
+			Uploads levels, largest level first. Levels are pre-compressed when _cfg.FormatInternal is a block-compressed format,
+			otherwise pixels in _cfg.FormatTexture. Levels below _first_level are left empty for set_level().
+			A single uncompressed level gets its mipmaps generated when _cfg.MipmapGeneration is set.
+		*/
+		Texture(const TextureConfig& _cfg, const CompressedTextureLevel* _levels, const uint32_t& _level_count, const uint32_t& _first_level = 0U);
+		Texture(Texture&&) = default;
+		Texture& operator=(Texture&&) = default;
 		~Texture() override;
 	public:
 		void bind() const override;
 	public:
 		static void bind_default();
+		static void bind_default(const TextureTarget& _target);
+	public:
+		/* Mipmaps are not regenerated here. Call generate_pending_mipmap() before sampling. */
+		void set_layer(const uint32_t& _layer, const unsigned char* _data) const;
+		/* Regenerates the mip chain if set_layer() ran since the last call and _cfg.MipmapGeneration is set */
+		void generate_pending_mipmap() const;
+		/* Reads back a level the driver compressed, so it can be stored and re-uploaded without encoding */
+		bool read_compressed_level(const uint32_t& _level, std::vector<unsigned char>& _out, uint32_t& _out_width, uint32_t& _out_height, InternalFormat& _out_format) const;
+	public:
+		/* Uploads the level right below base_level() and makes it the new base level */
+		void set_level(const uint32_t& _level, const CompressedTextureLevel& _data);
+		/* Frees every level by recreating the GL texture. id() changes and base_level() becomes levels(). */
+		void release();
 	public:
 		const uint32_t& width() const;
 		const uint32_t& height() const;
+		const uint32_t& layers() const;
+		const uint32_t& levels() const;
+		const uint32_t& base_level() const;
 		const uint32_t& channels() const;
+		const TextureTarget& target() const;
+		const TextureConfig& config() const;
+	public:
+		/* True for block-compressed formats with a fixed encoding, not for the driver-chosen GL_COMPRESSED_* ones */
+		static bool is_compressed(const InternalFormat& _format);
+	private:
+		void _upload_level(const uint32_t& _level, const CompressedTextureLevel& _data) const;
+		static uint32_t _get_channel_count(const TextureFormat& _format);
 	};
 
 	class Shader final {
@@ -1119,7 +1561,16 @@ namespace glw {
 	public:
 		Shader() = delete;
 		Shader(const ShaderType& _type, const char* _src);
+		/* A deferred shader only submits its compile. Poll is_compile_complete(), then check_compile_status(). */
+		Shader(const ShaderType& _type, const char* _src, bool _deferred);
+		Shader(const Shader&) = delete;
+		Shader(Shader&& _other) noexcept;
+		Shader& operator=(const Shader&) = delete;
+		Shader& operator=(Shader&& _other) noexcept;
 		~Shader();
+	public:
+		bool is_compile_complete() const;
+		void check_compile_status() const;
 	public:
 		const uint32_t& id() const;
 		const ShaderType& type() const;
@@ -1128,27 +1579,46 @@ namespace glw {
 		static const char* type_to_str(const ShaderType& _type);
 	};
 
-	class Program final {
+	class Program {
 	private:
 		uint32_t m_ID = 0U;
 	private:
 		std::map<std::string_view, int> m_uniform_locations { };
 	public:
 		Program();
-		~Program();
+		Program(const Program&) = delete;
+		Program(Program&& _other) noexcept;
+		Program& operator=(const Program&) = delete;
+		Program& operator=(Program&& _other) noexcept;
+		virtual ~Program();
 	public:
 		void use() const;
 		static void use_default();
 	public:
 		void attach(const Shader* _shader) const;
+		void set_transform_feedback_varyings(const char* const* _varyings, uint32_t _count, TransformFeedbackBufferMode _mode = TransformFeedbackBufferMode::Interleaved) const;
 		void link() const;
+		/* Submits the link without waiting. Poll is_link_complete(), then check_link_status(). */
+		void link_deferred() const;
+		bool is_link_complete() const;
+		void check_link_status() const;
+	public:
+		/* Must be called before link() for get_binary() to work on every driver */
+		void set_binary_retrievable() const;
+		bool get_binary(std::vector<unsigned char>& _out, uint32_t& _out_format) const;
+		/* Replaces attach() and link(). False if the driver rejects the binary. */
+		bool load_binary(const void* _data, size_t _length, uint32_t _format) const;
 	public:
 		void register_uniform(const std::string_view& _name);
+		/* Registers every uniform _other has registered, e.g. on a rebuilt replacement */
+		void register_uniforms_from(const Program& _other);
 	public:
 		void set_sampler2D(const std::string_view& _name, int _slot_id) const;
 		void set_int(const std::string_view& _name, int _value) const;
 		void set_uint(const std::string_view& _name, uint32_t _value) const;
 		void set_float(const std::string_view& _name, float _value) const;
+		/* float[] uniform, registered by its bare name */
+		void set_floats(const std::string_view& _name, const float* _ptr, uint32_t _count) const;
 		void set_vec2(const std::string_view& _name, float _x, float _y) const;
 		void set_vec3(const std::string_view& _name, float _x, float _y, float _z) const;
 		void set_vec4(const std::string_view& _name, float _x, float _y, float _z, float _w) const;
@@ -1158,6 +1628,105 @@ namespace glw {
 	public:
 		const uint32_t& id() const;
 	};
+
+	class ComputeProgram final : public Program {
+	private:
+		uint32_t m_local_size[3] = { 1U, 1U, 1U };
+	public:
+		ComputeProgram() = delete;
+		ComputeProgram(const Shader* _shader);
+		ComputeProgram(ComputeProgram&&) = default;
+		ComputeProgram& operator=(ComputeProgram&&) = default;
+		~ComputeProgram() override;
+	public:
+		/* Uses the program, then dispatches. Reads of the results still need a memory_barrier(). */
+		void dispatch(uint32_t _group_x, uint32_t _group_y = 1U, uint32_t _group_z = 1U) const;
+		void dispatch_indirect(const ShaderStorageBufferObject* _args, intptr_t _offset = 0) const;
+	public:
+		const uint32_t* get_local_size() const;
+		uint32_t get_group_count(uint32_t _invocations, size_t _axis = 0ULL) const;
+	};
+
+	/*
+		On-disk cache of linked programs, keyed by everything the program was built from
+		(sources, transform feedback varyings ...) and the driver vendor, renderer and version.
+		Needs a current context.
+	*/
+	class ProgramBinaryCache final {
+	private:
+		std::filesystem::path m_directory { };
+		std::string m_driver { };
+		bool m_supported = false;
+	public:
+		ProgramBinaryCache() = delete;
+		ProgramBinaryCache(const std::string& _directory);
+		~ProgramBinaryCache();
+	public:
+		/* True if _program is now linked from the cache. Otherwise build it from source and store() it. */
+		bool load(const Program* _program, const std::vector<const char*>& _sources) const;
+		void store(const Program* _program, const std::vector<const char*>& _sources) const;
+	public:
+		const bool& supported() const;
+	private:
+		uint64_t _hash_sources(const std::vector<const char*>& _sources) const;
+		std::filesystem::path _get_path(uint64_t _source_hash) const;
+	};
+
+	struct FramePacerConfig {
+	public:
+		/* 0 leaves pacing to the swap interval */
+		double TargetFrameRate = 0.0;
+		/* Sleeping overshoots, so the last this many seconds before a deadline are spin-waited */
+		double SpinThreshold = 0.002;
+		/* Frames the CPU may submit before the GPU finishes the oldest. 0 disables the fences. */
+		uint32_t MaxFramesInFlight = 2U;
+	public:
+		int SwapInterval = 1;
+		/* Uses swap interval -1 instead of SwapInterval when the driver supports it */
+		bool AdaptiveVSync = false;
+	};
+
+	/*
+		Replaces Context::swap_buffers(). Bounds latency by limiting the frames in flight with fences,
+		holds a target frame rate with sleep then spin-wait, and measures present-to-present intervals.
+		Needs _target's context current, on the thread that presents.
+	*/
+	class FramePacer final {
+	private:
+		Window* m_target = nullptr;
+		FramePacerConfig m_config { };
+		bool m_adaptive_vsync_active = false;
+	private:
+		std::deque<GLsync> m_fences { };
+	private:
+		double m_next_deadline = 0.0;
+		double m_last_present_time = 0.0;
+		double m_last_frame_interval = 0.0;
+		double m_average_frame_interval = 0.0;
+		uint64_t m_frame_count = 0ULL;
+	public:
+		/* Weight of the newest interval in the average */
+		static constexpr double average_weight = 0.1;
+	public:
+		FramePacer() = delete;
+		FramePacer(Window* _target, const FramePacerConfig& _cfg = FramePacerConfig());
+		FramePacer(const FramePacer&) = delete;
+		FramePacer& operator=(const FramePacer&) = delete;
+		~FramePacer();
+	public:
+		/* Call where swap_buffers() was called, after the frame's draw calls */
+		void present();
+		void set_target_frame_rate(double _value);
+	public:
+		const FramePacerConfig& get_config() const;
+		const bool& get_adaptive_vsync_active() const;
+		/* Seconds between the last two presents */
+		const double& get_last_frame_interval() const;
+		const double& get_average_frame_interval() const;
+		const uint64_t& get_frame_count() const;
+	private:
+		void _wait_until(double _time) const;
+	};
 }
 
 #endif // !__GLW_HPP__
\ No newline at end of file
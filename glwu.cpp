@@ -1,801 +1,4639 @@
 #define STB_IMAGE_IMPLEMENTATION
 #include <glwu.hpp>
 
+/* Platform (file mapping) */
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+
 namespace glwu {
 
+	/* "GLWT" */
+	static constexpr uint32_t s_texture_cache_magic = 0x54574C47U;
+	static constexpr uint32_t s_texture_cache_version = 1U;
+
+	static constexpr const char* s_particle_update_varyings[] = { "oPosVel", "oState" };
+
 #pragma region vertex_shaders
-	static constexpr const char* s_sprite_vert =
+	static constexpr const char* s_quad_vert =
 		R"""(
-#version 330 core
+// #version and the permutation's #defines are prepended by Server::fetch_quad_program.
 layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec2 aTexCoord;
 
+#ifdef INSTANCED
+layout (location = 2) in vec4 iModel0;
+layout (location = 3) in vec4 iModel1;
+layout (location = 4) in vec4 iModel2;
+layout (location = 5) in vec4 iModel3;
+layout (location = 6) in vec4 iColor;
+layout (location = 7) in vec4 iOutlineColor;
+layout (location = 8) in vec4 iCornerRadii;
+layout (location = 9) in vec4 iSizeOutline;
+
+uniform mat4 uViewProj;
+
+out vec2 LocalPos;
+flat out vec2  HalfSize;
+flat out vec4  CornerRadii;
+flat out float OutlineWidth;
+flat out vec4  Color;
+flat out vec4  OutlineColor;
+#else
 uniform mat4 uMVP;
 uniform vec2 uSize;
+#endif
+
+#ifdef TEXTURED
+layout (location = 1) in vec2 aTexCoord;
 
 out vec2 TexCoord;
+#endif
 
 void main() {
-    vec4 pos = vec4(aPos, 1.0);
-    pos.x *= uSize.x;
-    pos.y *= uSize.y;
-    gl_Position = (uMVP * pos);
+#ifdef INSTANCED
+    vec2 size = iSizeOutline.xy;
+    // One unit of padding keeps the anti-aliased edge inside the quad.
+    LocalPos = aPos.xy * (size + vec2(2.0));
+    HalfSize = size * 0.5;
+    CornerRadii = clamp(iCornerRadii, 0.0, 1.0) * min(HalfSize.x, HalfSize.y);
+    OutlineWidth = iSizeOutline.z;
+    Color = iColor;
+    OutlineColor = iOutlineColor;
+    gl_Position = uViewProj * mat4(iModel0, iModel1, iModel2, iModel3) * vec4(LocalPos, 0.0, 1.0);
+#else
+    gl_Position = uMVP * vec4(aPos.xy * uSize, aPos.z, 1.0);
+#endif
+#ifdef TEXTURED
     TexCoord = aTexCoord;
+#endif
 }
 )""";
 	static constexpr const char* s_line_vert =
 		R"""(
 #version 330 core
-layout (location = 0) in vec3 aPos;
+layout (location = 0) in vec2 iPrev;
+layout (location = 1) in vec2 iBegin;
+layout (location = 2) in vec2 iEnd;
+layout (location = 3) in vec2 iNext;
+layout (location = 4) in vec4 iColor;
+layout (location = 5) in vec4 iStyle;
 
 uniform mat4 uMVP;
+uniform vec2 uViewportSize;
+uniform int  uStripSegmentCount;
+
+out vec2 SegmentCoord;
+flat out float SegmentLength;
+flat out float HalfWidth;
+flat out vec2  EndStyles;
+flat out vec4  Color;
+
+// iStyle    : (width, cap, join, pixel snapped)
+// EndStyles : 0 = joined, 1 = butt cap, 2 = square cap, 3 = round cap or join
+
+vec2 toScreen(vec2 p) {
+    vec4 clip = uMVP * vec4(p, 0.0, 1.0);
+    vec2 screen = (clip.xy / clip.w * 0.5 + 0.5) * uViewportSize;
+    return iStyle.w > 0.5 ? floor(screen) + 0.5 : screen;
+}
+
+float endStyle(bool isCap) {
+    return isCap ? iStyle.y + 1.0 : (iStyle.z > 0.5 ? 3.0 : 0.0);
+}
 
 void main() {
-	vec4 pos = vec4(aPos, 1.0);
-    gl_Position = uMVP * pos;
+    vec2 prevPoint = iPrev;
+    vec2 nextPoint = iNext;
+    // Strips read neighbours straight from the point array, so the outermost ones become caps here.
+    if (uStripSegmentCount > 0) {
+        prevPoint = (gl_InstanceID == 0) ? iBegin : iPrev;
+        nextPoint = (gl_InstanceID == uStripSegmentCount - 1) ? iEnd : iNext;
+    }
+
+    vec2 begin = toScreen(iBegin);
+    vec2 end = toScreen(iEnd);
+    vec2 prev = toScreen(prevPoint);
+    vec2 next = toScreen(nextPoint);
+
+    float len = length(end - begin);
+    vec2 dir = len > 1e-4 ? (end - begin) / len : vec2(1.0, 0.0);
+    vec2 normal = vec2(-dir.y, dir.x);
+
+    EndStyles = vec2(endStyle(distance(prev, begin) < 1e-4), endStyle(distance(next, end) < 1e-4));
+
+    float halfWidth = max(iStyle.x, 1.0) * 0.5;
+    float extent = halfWidth + 1.0;
+
+    bool atEnd = (gl_VertexID >> 1) == 1;
+    float side = (gl_VertexID & 1) == 0 ? -1.0 : 1.0;
+    float style = atEnd ? EndStyles.y : EndStyles.x;
+
+    vec2 offset = normal * side * extent;
+    if (style > 0.5) {
+        // Caps and round joins grow past the end point, the fragment shader trims them.
+        offset += dir * (atEnd ? 1.0 : -1.0) * (style < 1.5 ? 1.0 : extent);
+    }
+    else {
+        vec2 tangent = dir + normalize(atEnd ? next - end : begin - prev);
+        if (length(tangent) > 1e-3) {
+            vec2 miter = normalize(vec2(-tangent.y, tangent.x));
+            offset = miter * side * (extent / max(dot(miter, normal), 0.25));
+        }
+    }
+
+    vec2 screen = (atEnd ? end : begin) + offset;
+    SegmentCoord = vec2(dot(screen - begin, dir), dot(screen - begin, normal));
+    SegmentLength = len;
+    HalfWidth = halfWidth;
+    Color = vec4(iColor.rgb, iColor.a * min(iStyle.x, 1.0));
+    gl_Position = vec4(screen / uViewportSize * 2.0 - 1.0, 0.0, 1.0);
 }
 )""";
-	static constexpr const char* s_rect_vert =
-		R""""(
-#version 330
-
+	static constexpr const char* s_layered_sprite_vert =
+		R"""(
+#version 330 core
 layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec2 aTexCoord;
+layout (location = 2) in vec4 iModel0;
+layout (location = 3) in vec4 iModel1;
+layout (location = 4) in vec4 iModel2;
+layout (location = 5) in vec4 iModel3;
+layout (location = 6) in vec4 iModulate;
+layout (location = 7) in vec4 iSizeLayer;
 
-uniform mat4 uMVP;
-uniform vec2 uSize;
+uniform mat4 uViewProj;
+
+out vec2 TexCoord;
+out vec4 Modulate;
+flat out float Layer;
 
 void main() {
-	vec4 pos = vec4(aPos, 1.0);
-	pos.x *= uSize.x;
-	pos.y *= uSize.y;
-	gl_Position = uMVP * pos;
+    vec4 pos = vec4(aPos.xy * iSizeLayer.xy, aPos.z, 1.0);
+    gl_Position = uViewProj * mat4(iModel0, iModel1, iModel2, iModel3) * pos;
+    TexCoord = aTexCoord;
+    Modulate = iModulate;
+    Layer = iSizeLayer.z;
 }
-)"""";
-	static constexpr const char* s_lined_rect_vert =
-		R""""(
-#version 330
-
+)""";
+	static constexpr const char* s_rect_batch_vert =
+		R"""(
+#version 330 core
 layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec4 iRect;
+layout (location = 2) in vec4 iColor;
 
 uniform mat4 uMVP;
-uniform vec2 uSize;
+uniform vec4 uModulate;
+
+out vec4 Color;
 
 void main() {
-	vec4 pos = vec4(aPos, 1.0);
-	pos.x = floor(pos.x * uSize.x) + 0.5;
-	pos.y = floor(pos.y * uSize.y) + 0.5;
-	gl_Position = uMVP * pos;
+    vec2 pos = vec2(iRect.x, -iRect.y) + aPos.xy * iRect.zw;
+    gl_Position = uMVP * vec4(pos, 0.0, 1.0);
+    Color = iColor * uModulate;
 }
-)"""";
-#pragma endregion
-
-#pragma region fragment_shaders
-	static constexpr const char* s_sprite_frag =
+)""";
+	static constexpr const char* s_particle_update_vert =
 		R"""(
 #version 330 core
+layout (location = 0) in vec4 aPosVel;
+layout (location = 1) in vec4 aState;
+
+uniform float uDeltaTime;
+uniform uint  uSeed;
+uniform int   uCapacity;
+uniform int   uEmitBegin;
+uniform int   uEmitCount;
+uniform vec2  uEmitterPosition;
+uniform float uEmitterRadius;
+uniform float uDirection;
+uniform float uSpread;
+uniform vec2  uSpeedRange;
+uniform vec2  uLifetimeRange;
+uniform vec2  uAcceleration;
+uniform float uDamping;
+
+out vec4 oPosVel;
+out vec4 oState;
+
+uint hash(uint x) {
+    x ^= x >> 16;
+    x *= 0x7feb352dU;
+    x ^= x >> 15;
+    x *= 0x846ca68bU;
+    x ^= x >> 16;
+    return x;
+}
 
-in vec2 TexCoord;
+float random(inout uint state) {
+    state = hash(state);
+    return float(state) / 4294967295.0;
+}
 
-uniform sampler2D uTexture;
+void main() {
+    int slot = gl_VertexID;
+    if ((slot - uEmitBegin + uCapacity) % uCapacity < uEmitCount) {
+        uint state = hash(uint(slot) ^ hash(uSeed));
+        float angle = uDirection + (random(state) - 0.5) * uSpread;
+        float speed = mix(uSpeedRange.x, uSpeedRange.y, random(state));
+        float lifetime = mix(uLifetimeRange.x, uLifetimeRange.y, random(state));
+        float offsetAngle = random(state) * 6.28318530718;
+        float offsetLength = sqrt(random(state)) * uEmitterRadius;
+        vec2 pos = uEmitterPosition + vec2(cos(offsetAngle), sin(offsetAngle)) * offsetLength;
+        oPosVel = vec4(pos, vec2(cos(angle), sin(angle)) * speed);
+        oState = vec4(0.0, lifetime, random(state), 0.0);
+        return;
+    }
+
+    vec2 pos = aPosVel.xy;
+    vec2 vel = aPosVel.zw;
+    if (aState.x < aState.y) {
+        vel = (vel + uAcceleration * uDeltaTime) * max(1.0 - uDamping * uDeltaTime, 0.0);
+        pos += vel * uDeltaTime;
+    }
+    oPosVel = vec4(pos, vel);
+    oState = vec4(aState.x + uDeltaTime, aState.yzw);
+}
+)""";
+	static constexpr const char* s_particle_vert =
+		R"""(
+#version 330 core
+layout (location = 0) in vec4 iPosVel;
+layout (location = 1) in vec4 iState;
+
+uniform mat4 uViewProj;
+uniform vec4 uStartColor;
+uniform vec4 uEndColor;
+uniform vec2 uSizeRange;
 uniform vec4 uModulate;
-out vec4 FragColor;
+
+out vec2 Corner;
+out vec4 Color;
 
 void main() {
-    FragColor = texture(uTexture, TexCoord) * uModulate;
+    Corner = vec2((gl_VertexID & 1) == 0 ? -1.0 : 1.0, (gl_VertexID & 2) == 0 ? -1.0 : 1.0);
+    float t = clamp(iState.x / max(iState.y, 1e-4), 0.0, 1.0);
+    // Dead particles collapse to a degenerate quad and are dropped before rasterization.
+    float size = (iState.x < iState.y) ? mix(uSizeRange.x, uSizeRange.y, t) : 0.0;
+    vec2 pos = iPosVel.xy + Corner * size * 0.5;
+    gl_Position = uViewProj * vec4(pos.x, -pos.y, 0.0, 1.0);
+    Color = mix(uStartColor, uEndColor, t) * uModulate;
 }
 )""";
-	static constexpr const char* s_blended_sprite_frag =
+	static constexpr const char* s_post_process_vert =
 		R"""(
 #version 330 core
+out vec2 TexCoord;
+
+void main() {
+    // One triangle covering the viewport, built from gl_VertexID without any vertex buffer.
+    vec2 pos = vec2(float((gl_VertexID << 1) & 2), float(gl_VertexID & 2));
+    TexCoord = pos;
+    gl_Position = vec4(pos * 2.0 - 1.0, 0.0, 1.0);
+}
+)""";
+#pragma endregion
+
+#pragma region fragment_shaders
+	static constexpr const char* s_quad_frag =
+		R"""(
+// #version and the permutation's #defines are prepended by Server::fetch_quad_program.
+#ifdef INSTANCED
+in vec2 LocalPos;
+flat in vec2  HalfSize;
+flat in vec4  CornerRadii;
+flat in float OutlineWidth;
+flat in vec4  Color;
+flat in vec4  OutlineColor;
+#else
+uniform vec4 uModulate;
+#ifndef TEXTURED
+uniform vec4 uColor;
+#endif
+#endif
 
-#define MAX_TEXTURE_COUNT 4
+#ifdef SHADOW
+uniform sampler2D uTexture;
+// (border, size) of the mask in world units. Between the borders the mask is constant.
+uniform vec2 uShadowSlice;
+
+// Each axis samples the slice of its nearer edge, so quads narrower than two borders still fade out on both sides.
+vec2 sliceCoord(vec2 p, vec2 size) {
+    vec2 fromFar = size - p;
+    vec2 q = mix(uShadowSlice.y - fromFar, p, step(p, fromFar));
+    q = mix(q, vec2(uShadowSlice.y * 0.5), step(vec2(uShadowSlice.x), min(p, fromFar)));
+    return q / uShadowSlice.y;
+}
+#endif
 
+#ifdef TEXTURED
 in vec2 TexCoord;
 
-uniform int uTextureCount;
-uniform sampler2D uTextures[MAX_TEXTURE_COUNT];
-uniform vec4 uModulate;
+#ifdef TEXTURE_COUNT
+uniform sampler2D uTextures[TEXTURE_COUNT];
+#else
+uniform sampler2D uTexture;
+#endif
+#endif
+
 out vec4 FragColor;
 
+#ifdef INSTANCED
+// Radii are ordered as (top-right, bottom-right, top-left, bottom-left).
+float sdBox(vec2 p, vec2 b) {
+#ifdef ROUNDED
+    vec4 r = CornerRadii;
+    r.xy = (p.x > 0.0) ? r.xy : r.zw;
+    r.x  = (p.y > 0.0) ? r.x  : r.y;
+    vec2 q = abs(p) - b + r.x;
+    return min(max(q.x, q.y), 0.0) + length(max(q, 0.0)) - r.x;
+#else
+    vec2 q = abs(p) - b;
+    return min(max(q.x, q.y), 0.0) + length(max(q, 0.0));
+#endif
+}
+#endif
+
 void main() {
-    vec4 _outColor = vec4(1, 1, 1, 0);
-    for (int i = 0; i < min(MAX_TEXTURE_COUNT, uTextureCount); i++) {
+#if defined(TEXTURE_COUNT)
+    // The bound is a constant, so the loop unrolls and the sampler indices are constant expressions.
+    vec4 color = vec4(1, 1, 1, 0);
+    for (int i = 0; i < TEXTURE_COUNT; i++) {
         vec4 texColor = texture(uTextures[i], TexCoord);
-        if (_outColor.a < 1.0) {
-            _outColor = mix(_outColor, texColor, texColor.a);
+        if (color.a < 1.0) {
+            color = mix(color, texColor, texColor.a);
         }
     }
-    FragColor = _outColor * uModulate;
+#elif defined(TEXTURED)
+    vec4 color = texture(uTexture, TexCoord);
+#else
+    vec4 color = vec4(1.0);
+#endif
+
+#if defined(SHADOW)
+    FragColor = vec4(Color.rgb, Color.a * texture(uTexture, sliceCoord(LocalPos + HalfSize, 2.0 * HalfSize)).r);
+#elif defined(INSTANCED)
+    float dist = sdBox(LocalPos, HalfSize);
+    float aa = max(fwidth(dist), 1e-4) * 0.5;
+    float fill = 1.0 - smoothstep(-aa, aa, dist);
+#ifdef OUTLINED
+    float inner = 1.0 - smoothstep(-aa, aa, dist + OutlineWidth);
+    vec4 shape = mix(OutlineColor, Color, inner);
+#else
+    vec4 shape = Color;
+#endif
+    FragColor = color * vec4(shape.rgb, shape.a * fill);
+#else
+#ifndef TEXTURED
+    color *= uColor;
+#endif
+    FragColor = color * uModulate;
+#endif
 }
 )""";
-	static constexpr const char* s_simple_frag =
+	static constexpr const char* s_line_frag =
 		R""""(
 #version 330 core
 
-uniform vec4 uColor;
-uniform vec4 uModulate;
+in vec2 SegmentCoord;
+flat in float SegmentLength;
+flat in float HalfWidth;
+flat in vec2  EndStyles;
+flat in vec4  Color;
 
 out vec4 FragColor;
 
+float edgeDistance(float past, float across, float style) {
+    float body = abs(across) - HalfWidth;
+    if (style < 0.5) { return body; }
+    if (style < 1.5) { return max(body, past); }
+    if (style < 2.5) { return max(body, past - HalfWidth); }
+    return length(vec2(past, across)) - HalfWidth;
+}
+
 void main() {
-    FragColor = uColor * uModulate;
+    float dist = abs(SegmentCoord.y) - HalfWidth;
+    if (SegmentCoord.x < 0.0) {
+        dist = edgeDistance(-SegmentCoord.x, SegmentCoord.y, EndStyles.x);
+    }
+    else if (SegmentCoord.x > SegmentLength) {
+        dist = edgeDistance(SegmentCoord.x - SegmentLength, SegmentCoord.y, EndStyles.y);
+    }
+    FragColor = vec4(Color.rgb, Color.a * clamp(0.5 - dist, 0.0, 1.0));
 }
 )"""";
-	static constexpr const char* s_rounded_rect_frag =
-		R""""(
+	static constexpr const char* s_particle_frag =
+		R"""(
 #version 330 core
+in vec2 Corner;
+in vec4 Color;
+
+out vec4 FragColor;
 
+void main() {
+    float dist = length(Corner);
+    float aa = max(fwidth(dist), 1e-4);
+    float alpha = 1.0 - smoothstep(1.0 - aa, 1.0, dist);
+    FragColor = vec4(Color.rgb, Color.a * alpha);
+}
+)""";
+	static constexpr const char* s_layered_sprite_frag =
+		R"""(
+#version 330 core
 in vec2 TexCoord;
+in vec4 Modulate;
+flat in float Layer;
 
-uniform vec4  uColor;
-uniform vec4  uModulate;
-uniform vec2  uSize;
-uniform float uCornerRadius;
-uniform float uOutlineWidth;
-uniform vec4  uOutlineColor;
+uniform sampler2DArray uTextures;
 
 out vec4 FragColor;
 
 void main() {
-    vec2 normalizedCoord = TexCoord * uSize;
-    float radius = uCornerRadius * min(uSize.x, uSize.y) * 0.5;
-    vec2 dist = normalizedCoord - vec2(radius, radius);
-    vec2 size = uSize - vec2(radius * 2.0, radius * 2.0);
-
-    bool isInside = 
-        (dist.x < size.x && dist.y < size.y) || 
-            (normalizedCoord.x <= radius ||
-             normalizedCoord.y <= radius || 
-             normalizedCoord.x >= (uSize.x - radius) || 
-             normalizedCoord.y >= (uSize.y - radius)
-            );
-    bool isOutline = (
-            normalizedCoord.x >= (uSize.x - (1.0 + uOutlineWidth)) && (normalizedCoord.y >= radius && normalizedCoord.y <= uSize.y - radius) ||
-            normalizedCoord.x <= (1.0 + uOutlineWidth) && (normalizedCoord.y >= radius && normalizedCoord.y <= uSize.y - radius) || 
-            normalizedCoord.y >= (uSize.y - (1.0 + uOutlineWidth)) && (normalizedCoord.x >= radius && normalizedCoord.x <= uSize.x - radius) ||
-            normalizedCoord.y <= (1.0 + uOutlineWidth) && (normalizedCoord.x >= radius && normalizedCoord.x <= uSize.x - radius)
-        );
-
-
-    if (isInside) {
-        float least = max(1.0, uOutlineWidth);
-        if (normalizedCoord.x < radius && normalizedCoord.y < radius) {
-            if (normalizedCoord.x < (radius - uOutlineWidth) + least && normalizedCoord.y < (radius - uOutlineWidth) + least) {
-                float distCorner = length(normalizedCoord - vec2(radius, radius));
-                if (distCorner > (radius - uOutlineWidth - 1.0) && distCorner < radius) {
-                    isOutline = true;
-                }
-                else {
-                    isInside = bool(distCorner < radius);
-                }
-            }
-            else {
-                float distCorner = length(normalizedCoord - vec2(radius, radius));
-                if (distCorner > radius) {
-                    isInside = false;
-                }
-            }
-        }
-        if (normalizedCoord.x > uSize.x - radius && normalizedCoord.y < radius) {
-            if (normalizedCoord.x > uSize.x - (radius - uOutlineWidth) - least && normalizedCoord.y < (radius - uOutlineWidth) + least) {
-                float distCorner = length(normalizedCoord - vec2(uSize.x - radius, radius));
-                if (distCorner > (radius - uOutlineWidth - 1.0) && distCorner < radius) {
-                    isOutline = true;
-                }
-                else {
-                    isInside = bool(distCorner < radius);
-                }
-            }
-            else {
-                float distCorner = length(normalizedCoord - vec2(uSize.x - radius, radius));
-                if (distCorner > radius) {
-                    isInside = false;
-                }
-            }
-        }
-        if (normalizedCoord.x > uSize.x - radius && normalizedCoord.y > uSize.y - radius) {
-            if (normalizedCoord.x > uSize.x - (radius - uOutlineWidth) - least && normalizedCoord.y > uSize.y - (radius - uOutlineWidth) - least) {
-                float distCorner = length(normalizedCoord - vec2(uSize.x - radius, uSize.y - radius));
-                if (distCorner > (radius - uOutlineWidth - 1.0) && distCorner < radius) {
-                    isOutline = true;
-                }
-                else {
-                    isInside = bool(distCorner < radius);
-                }
-            }
-            else {
-                float distCorner = length(normalizedCoord - vec2(uSize.x - radius, uSize.y - radius));
-                if (distCorner > radius) {
-                    isInside = false;
-                }
-            }
-        }
-        if (normalizedCoord.x < radius && normalizedCoord.y > uSize.y - radius) {
-            if (normalizedCoord.x < (radius - uOutlineWidth) + least && normalizedCoord.y > uSize.y - (radius - uOutlineWidth) - least) {
-                float distCorner = length(normalizedCoord - vec2(radius, uSize.y - radius));
-                if (distCorner > (radius - uOutlineWidth - 1.0) && distCorner < radius) {
-                    isOutline = true;
-                }
-                else {
-                    isInside = bool(distCorner < radius);
-                }
-            }
-            else {
-                float distCorner = length(normalizedCoord - vec2(radius, uSize.y - radius));
-                if (distCorner > radius) {
-                    isInside = false;
-                }
-            }
-        }
-        FragColor = isOutline ? uOutlineColor * uModulate : (isInside ? uColor * uModulate : vec4(0.0, 0.0, 0.0, 0.0));
-    } else {
-        FragColor = vec4(0.0, 0.0, 0.0, 0.0);
+    FragColor = texture(uTextures, vec3(TexCoord, Layer)) * Modulate;
+}
+)""";
+	static constexpr const char* s_vertex_color_frag =
+		R"""(
+#version 330 core
+in vec4 Color;
+
+out vec4 FragColor;
+
+void main() {
+    FragColor = Color;
+}
+)""";
+	static constexpr const char* s_downsample_frag =
+		R"""(
+#version 330 core
+in vec2 TexCoord;
+
+uniform sampler2D uTexture;
+uniform vec2 uTexelSize;
+uniform float uThreshold;
+
+out vec4 FragColor;
+
+void main() {
+    // Four bilinear taps one source texel off the center average a 4x4 block.
+    vec4 color = texture(uTexture, TexCoord + uTexelSize * vec2(-1.0, -1.0));
+    color += texture(uTexture, TexCoord + uTexelSize * vec2(1.0, -1.0));
+    color += texture(uTexture, TexCoord + uTexelSize * vec2(-1.0, 1.0));
+    color += texture(uTexture, TexCoord + uTexelSize * vec2(1.0, 1.0));
+    color *= 0.25;
+    if (uThreshold > 0.0) {
+        float brightness = max(color.r, max(color.g, color.b));
+        color.rgb *= max(brightness - uThreshold, 0.0) / max(brightness, 1e-4);
     }
+    FragColor = color;
 }
-)"""";
-#pragma endregion
+)""";
+	static constexpr const char* s_blur_frag =
+		R"""(
+#version 330 core
+in vec2 TexCoord;
 
-	Server::Server(uint32_t _initial_window_width, uint32_t _initial_window_height)
-		: m_initial_window_width(_initial_window_width),
-		m_initial_window_height(_initial_window_height)
-	{
-		glw::BufferData _rect_vertices; {
-			_rect_vertices.add_float(0.5f);
-			_rect_vertices.add_float(0.5f);
-			_rect_vertices.add_float(0.0f);
+uniform sampler2D uTexture;
+uniform vec2 uDirection;
+uniform int uTapCount;
+uniform float uOffsets[16];
+uniform float uWeights[16];
 
-			_rect_vertices.add_float(0.5f);
-			_rect_vertices.add_float(-0.5f);
-			_rect_vertices.add_float(0.0f);
+out vec4 FragColor;
 
-			_rect_vertices.add_float(-0.5f);
-			_rect_vertices.add_float(-0.5f);
-			_rect_vertices.add_float(0.0f);
+void main() {
+    // Every tap but the center sits between two texels, so bilinear filtering fetches both at their combined weight.
+    vec4 color = texture(uTexture, TexCoord) * uWeights[0];
+    for (int i = 1; i < uTapCount; i++) {
+        vec2 offset = uDirection * uOffsets[i];
+        color += (texture(uTexture, TexCoord + offset) + texture(uTexture, TexCoord - offset)) * uWeights[i];
+    }
+    FragColor = color;
+}
+)""";
+	static constexpr const char* s_upsample_frag =
+		R"""(
+#version 330 core
+in vec2 TexCoord;
 
-			_rect_vertices.add_float(-0.5f);
-			_rect_vertices.add_float(0.5f);
-			_rect_vertices.add_float(0.0f);
-		}
-		glw::BufferData _rect_indices; {
-			_rect_indices.add_uint32(0);
-			_rect_indices.add_uint32(1);
-			_rect_indices.add_uint32(3);
+uniform sampler2D uTexture;
+uniform vec2 uTexelSize;
+uniform float uIntensity;
 
-			_rect_indices.add_uint32(1);
-			_rect_indices.add_uint32(2);
-			_rect_indices.add_uint32(3);
-		}
+out vec4 FragColor;
 
-		glw::BufferData _linedrect_vertices; {
-			_linedrect_vertices.add_float(-0.5f);
-			_linedrect_vertices.add_float(0.5f);
-			_linedrect_vertices.add_float(0.0f);
+void main() {
+    // Tent filter over the smaller level. Additive blending puts it on top of the larger one.
+    vec4 color = texture(uTexture, TexCoord + uTexelSize * vec2(-0.5, -0.5));
+    color += texture(uTexture, TexCoord + uTexelSize * vec2(0.5, -0.5));
+    color += texture(uTexture, TexCoord + uTexelSize * vec2(-0.5, 0.5));
+    color += texture(uTexture, TexCoord + uTexelSize * vec2(0.5, 0.5));
+    FragColor = color * 0.25 * uIntensity;
+}
+)""";
+	static constexpr const char* s_composite_frag =
+		R"""(
+#version 330 core
+in vec2 TexCoord;
 
-			_linedrect_vertices.add_float(0.5f);
-			_linedrect_vertices.add_float(0.5f);
-			_linedrect_vertices.add_float(0.0f);
+uniform sampler2D uTexture;
+uniform sampler2D uBloom;
+uniform float uIntensity;
 
-			_linedrect_vertices.add_float(0.5f);
-			_linedrect_vertices.add_float(-0.5f);
-			_linedrect_vertices.add_float(0.0f);
+out vec4 FragColor;
 
-			_linedrect_vertices.add_float(-0.5f);
-			_linedrect_vertices.add_float(-0.5f);
-			_linedrect_vertices.add_float(0.0f);
-		}
+void main() {
+    vec4 color = texture(uTexture, TexCoord);
+    FragColor = vec4(color.rgb + texture(uBloom, TexCoord).rgb * uIntensity, color.a);
+}
+)""";
+	static constexpr const char* s_rounded_mask_frag =
+		R"""(
+#version 330 core
+uniform vec2 uCenter;
+uniform vec2 uHalfSize;
+uniform float uRadius;
 
-		glw::BufferData _linedrect_indices; {
-			_linedrect_indices.add_uint32(0);
-			_linedrect_indices.add_uint32(1);
+out vec4 FragColor;
 
-			_linedrect_indices.add_uint32(1);
-			_linedrect_indices.add_uint32(2);
+void main() {
+    vec2 q = abs(gl_FragCoord.xy - uCenter) - uHalfSize + uRadius;
+    float dist = min(max(q.x, q.y), 0.0) + length(max(q, 0.0)) - uRadius;
+    FragColor = vec4(clamp(0.5 - dist, 0.0, 1.0));
+}
+)""";
+#pragma endregion
 
-			_linedrect_indices.add_uint32(2);
-			_linedrect_indices.add_uint32(3);
+#pragma region compute_shaders
+	static constexpr const char* s_rect_batch_cull_comp =
+		R"""(
+#version 430 core
+layout (local_size_x = 64) in;
 
-			_linedrect_indices.add_uint32(3);
-			_linedrect_indices.add_uint32(0);
-		}
+struct Group {
+    vec4 bounds;
+    uvec4 range;
+};
 
-		glw::BufferData _sprite_vertices; {
-			_sprite_vertices.add_float(0.5f);
-			_sprite_vertices.add_float(0.5f);
-			_sprite_vertices.add_float(0.0f);
-			_sprite_vertices.add_float(1.0f);
-			_sprite_vertices.add_float(1.0f);
+struct Command {
+    uint count;
+    uint instanceCount;
+    uint firstIndex;
+    int  baseVertex;
+    uint baseInstance;
+};
 
-			_sprite_vertices.add_float(0.5f);
-			_sprite_vertices.add_float(-0.5f);
-			_sprite_vertices.add_float(0.0f);
-			_sprite_vertices.add_float(1.0f);
-			_sprite_vertices.add_float(0.0f);
+layout (std430, binding = 0) readonly buffer Groups { Group groups[]; };
+layout (std430, binding = 1) writeonly buffer Commands { Command commands[]; };
 
-			_sprite_vertices.add_float(-0.5f);
-			_sprite_vertices.add_float(-0.5f);
-			_sprite_vertices.add_float(0.0f);
-			_sprite_vertices.add_float(0.0f);
-			_sprite_vertices.add_float(0.0f);
+uniform mat4 uMVP;
+uniform uint uGroupCount;
 
-			_sprite_vertices.add_float(-0.5f);
-			_sprite_vertices.add_float(0.5f);
-			_sprite_vertices.add_float(0.0f);
-			_sprite_vertices.add_float(0.0f);
-			_sprite_vertices.add_float(1.0f);
-		}
-		glw::BufferData _sprite_indices; {
-			_sprite_indices.add_uint32(0);
-			_sprite_indices.add_uint32(1);
-			_sprite_indices.add_uint32(3);
+void main() {
+    uint i = gl_GlobalInvocationID.x;
+    if (i >= uGroupCount) {
+        return;
+    }
+    Group group = groups[i];
+    vec2 lo = vec2(1e30);
+    vec2 hi = vec2(-1e30);
+    for (int c = 0; c < 4; c++) {
+        vec2 corner = vec2((c & 1) == 0 ? group.bounds.x : group.bounds.z, (c & 2) == 0 ? -group.bounds.y : -group.bounds.w);
+        vec4 clip = uMVP * vec4(corner, 0.0, 1.0);
+        lo = min(lo, clip.xy / clip.w);
+        hi = max(hi, clip.xy / clip.w);
+    }
+    bool visible = all(lessThanEqual(lo, vec2(1.0))) && all(greaterThanEqual(hi, vec2(-1.0)));
+    commands[i] = Command(6u, visible ? group.range.x : 0u, 0u, 0, group.range.y);
+}
+)""";
+#pragma endregion
 
-			_sprite_indices.add_uint32(1);
-			_sprite_indices.add_uint32(2);
-			_sprite_indices.add_uint32(3);
+	AssetPack::AssetPack(const std::string& _path) : m_path(_path) {
+#ifdef _WIN32
+		HANDLE _file = CreateFileA(_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+		if (_file == INVALID_HANDLE_VALUE) {
+			throw exception::AssetPackLoadingFailure(_path, "Cannot open file");
 		}
-
-		glw::BufferData _line_indices; {
-			_line_indices.add_uint32(0);
-			_line_indices.add_uint32(1);
+		m_file_handle = _file;
+		LARGE_INTEGER _size { };
+		if (GetFileSizeEx(_file, &_size) == FALSE || _size.QuadPart == 0) {
+			this->_unmap();
+			throw exception::AssetPackLoadingFailure(_path, "Empty file");
+		}
+		m_length = static_cast<size_t>(_size.QuadPart);
+		m_mapping_handle = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (m_mapping_handle == nullptr) {
+			this->_unmap();
+			throw exception::AssetPackLoadingFailure(_path, "CreateFileMapping failed");
+		}
+		m_data = static_cast<const unsigned char*>(MapViewOfFile(m_mapping_handle, FILE_MAP_READ, 0, 0, 0));
+		if (m_data == nullptr) {
+			this->_unmap();
+			throw exception::AssetPackLoadingFailure(_path, "MapViewOfFile failed");
+		}
+#else
+		m_file_descriptor = open(_path.c_str(), O_RDONLY);
+		if (m_file_descriptor < 0) {
+			throw exception::AssetPackLoadingFailure(_path, "Cannot open file");
 		}
+		struct stat _stat { };
+		if (fstat(m_file_descriptor, &_stat) != 0 || _stat.st_size == 0) {
+			this->_unmap();
+			throw exception::AssetPackLoadingFailure(_path, "Empty file");
+		}
+		m_length = static_cast<size_t>(_stat.st_size);
+		void* _mapping = mmap(nullptr, m_length, PROT_READ, MAP_PRIVATE, m_file_descriptor, 0);
+		if (_mapping == MAP_FAILED) {
+			this->_unmap();
+			throw exception::AssetPackLoadingFailure(_path, "mmap failed");
+		}
+		m_data = static_cast<const unsigned char*>(_mapping);
+#endif
 
+		if (m_length < sizeof(AssetPackHeader)) {
+			this->_unmap();
+			throw exception::AssetPackLoadingFailure(_path, "Truncated header");
+		}
+		const AssetPackHeader* _header = reinterpret_cast<const AssetPackHeader*>(m_data);
+		if (_header->Magic != AssetPackMagic || _header->Version != AssetPackVersion) {
+			this->_unmap();
+			throw exception::AssetPackLoadingFailure(_path, "Not an asset pack or unsupported version");
+		}
+		const uint64_t _names_offset = sizeof(AssetPackHeader) + static_cast<uint64_t>(_header->EntryCount) * sizeof(AssetPackEntry);
+		if (_names_offset + _header->NameTableLength > m_length) {
+			this->_unmap();
+			throw exception::AssetPackLoadingFailure(_path, "Truncated index");
+		}
+		const AssetPackEntry* _entries = reinterpret_cast<const AssetPackEntry*>(m_data + sizeof(AssetPackHeader));
+		const char* _names = reinterpret_cast<const char*>(m_data + _names_offset);
+		for (uint32_t i = 0; i < _header->EntryCount; i++) {
+			const AssetPackEntry& _entry = _entries[i];
+			const uint64_t _expected_length = static_cast<uint64_t>(_entry.Width) * _entry.Height * _entry.Channels;
+			if (static_cast<uint64_t>(_entry.NameOffset) + _entry.NameLength > _header->NameTableLength ||
+				_entry.DataOffset > m_length || _entry.DataLength > m_length - _entry.DataOffset ||
+				_entry.DataLength < _expected_length) {
+				this->_unmap();
+				throw exception::AssetPackLoadingFailure(_path, "Entry " + std::to_string(i) + " is out of bounds");
+			}
+			m_entry_map[std::string_view(_names + _entry.NameOffset, _entry.NameLength)] = &_entry;
+		}
 
+#ifndef _WIN32
+		/* The whole pack is read at startup anyway; let the kernel start paging it in. */
+		madvise(const_cast<unsigned char*>(m_data), m_length, MADV_WILLNEED);
+#endif
+	}
 
-		glw::VertexArrayObject* _rectVAO = new glw::VertexArrayObject();
-		glw::VertexBufferObject* _rectVBO = new glw::VertexBufferObject();
-		glw::ElementBufferObject* _rectEBO = new glw::ElementBufferObject();
+	AssetPack::~AssetPack() {
+		this->_unmap();
+	}
 
-		_rectVAO->bind();
-		{
-			_rectVBO->bind();
-			_rectVBO->bind_data(_rect_vertices, glw::BufferUsage::StaticDraw);
-			_rectEBO->bind();
-			_rectEBO->bind_data(_rect_indices, glw::BufferUsage::StaticDraw);
-			_rectVAO->attrib_pointer(0, 3, glw::NumericType::Float, sizeof(float) * 3, 0);
-			_rectVAO->attrib_pointer(1, 2, glw::NumericType::Float, sizeof(float) * 3, sizeof(float) * 3);
-		}
-		glw::VertexArrayObject::bind_default();
-		glw::VertexBufferObject::bind_default();
-		glw::ElementBufferObject::bind_default();
+	const AssetPackEntry* AssetPack::find(const std::string_view& _name) const {
+		auto _it = m_entry_map.find(_name);
+		return (_it == m_entry_map.end()) ? nullptr : _it->second;
+	}
 
-		glw::VertexArrayObject* _linedrectVAO = new glw::VertexArrayObject();
-		glw::VertexBufferObject* _linedrectVBO = new glw::VertexBufferObject();
-		glw::ElementBufferObject* _linedrectEBO = new glw::ElementBufferObject();
+	const unsigned char* AssetPack::get_data(const AssetPackEntry* _entry) const {
+		return m_data + _entry->DataOffset;
+	}
 
-		_linedrectVAO->bind();
-		{
-			_linedrectVBO->bind();
-			_linedrectVBO->bind_data(_linedrect_vertices, glw::BufferUsage::StaticDraw);
-			_linedrectEBO->bind();
-			_linedrectEBO->bind_data(_linedrect_indices, glw::BufferUsage::StaticDraw);
-			_linedrectVAO->attrib_pointer(0, 3, glw::NumericType::Float, sizeof(float) * 3, 0);
-		}
-		glw::VertexArrayObject::bind_default();
-		glw::VertexBufferObject::bind_default();
-		glw::ElementBufferObject::bind_default();
+	const std::string& AssetPack::path() const {
+		return m_path;
+	}
 
-		glw::VertexArrayObject* _spriteVAO = new glw::VertexArrayObject();
-		glw::VertexBufferObject* _spriteVBO = new glw::VertexBufferObject();
-		glw::ElementBufferObject* _spriteEBO = new glw::ElementBufferObject();
+	size_t AssetPack::entry_count() const {
+		return m_entry_map.size();
+	}
 
-		_spriteVAO->bind();
-		{
-			_spriteVBO->bind();
-			_spriteVBO->bind_data(_sprite_vertices, glw::BufferUsage::StaticDraw);
-			_spriteEBO->bind();
-			_spriteEBO->bind_data(_sprite_indices, glw::BufferUsage::StaticDraw);
-			_spriteVAO->attrib_pointer(0, 3, glw::NumericType::Float, sizeof(float) * 3 + sizeof(float) * 2, 0);
-			_spriteVAO->attrib_pointer(1, 2, glw::NumericType::Float, sizeof(float) * 3 + sizeof(float) * 2, sizeof(float) * 3);
+	void AssetPack::_unmap() {
+		m_entry_map.clear();
+#ifdef _WIN32
+		if (m_data != nullptr) {
+			UnmapViewOfFile(m_data);
 		}
-		glw::VertexArrayObject::bind_default();
-		glw::VertexBufferObject::bind_default();
-		glw::ElementBufferObject::bind_default();
+		if (m_mapping_handle != nullptr) {
+			CloseHandle(m_mapping_handle);
+		}
+		if (m_file_handle != nullptr) {
+			CloseHandle(m_file_handle);
+		}
+		m_mapping_handle = nullptr;
+		m_file_handle = nullptr;
+#else
+		if (m_data != nullptr) {
+			munmap(const_cast<unsigned char*>(m_data), m_length);
+		}
+		if (m_file_descriptor >= 0) {
+			close(m_file_descriptor);
+		}
+		m_file_descriptor = -1;
+#endif
+		m_data = nullptr;
+		m_length = 0U;
+	}
 
-		glw::VertexArrayObject* _lineVAO = new glw::VertexArrayObject();
-		glw::VertexBufferObject* _lineVBO = new glw::VertexBufferObject();
-		glw::ElementBufferObject* _lineEBO = new glw::ElementBufferObject();
+	ShaderRegistry::ShaderRegistry(const std::string& _directory) : m_directory(_directory) {
+		std::error_code _error;
+		std::filesystem::create_directories(m_directory, _error);
+#ifdef __linux__
+		m_inotify_descriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (m_inotify_descriptor >= 0) {
+			/* Editors either rewrite in place or rename a temporary file over the original */
+			inotify_add_watch(m_inotify_descriptor, m_directory.string().c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+		}
+#endif
+	}
 
-		_lineVAO->bind();
+	ShaderRegistry::~ShaderRegistry() {
+		for (auto& _entry : m_programs) {
+			delete _entry.Rebuild;
+			_entry.Rebuild = nullptr;
+			_entry.RebuildShaders.clear();
+		}
+		m_programs.clear();
+#ifdef __linux__
+		if (m_inotify_descriptor >= 0) {
+			close(m_inotify_descriptor);
+		}
+		m_inotify_descriptor = -1;
+#endif
+	}
+
+	void ShaderRegistry::add_program(glw::Program* _program, const std::string& _vert_file, const char* _vert, const std::string& _frag_file, const char* _frag, const std::vector<std::string>& _varyings, const std::string& _header) {
+		std::set<std::string> _written { };
+		auto _write_missing = [this, &_written](const std::string& _file, const char* _src) {
+			const std::filesystem::path _path = m_directory / _file;
+			std::error_code _error;
+			if (std::filesystem::exists(_path, _error) == false) {
+				std::ofstream _stream(_path, std::ios::binary);
+				_stream << _src;
+				_written.emplace(_file);
+			}
+		};
+		_write_missing(_vert_file, _vert);
+		if (_frag != nullptr) {
+			_write_missing(_frag_file, _frag);
+		}
+#ifdef __linux__
+		/* The defaults just written would otherwise rebuild every program again on the first update() */
+		if (_written.empty() == false) {
+			for (const auto& _file : this->_collect_changed_files()) {
+				if (_written.count(_file) == 0) {
+					m_changed_files.emplace(_file);
+				}
+			}
+		}
+#endif
+
+		ShaderRegistryProgram _entry;
+		_entry.Program = _program;
+		_entry.VertexFile = _vert_file;
+		_entry.FragmentFile = (_frag != nullptr) ? _frag_file : std::string();
+		_entry.Varyings = _varyings;
+		_entry.Header = _header;
+#ifndef __linux__
+		for (const auto& _file : { _entry.VertexFile, _entry.FragmentFile }) {
+			std::error_code _error;
+			if (_file.empty() == false) {
+				m_write_times[_file] = std::filesystem::last_write_time(m_directory / _file, _error);
+			}
+		}
+#endif
+		m_programs.emplace_back(std::move(_entry));
+		this->_rebuild(m_programs.back());
+	}
+
+	void ShaderRegistry::update() {
+		const std::set<std::string> _changed = this->_collect_changed_files();
+		if (_changed.empty() == false) {
+			for (auto& _entry : m_programs) {
+				if (_changed.count(_entry.VertexFile) > 0 || (_entry.FragmentFile.empty() == false && _changed.count(_entry.FragmentFile) > 0)) {
+					this->_rebuild(_entry);
+				}
+			}
+		}
+
+		for (auto& _entry : m_programs) {
+			if (_entry.Rebuild == nullptr || _entry.Rebuild->is_link_complete() == false) {
+				continue;
+			}
+			try {
+				for (auto& _shader : _entry.RebuildShaders) {
+					_shader.check_compile_status();
+				}
+				_entry.Rebuild->check_link_status();
+				_entry.Rebuild->register_uniforms_from(*_entry.Program);
+				*_entry.Program = std::move(*_entry.Rebuild);
+			}
+			catch (const std::exception& _e) {
+				std::string _files = _entry.VertexFile;
+				if (_entry.FragmentFile.empty() == false) {
+					_files += ", " + _entry.FragmentFile;
+				}
+				m_errors.push(_files + " : " + _e.what());
+			}
+			delete _entry.Rebuild;
+			_entry.Rebuild = nullptr;
+			_entry.RebuildShaders.clear();
+		}
+	}
+
+	bool ShaderRegistry::pop_error(std::string& _out) {
+		if (m_errors.empty()) {
+			return false;
+		}
+		_out = std::move(m_errors.front());
+		m_errors.pop();
+		return true;
+	}
+
+	const std::filesystem::path& ShaderRegistry::directory() const {
+		return m_directory;
+	}
+
+	std::set<std::string> ShaderRegistry::_collect_changed_files() {
+		std::set<std::string> _changed { };
+#ifdef __linux__
+		_changed.swap(m_changed_files);
+		if (m_inotify_descriptor < 0) {
+			return _changed;
+		}
+		alignas(inotify_event) char _buffer[4096];
+		for (;;) {
+			const ssize_t _length = read(m_inotify_descriptor, _buffer, sizeof(_buffer));
+			if (_length <= 0) {
+				break;
+			}
+			for (ssize_t _offset = 0; _offset < _length;) {
+				const inotify_event* _event = reinterpret_cast<const inotify_event*>(_buffer + _offset);
+				if (_event->len > 0) {
+					_changed.emplace(_event->name);
+				}
+				_offset += static_cast<ssize_t>(sizeof(inotify_event) + _event->len);
+			}
+		}
+#else
+		if (m_poll_countdown > 0U) {
+			m_poll_countdown--;
+			return _changed;
+		}
+		m_poll_countdown = ShaderRegistry::poll_interval;
+		for (auto& [_file, _time] : m_write_times) {
+			std::error_code _error;
+			const auto _current = std::filesystem::last_write_time(m_directory / _file, _error);
+			if (!_error && _current != _time) {
+				_time = _current;
+				_changed.emplace(_file);
+			}
+		}
+#endif
+		return _changed;
+	}
+
+	void ShaderRegistry::_rebuild(ShaderRegistryProgram& _entry) {
+		std::string _vert { }, _frag { };
+		if (this->_read_file(_entry.VertexFile, _vert) == false) {
+			m_errors.push(_entry.VertexFile + " : Cannot read the file");
+			return;
+		}
+		if (_entry.FragmentFile.empty() == false && this->_read_file(_entry.FragmentFile, _frag) == false) {
+			m_errors.push(_entry.FragmentFile + " : Cannot read the file");
+			return;
+		}
+
+		/* A newer edit supersedes a rebuild that is still in flight */
+		delete _entry.Rebuild;
+		_entry.RebuildShaders.clear();
+
+		_entry.RebuildShaders.reserve(2);
+		_vert.insert(0, _entry.Header);
+		_entry.RebuildShaders.emplace_back(glw::ShaderType::Vertex, _vert.c_str(), true);
+		if (_entry.FragmentFile.empty() == false) {
+			_frag.insert(0, _entry.Header);
+			_entry.RebuildShaders.emplace_back(glw::ShaderType::Fragment, _frag.c_str(), true);
+		}
+		_entry.Rebuild = new glw::Program();
+		for (auto& _shader : _entry.RebuildShaders) {
+			_entry.Rebuild->attach(&_shader);
+		}
+		if (_entry.Varyings.empty() == false) {
+			std::vector<const char*> _varyings { };
+			_varyings.reserve(_entry.Varyings.size());
+			for (const auto& _varying : _entry.Varyings) {
+				_varyings.emplace_back(_varying.c_str());
+			}
+			_entry.Rebuild->set_transform_feedback_varyings(_varyings.data(), static_cast<uint32_t>(_varyings.size()));
+		}
+		_entry.Rebuild->link_deferred();
+	}
+
+	bool ShaderRegistry::_read_file(const std::string& _file, std::string& _out) const {
+		std::ifstream _stream(m_directory / _file, std::ios::binary);
+		if (_stream.is_open() == false) {
+			return false;
+		}
+		_out.assign(std::istreambuf_iterator<char>(_stream), std::istreambuf_iterator<char>());
+		return true;
+	}
+
+	UploadThread::UploadThread(glw::Window* _main_window) {
+		/* GLFW creates windows on the main thread only; the worker just makes the context current */
+		m_context_window = new glw::Window(_main_window->get_worker_config());
+		m_thread = std::thread(&UploadThread::_run, this);
+	}
+
+	UploadThread::~UploadThread() {
 		{
-			_lineVBO->bind();
-			_lineVBO->bind_empty_data((sizeof(float) * 3) * 2, glw::BufferUsage::DynamicDraw);
-			_lineEBO->bind();
-			_lineEBO->bind_data(_line_indices, glw::BufferUsage::StaticDraw); // TODO
-			//_lineEBO->bind_data(_line_indices, glw::BufferUsage::DynamicDraw); // TODO
-			_lineVAO->attrib_pointer(0, 3, glw::NumericType::Float, sizeof(float) * 3, 0);
+			std::lock_guard<std::mutex> _lock(m_mutex);
+			m_stopping = true;
 		}
-		glw::VertexArrayObject::bind_default();
-		glw::VertexBufferObject::bind_default();
-		glw::ElementBufferObject::bind_default();
+		m_condition.notify_all();
+		if (m_thread.joinable()) {
+			m_thread.join();
+		}
+		for (auto& _job : m_fenced_jobs) {
+			if (_job.Fence != nullptr) {
+				glw::Context::delete_sync(_job.Fence);
+			}
+		}
+		m_fenced_jobs.clear();
+		m_jobs.clear();
+		delete m_context_window;
+		m_context_window = nullptr;
+	}
 
-		GLWObjectSet _setSlot{};
+	void UploadThread::submit(std::function<void()> _work, std::function<void()> _on_ready) {
+		UploadJob _job;
+		_job.Work = std::move(_work);
+		_job.OnReady = std::move(_on_ready);
+		{
+			std::lock_guard<std::mutex> _lock(m_mutex);
+			m_jobs.emplace_back(std::move(_job));
+		}
+		m_condition.notify_one();
+	}
 
-		std::get<glw::VertexArrayObject*>(_setSlot) = _spriteVAO;
-		std::get<glw::VertexBufferObject*>(_setSlot) = _spriteVBO;
-		std::get<glw::ElementBufferObject*>(_setSlot) = _spriteEBO;
+	void UploadThread::collect() {
+		for (;;) {
+			UploadJob _job;
+			{
+				std::lock_guard<std::mutex> _lock(m_mutex);
+				if (m_fenced_jobs.empty()) {
+					return;
+				}
+				/* Jobs are fenced in order, so the first unsignaled fence ends the scan */
+				UploadJob& _front = m_fenced_jobs.front();
+				if (_front.Fence != nullptr && glw::Context::client_wait_sync(_front.Fence, 0ULL) == glw::SyncWaitResult::TimeoutExpired) {
+					return;
+				}
+				_job = std::move(_front);
+				m_fenced_jobs.pop_front();
+			}
+			if (_job.Fence != nullptr) {
+				glw::Context::delete_sync(_job.Fence);
+			}
+			if (_job.Error != nullptr) {
+				std::rethrow_exception(_job.Error);
+			}
+			_job.OnReady();
+		}
+	}
 
-		m_glw_object_set_map[DrawableType::Sprite] = _setSlot;
-		m_glw_object_set_map[DrawableType::BlendedSprite] = _setSlot;
-		m_glw_object_set_map[DrawableType::RoundedColorRect] = _setSlot;
+	size_t UploadThread::pending_count() const {
+		std::lock_guard<std::mutex> _lock(m_mutex);
+		return m_jobs.size() + m_fenced_jobs.size();
+	}
 
-		std::get<glw::VertexArrayObject*>(_setSlot) = _lineVAO;
-		std::get<glw::VertexBufferObject*>(_setSlot) = _lineVBO;
-		std::get<glw::ElementBufferObject*>(_setSlot) = _lineEBO;
+	void UploadThread::_run() {
+		glw::Context::make_current(m_context_window);
+		for (;;) {
+			UploadJob _job;
+			{
+				std::unique_lock<std::mutex> _lock(m_mutex);
+				m_condition.wait(_lock, [this]() { return m_stopping || m_jobs.empty() == false; });
+				if (m_stopping) {
+					break;
+				}
+				_job = std::move(m_jobs.front());
+				m_jobs.pop_front();
+			}
+			try {
+				_job.Work();
+			}
+			catch (...) {
+				_job.Error = std::current_exception();
+			}
+			_job.Fence = glw::Context::fence_sync();
+			/* The render context can only see the fence signal once it has been flushed to the GPU */
+			glw::Context::flush();
+			{
+				std::lock_guard<std::mutex> _lock(m_mutex);
+				m_fenced_jobs.emplace_back(std::move(_job));
+			}
+		}
+		glw::Context::release_current();
+	}
 
-		m_glw_object_set_map[DrawableType::Line] = _setSlot;
+	RenderTargetPool::RenderTargetPool(uint32_t _reference_width, uint32_t _reference_height)
+		: m_reference_width(_reference_width),
+		m_reference_height(_reference_height)
+	{
 
-		std::get<glw::VertexArrayObject*>(_setSlot) = _rectVAO;
-		std::get<glw::VertexBufferObject*>(_setSlot) = _rectVBO;
-		std::get<glw::ElementBufferObject*>(_setSlot) = _rectEBO;
+	}
 
-		m_glw_object_set_map[DrawableType::ColorRect] = _setSlot;
+	RenderTargetPool::~RenderTargetPool() {
+		for (auto& [_key, _target] : m_target_map) {
+			this->_delete_target(_target);
+		}
+		m_target_map.clear();
+	}
 
-		std::get<glw::VertexArrayObject*>(_setSlot) = _linedrectVAO;
-		std::get<glw::VertexBufferObject*>(_setSlot) = _linedrectVBO;
-		std::get<glw::ElementBufferObject*>(_setSlot) = _linedrectEBO;
+	RenderTarget* RenderTargetPool::acquire(const RenderTargetDesc& _desc) {
+		if (_desc.Width == 0U || _desc.Height == 0U) {
+			throw exception::RenderTargetPoolFailure("Target has no area");
+		}
+		RenderTarget* _target = nullptr;
+		auto [_begin, _end] = m_target_map.equal_range(RenderTargetPool::_make_key(_desc));
+		for (auto _it = _begin; _it != _end; ++_it) {
+			if (_it->second->InUse == false) {
+				_target = _it->second;
+				break;
+			}
+		}
+		if (_target == nullptr) {
+			_target = this->_create_target(_desc);
+			m_target_map.emplace(RenderTargetPool::_make_key(_desc), _target);
+		}
+		_target->InUse = true;
+		_target->LastUsedFrame = m_frame_index;
+		m_in_use_count++;
+		return _target;
+	}
 
-		m_glw_object_set_map[DrawableType::LinedRect] = _setSlot;
+	RenderTarget* RenderTargetPool::acquire_scaled(float _scale, glw::InternalFormat _format, glw::FilterType _filter, uint32_t _samples) {
+		RenderTargetDesc _desc;
+		_desc.Width = std::max(1U, static_cast<uint32_t>(static_cast<float>(m_reference_width) * _scale + 0.5f));
+		_desc.Height = std::max(1U, static_cast<uint32_t>(static_cast<float>(m_reference_height) * _scale + 0.5f));
+		_desc.Format = _format;
+		_desc.Filter = _filter;
+		_desc.Samples = _samples;
+		return this->acquire(_desc);
+	}
 
-		glw::Shader _sprite_vert{ glw::ShaderType::Vertex, s_sprite_vert };
-		glw::Shader _line_vert{ glw::ShaderType::Vertex, s_line_vert };
-		glw::Shader _rect_vert{ glw::ShaderType::Vertex, s_rect_vert };
-		glw::Shader _lined_rect_vert{ glw::ShaderType::Vertex, s_lined_rect_vert };
-
-		glw::Shader _sprite_frag{ glw::ShaderType::Fragment, s_sprite_frag };
-		glw::Shader _blended_sprite_frag{ glw::ShaderType::Fragment, s_blended_sprite_frag };
-		glw::Shader _simple_frag{ glw::ShaderType::Fragment, s_simple_frag };
-		glw::Shader _rounded_rect_frag{ glw::ShaderType::Fragment, s_rounded_rect_frag };
-
-		glw::Program* _sprite_program = new glw::Program(); {
-			_sprite_program->attach(&_sprite_vert);
-			_sprite_program->attach(&_sprite_frag);
-			_sprite_program->link();
-			_sprite_program->register_uniform("uMVP");
-			_sprite_program->register_uniform("uSize");
-			_sprite_program->register_uniform("uTexture");
-			_sprite_program->register_uniform("uModulate");
-		}
-		glw::Program* _blended_sprite_program = new glw::Program(); {
-			_blended_sprite_program->attach(&_sprite_vert);
-			_blended_sprite_program->attach(&_blended_sprite_frag);
-			_blended_sprite_program->link();
-			_blended_sprite_program->register_uniform("uMVP");
-			_blended_sprite_program->register_uniform("uSize");
-			_blended_sprite_program->register_uniform("uTextureCount");
-			_blended_sprite_program->register_uniform("uTextures[0]");
-			_blended_sprite_program->register_uniform("uTextures[1]");
-			_blended_sprite_program->register_uniform("uTextures[2]");
-			_blended_sprite_program->register_uniform("uTextures[3]");
-			_blended_sprite_program->register_uniform("uModulate");
-		}
-		glw::Program* _line_program = new glw::Program(); {
-			_line_program->attach(&_line_vert);
-			_line_program->attach(&_simple_frag);
-			_line_program->link();
-			_line_program->register_uniform("uMVP");
-			_line_program->register_uniform("uColor");
-			_line_program->register_uniform("uModulate");
-		}
-		glw::Program* _color_rect_program = new glw::Program(); {
-			_color_rect_program->attach(&_rect_vert);
-			_color_rect_program->attach(&_simple_frag);
-			_color_rect_program->link();
-			_color_rect_program->register_uniform("uMVP");
-			_color_rect_program->register_uniform("uSize");
-			_color_rect_program->register_uniform("uColor");
-			_color_rect_program->register_uniform("uModulate");
-		}
-		glw::Program* _lined_rect_program = new glw::Program(); {
-			_lined_rect_program->attach(&_lined_rect_vert);
-			_lined_rect_program->attach(&_simple_frag);
-			_lined_rect_program->link();
-			_lined_rect_program->register_uniform("uMVP");
-			_lined_rect_program->register_uniform("uSize");
-			_lined_rect_program->register_uniform("uColor");
-			_lined_rect_program->register_uniform("uModulate");
-		}
-		glw::Program* _rounded_color_rect_program = new glw::Program(); {
-			_rounded_color_rect_program->attach(&_sprite_vert);
-			_rounded_color_rect_program->attach(&_rounded_rect_frag);
-			_rounded_color_rect_program->link();
-			_rounded_color_rect_program->register_uniform("uMVP");
-			_rounded_color_rect_program->register_uniform("uSize");
-			_rounded_color_rect_program->register_uniform("uColor");
-			_rounded_color_rect_program->register_uniform("uModulate");
-			_rounded_color_rect_program->register_uniform("uCornerRadius");
-			_rounded_color_rect_program->register_uniform("uOutlineWidth");
-			_rounded_color_rect_program->register_uniform("uOutlineColor");
+	void RenderTargetPool::release(RenderTarget* _target) {
+		if (_target != nullptr && _target->InUse) {
+			_target->InUse = false;
+			m_in_use_count--;
 		}
+	}
 
-		m_program_map[DrawableType::Sprite] = _sprite_program;
-		m_program_map[DrawableType::BlendedSprite] = _blended_sprite_program;
-		m_program_map[DrawableType::Line] = _line_program;
-		m_program_map[DrawableType::ColorRect] = _color_rect_program;
-		m_program_map[DrawableType::LinedRect] = _lined_rect_program;
-		m_program_map[DrawableType::RoundedColorRect] = _rounded_color_rect_program;
+	RenderTarget* RenderTargetPool::resolve(RenderTarget* _source) {
+		if (_source->Desc.Samples <= 1U) {
+			return _source;
+		}
+		RenderTargetDesc _desc = _source->Desc;
+		_desc.Samples = 1U;
+		RenderTarget* _resolved = this->acquire(_desc);
+		glw::BufferType _mask = glw::BufferType::Color;
+		switch (RenderTargetPool::get_attachment_type(_desc.Format)) {
+		case (glw::AttachmentType::Depth): {
+			_mask = glw::BufferType::Depth;
+			break;
+		}
+		case (glw::AttachmentType::DepthStencil): {
+			_mask = glw::BufferType::Depth | glw::BufferType::Stencil;
+			break;
+		}
+		default: {
+			break;
+		}
+		}
+		/* Blits are scissored too, e.g. inside Server::begin_partial_redraw() */
+		const bool _scissor = glw::Context::get_is_enabled(glw::CapabilityType::Scissor);
+		glw::Context::disable(glw::CapabilityType::Scissor);
+		_source->Framebuffer->blit_to(_resolved->Framebuffer, _desc.Width, _desc.Height, _mask, glw::FilterType::Nearest);
+		glw::FrameBufferObject::bind_default();
+		if (_scissor) {
+			glw::Context::enable(glw::CapabilityType::Scissor);
+		}
+		this->release(_source);
+		return _resolved;
+	}
 
-		m_glw_object_sets.emplace_back(std::make_tuple(_spriteVAO, _spriteVBO, _spriteEBO));
-		m_glw_object_sets.emplace_back(std::make_tuple(_lineVAO, _lineVBO, _lineEBO));
-		m_glw_object_sets.emplace_back(std::make_tuple(_rectVAO, _rectVBO, _rectEBO));
-		m_glw_object_sets.emplace_back(std::make_tuple(_linedrectVAO, _linedrectVBO, _linedrectEBO));
+	void RenderTargetPool::end_frame() {
+		for (auto _it = m_target_map.begin(); _it != m_target_map.end();) {
+			RenderTarget* _target = _it->second;
+			this->release(_target);
+			if (m_frame_index - _target->LastUsedFrame > m_retained_frames) {
+				this->_delete_target(_target);
+				_it = m_target_map.erase(_it);
+			}
+			else {
+				++_it;
+			}
+		}
+		m_frame_index++;
+	}
 
-		m_programs.emplace_back(_sprite_program);
-		m_programs.emplace_back(_blended_sprite_program);
-		m_programs.emplace_back(_line_program);
-		m_programs.emplace_back(_color_rect_program);
-		m_programs.emplace_back(_lined_rect_program);
-		m_programs.emplace_back(_rounded_color_rect_program);
+	void RenderTargetPool::clear() {
+		for (auto _it = m_target_map.begin(); _it != m_target_map.end();) {
+			if (_it->second->InUse == false) {
+				this->_delete_target(_it->second);
+				_it = m_target_map.erase(_it);
+			}
+			else {
+				++_it;
+			}
+		}
 	}
 
-	Server::~Server() {
-		for (auto& _object : m_objects) {
-			delete _object;
-			_object = nullptr;
+	void RenderTargetPool::set_reference_size(uint32_t _width, uint32_t _height) {
+		m_reference_width = _width;
+		m_reference_height = _height;
+	}
+
+	const uint32_t& RenderTargetPool::get_reference_width() const {
+		return m_reference_width;
+	}
+
+	const uint32_t& RenderTargetPool::get_reference_height() const {
+		return m_reference_height;
+	}
+
+	void RenderTargetPool::set_retained_frames(const uint32_t& _value) {
+		m_retained_frames = _value;
+	}
+
+	const uint32_t& RenderTargetPool::get_retained_frames() const {
+		return m_retained_frames;
+	}
+
+	size_t RenderTargetPool::get_target_count() const {
+		return m_target_map.size();
+	}
+
+	const size_t& RenderTargetPool::get_in_use_count() const {
+		return m_in_use_count;
+	}
+
+	const size_t& RenderTargetPool::get_memory_usage() const {
+		return m_memory_usage;
+	}
+
+	glw::AttachmentType RenderTargetPool::get_attachment_type(glw::InternalFormat _format, uint32_t _color_index) {
+		switch (_format) {
+		case (glw::InternalFormat::DepthComponent):
+		case (glw::InternalFormat::DepthComponent16):
+		case (glw::InternalFormat::DepthComponent24):
+		case (glw::InternalFormat::DepthComponent32F): {
+			return glw::AttachmentType::Depth;
 		}
-		m_objects.clear();
+		case (glw::InternalFormat::DepthStencil):
+		case (glw::InternalFormat::Depth24Stencil8):
+		case (glw::InternalFormat::Depth32FStencil8): {
+			return glw::AttachmentType::DepthStencil;
+		}
+		default: {
+			break;
+		}
+		}
+		return static_cast<glw::AttachmentType>(static_cast<uint32_t>(glw::AttachmentType::Color0) + _color_index);
+	}
 
-		for (auto& [_vao, _vbo, _ebo] : m_glw_object_sets) {
-			delete _vao, _vbo, _ebo;
-			_vao = nullptr;
-			_vbo = nullptr;
-			_ebo = nullptr;
+	glw::TextureConfig RenderTargetPool::make_texture_config(const RenderTargetDesc& _desc) {
+		glw::TextureConfig _cfg;
+		_cfg.MagFilter = _desc.Filter;
+		_cfg.MinFilter = _desc.Filter;
+		_cfg.WrappingS = glw::WrappingType::ClampEdge;
+		_cfg.WrappingT = glw::WrappingType::ClampEdge;
+		_cfg.FormatInternal = _desc.Format;
+		switch (_desc.Format) {
+		case (glw::InternalFormat::DepthComponent):
+		case (glw::InternalFormat::DepthComponent16):
+		case (glw::InternalFormat::DepthComponent24):
+		case (glw::InternalFormat::DepthComponent32F): {
+			_cfg.FormatTexture = glw::TextureFormat::DepthComponent;
+			_cfg.FormatData = glw::DataType::Float;
+			break;
 		}
-		m_glw_object_sets.clear();
-		m_glw_object_set_map.clear();
+		case (glw::InternalFormat::DepthStencil):
+		case (glw::InternalFormat::Depth24Stencil8): {
+			_cfg.FormatTexture = glw::TextureFormat::DepthStencil;
+			_cfg.FormatData = glw::DataType::UnsignedInt248;
+			break;
+		}
+		case (glw::InternalFormat::Depth32FStencil8): {
+			_cfg.FormatTexture = glw::TextureFormat::DepthStencil;
+			_cfg.FormatData = glw::DataType::Float32UnsignedInt248Rev;
+			break;
+		}
+		default: {
+			break;
+		}
+		}
+		return _cfg;
+	}
 
-		for (auto& _prog : m_programs) {
-			delete _prog;
-			_prog = nullptr;
+	size_t RenderTargetPool::get_pixel_size(glw::InternalFormat _format) {
+		switch (_format) {
+		case (glw::InternalFormat::R8):
+		case (glw::InternalFormat::R8I):
+		case (glw::InternalFormat::R8UI):
+		case (glw::InternalFormat::R8SNorm):
+		case (glw::InternalFormat::R3G3B2): {
+			return 1ULL;
 		}
-		m_programs.clear();
-		m_program_map.clear();
+		case (glw::InternalFormat::R16F):
+		case (glw::InternalFormat::R16I):
+		case (glw::InternalFormat::R16UI):
+		case (glw::InternalFormat::R16SNorm):
+		case (glw::InternalFormat::RG8):
+		case (glw::InternalFormat::RG8I):
+		case (glw::InternalFormat::RG8UI):
+		case (glw::InternalFormat::RG8SNorm):
+		case (glw::InternalFormat::RGB5A1):
+		case (glw::InternalFormat::RGBA4):
+		case (glw::InternalFormat::DepthComponent16): {
+			return 2ULL;
+		}
+		case (glw::InternalFormat::RGB16F):
+		case (glw::InternalFormat::RGBA16):
+		case (glw::InternalFormat::RGBA16F):
+		case (glw::InternalFormat::RGBA16I):
+		case (glw::InternalFormat::RGBA16UI):
+		case (glw::InternalFormat::RG32F):
+		case (glw::InternalFormat::RG32I):
+		case (glw::InternalFormat::RG32UI):
+		case (glw::InternalFormat::Depth32FStencil8): {
+			return 8ULL;
+		}
+		case (glw::InternalFormat::RGB32F):
+		case (glw::InternalFormat::RGB32I):
+		case (glw::InternalFormat::RGB32UI):
+		case (glw::InternalFormat::RGBA32F):
+		case (glw::InternalFormat::RGBA32I):
+		case (glw::InternalFormat::RGBA32UI): {
+			return 16ULL;
+		}
+		default: {
+			break;
+		}
+		}
+		/* 8-bit RGB(A), packed 32-bit and 24/32-bit depth formats */
+		return 4ULL;
+	}
 
-		for (auto& _tex : m_textures) {
+	RenderTarget* RenderTargetPool::_create_target(const RenderTargetDesc& _desc) {
+		RenderTarget* _target = new RenderTarget();
+		_target->Desc = _desc;
+		glw::AttachmentType _type = RenderTargetPool::get_attachment_type(_desc.Format);
+		if (_desc.Samples > 1U) {
+			_target->RenderBuffer = new glw::RenderBufferObject();
+			_target->RenderBuffer->bind();
+			_target->RenderBuffer->set_storage(_desc.Format, _desc.Width, _desc.Height, _desc.Samples);
+			glw::RenderBufferObject::bind_default();
+		}
+		else {
+			_target->Texture = new glw::Texture(RenderTargetPool::make_texture_config(_desc), _desc.Width, _desc.Height, (_type == glw::AttachmentType::Color0 ? 4U : 1U));
+		}
+		_target->Framebuffer = new glw::FrameBufferObject();
+		_target->Framebuffer->bind();
+		if (_type != glw::AttachmentType::Color0) {
+			glw::Context::draw_buffer(glw::DrawBufferType::None);
+			glw::Context::read_buffer(glw::ReadBufferType::None);
+		}
+		if (_target->Texture != nullptr) {
+			_target->Framebuffer->attach_texture(_type, _target->Texture);
+		}
+		else {
+			_target->Framebuffer->attach_render_buffer(_type, _target->RenderBuffer);
+		}
+		glw::FrameBufferObject::bind_default();
+		m_memory_usage += RenderTargetPool::get_pixel_size(_desc.Format) * _desc.Width * _desc.Height * std::max(1U, _desc.Samples);
+		return _target;
+	}
+
+	void RenderTargetPool::_delete_target(RenderTarget* _target) {
+		const RenderTargetDesc& _desc = _target->Desc;
+		m_memory_usage -= RenderTargetPool::get_pixel_size(_desc.Format) * _desc.Width * _desc.Height * std::max(1U, _desc.Samples);
+		if (_target->InUse) {
+			m_in_use_count--;
+		}
+		delete _target->Framebuffer;
+		delete _target->Texture;
+		delete _target->RenderBuffer;
+		delete _target;
+	}
+
+	RenderTargetPool::TargetKey RenderTargetPool::_make_key(const RenderTargetDesc& _desc) {
+		return TargetKey(_desc.Width, _desc.Height, _desc.Format, _desc.Filter, std::max(1U, _desc.Samples));
+	}
+
+	RenderGraph::~RenderGraph() {
+		for (auto& [_key, _fbo] : m_framebuffer_map) {
+			delete _fbo;
+		}
+		m_framebuffer_map.clear();
+		for (auto& [_key, _tex] : m_textures) {
 			delete _tex;
-			_tex = nullptr;
 		}
 		m_textures.clear();
-		m_texture_map.clear();
 	}
 
-	const glw::Texture* Server::fetch_texture(const std::string& _path, bool _auto_format, glw::TextureConfig _cfg) {
-		TextureKey _key = std::make_tuple(
-			_path,
-			_cfg.MagFilter,
-			_cfg.MinFilter,
-			_cfg.WrappingS,
-			_cfg.WrappingT,
-			_cfg.FormatInternal,
-			_cfg.FormatTexture,
-			_cfg.FormatData,
-			_cfg.MipmapGeneration,
-			_cfg.FilpY
-		);
-		if (m_texture_map.find(_key) != m_texture_map.end()) {
-			return m_texture_map.at(_key);
+	RenderTargetHandle RenderGraph::create_target(const std::string& _name, const RenderTargetDesc& _desc) {
+		if (_desc.Width == 0U || _desc.Height == 0U) {
+			throw exception::RenderGraphFailure(_name, "Target has no area");
 		}
-		stbi_set_flip_vertically_on_load(_cfg.FilpY);
-		int _width = 0, _height = 0, _channels = 0;
-		unsigned char* _data = stbi_load(_path.c_str(), &_width, &_height, &_channels, 0);
-		if (_data == nullptr) {
-			throw exception::STBILoadingFailure(_path);
+		if (_desc.Samples > 1U) {
+			throw exception::RenderGraphFailure(_name, "Multisampled targets cannot be read by passes");
 		}
-		if (_auto_format) {
-			glw::Context::enable(glw::CapabilityType::Blend);
-			glw::Context::blend_func(glw::BlendFuncType::SrcAlpha, glw::BlendFuncType::OneMinusSrcAlpha);
+		RenderGraphTarget _target;
+		_target.Name = _name;
+		_target.Desc = _desc;
+		m_targets.emplace_back(std::move(_target));
+		m_compiled = false;
+		return static_cast<RenderTargetHandle>(m_targets.size() - 1);
+	}
 
-			switch (_channels) {
-			case (4): {
-				_cfg.FormatInternal = glw::InternalFormat::RGBA;
-				_cfg.FormatTexture = glw::TextureFormat::RGBA;
-				break;
+	RenderTargetHandle RenderGraph::import_texture(const std::string& _name, const glw::Texture* _tex) {
+		RenderGraphTarget _target;
+		_target.Name = _name;
+		_target.Desc.Width = _tex->width();
+		_target.Desc.Height = _tex->height();
+		_target.Desc.Format = _tex->config().FormatInternal;
+		_target.Desc.Filter = _tex->config().MagFilter;
+		_target.Imported = _tex;
+		m_targets.emplace_back(std::move(_target));
+		m_compiled = false;
+		return static_cast<RenderTargetHandle>(m_targets.size() - 1);
+	}
+
+	RenderTargetHandle RenderGraph::import_backbuffer(uint32_t _width, uint32_t _height) {
+		RenderGraphTarget _target;
+		_target.Name = "Backbuffer";
+		_target.Desc.Width = _width;
+		_target.Desc.Height = _height;
+		_target.Backbuffer = true;
+		_target.Output = true;
+		m_targets.emplace_back(std::move(_target));
+		m_compiled = false;
+		return static_cast<RenderTargetHandle>(m_targets.size() - 1);
+	}
+
+	void RenderGraph::mark_output(RenderTargetHandle _target) {
+		_get_target(_target);
+		m_targets[_target].Output = true;
+		m_compiled = false;
+	}
+
+	void RenderGraph::add_pass(const std::string& _name, const std::vector<RenderTargetHandle>& _reads, const std::vector<RenderTargetHandle>& _writes, std::function<void(const RenderGraph&)> _execute) {
+		if (_writes.empty()) {
+			throw exception::RenderGraphFailure(_name, "Pass writes nothing");
+		}
+		for (const auto& _read : _reads) {
+			if (_get_target(_read).Backbuffer) {
+				throw exception::RenderGraphFailure(_name, "Backbuffer cannot be read");
 			}
-			case (3): {
-				_cfg.FormatInternal = glw::InternalFormat::RGB;
-				_cfg.FormatTexture = glw::TextureFormat::RGB;
-				break;
+		}
+		uint32_t _depth_count = 0U;
+		for (const auto& _write : _writes) {
+			const RenderGraphTarget& _target = _get_target(_write);
+			if (_target.Backbuffer && _writes.size() != 1) {
+				throw exception::RenderGraphFailure(_name, "Backbuffer must be the only write target");
 			}
-			case (1): {
-				_cfg.FormatInternal = glw::InternalFormat::Red;
-				_cfg.FormatTexture = glw::TextureFormat::Red;
-				break;
+			if (_target.Desc.Width != _get_target(_writes.front()).Desc.Width || _target.Desc.Height != _get_target(_writes.front()).Desc.Height) {
+				throw exception::RenderGraphFailure(_name, "Write targets differ in size");
 			}
-			default: {
-				break;
+			if (RenderTargetPool::get_attachment_type(_target.Desc.Format, 0U) != glw::AttachmentType::Color0) {
+				_depth_count++;
+			}
+		}
+		if (_depth_count > 1U) {
+			throw exception::RenderGraphFailure(_name, "More than one depth target");
+		}
+		for (const auto& _write : _writes) {
+			if (m_targets[_write].Imported != nullptr) {
+				m_targets[_write].Output = true;
+			}
+		}
+		RenderGraphPass _pass;
+		_pass.Name = _name;
+		_pass.Reads = _reads;
+		_pass.Writes = _writes;
+		_pass.Execute = std::move(_execute);
+		m_passes.emplace_back(std::move(_pass));
+		m_compiled = false;
+	}
+
+	void RenderGraph::compile() {
+		_cull();
+		_compute_lifetimes();
+		_assign_textures();
+		_create_framebuffers();
+		m_compiled = true;
+	}
+
+	void RenderGraph::execute() {
+		if (m_compiled == false) {
+			this->compile();
+		}
+		int _xpos = 0, _ypos = 0;
+		uint32_t _width = 0U, _height = 0U;
+		glw::Context::get_viewport(_xpos, _ypos, _width, _height);
+		for (auto& _pass : m_passes) {
+			if (_pass.Culled) {
+				continue;
+			}
+			const RenderTargetDesc& _desc = m_targets[_pass.Writes.front()].Desc;
+			if (_pass.Framebuffer == nullptr) {
+				glw::FrameBufferObject::bind_default();
 			}
+			else {
+				_pass.Framebuffer->bind();
+				_pass.Framebuffer->invalidate(_pass.InvalidateBefore);
+			}
+			glw::Context::viewport(0, 0, _desc.Width, _desc.Height);
+			_pass.Execute(*this);
+			if (_pass.Framebuffer != nullptr && _pass.InvalidateAfter.empty() == false) {
+				/* Execute may have bound something else */
+				_pass.Framebuffer->bind();
+				_pass.Framebuffer->invalidate(_pass.InvalidateAfter);
+			}
+		}
+		glw::FrameBufferObject::bind_default();
+		glw::Context::viewport(_xpos, _ypos, _width, _height);
+	}
+
+	void RenderGraph::reset() {
+		m_targets.clear();
+		m_passes.clear();
+		m_compiled = false;
+	}
+
+	void RenderGraph::trim() {
+		for (auto _it = m_framebuffer_map.begin(); _it != m_framebuffer_map.end();) {
+			if (m_used_framebuffers.find(_it->second) == m_used_framebuffers.end()) {
+				delete _it->second;
+				_it = m_framebuffer_map.erase(_it);
+			}
+			else {
+				++_it;
+			}
+		}
+		for (auto _it = m_textures.begin(); _it != m_textures.end();) {
+			if (m_used_textures.find(_it->second) == m_used_textures.end()) {
+				delete _it->second;
+				_it = m_textures.erase(_it);
+			}
+			else {
+				++_it;
+			}
+		}
+	}
+
+	const glw::Texture* RenderGraph::get_texture(RenderTargetHandle _target) const {
+		const RenderGraphTarget& _info = _get_target(_target);
+		if (_info.Imported != nullptr) {
+			return _info.Imported;
+		}
+		return _info.Aliased;
+	}
+
+	size_t RenderGraph::get_pass_count() const {
+		return m_passes.size();
+	}
+
+	size_t RenderGraph::get_culled_pass_count() const {
+		return static_cast<size_t>(std::count_if(m_passes.begin(), m_passes.end(), [](const RenderGraphPass& _pass) { return _pass.Culled; }));
+	}
+
+	size_t RenderGraph::get_texture_count() const {
+		return m_textures.size();
+	}
+
+	size_t RenderGraph::get_framebuffer_count() const {
+		return m_framebuffer_map.size();
+	}
+
+	void RenderGraph::_cull() {
+		std::vector<bool> _needed(m_targets.size(), false);
+		for (size_t i = 0; i < m_targets.size(); i++) {
+			_needed[i] = m_targets[i].Output;
+		}
+		/* Walking backwards, a pass survives if a later surviving pass or an output needs what it writes */
+		for (auto _it = m_passes.rbegin(); _it != m_passes.rend(); ++_it) {
+			_it->Culled = std::none_of(_it->Writes.begin(), _it->Writes.end(), [&_needed](RenderTargetHandle _write) { return _needed[_write]; });
+			if (_it->Culled == false) {
+				for (const auto& _read : _it->Reads) {
+					_needed[_read] = true;
+				}
+			}
+		}
+	}
+
+	void RenderGraph::_compute_lifetimes() {
+		for (auto& _target : m_targets) {
+			_target.FirstPass = -1;
+			_target.LastPass = -1;
+		}
+		for (size_t i = 0; i < m_passes.size(); i++) {
+			const RenderGraphPass& _pass = m_passes[i];
+			if (_pass.Culled) {
+				continue;
+			}
+			for (const auto& _read : _pass.Reads) {
+				RenderGraphTarget& _target = m_targets[_read];
+				if (_target.FirstPass < 0 && _target.Imported == nullptr) {
+					throw exception::RenderGraphFailure(_pass.Name, "Target read before it is written : Target = " + _target.Name);
+				}
+				_target.LastPass = static_cast<int32_t>(i);
+			}
+			for (const auto& _write : _pass.Writes) {
+				RenderGraphTarget& _target = m_targets[_write];
+				if (_target.FirstPass < 0) {
+					_target.FirstPass = static_cast<int32_t>(i);
+				}
+				_target.LastPass = static_cast<int32_t>(i);
+			}
+		}
+	}
+
+	void RenderGraph::_assign_textures() {
+		/* Every texture is free when the frame starts */
+		std::vector<std::pair<TargetKey, glw::Texture*>> _free = m_textures;
+		m_used_textures.clear();
+		for (auto& _target : m_targets) {
+			_target.Aliased = nullptr;
+		}
+		for (size_t i = 0; i < m_passes.size(); i++) {
+			if (m_passes[i].Culled) {
+				continue;
+			}
+			for (auto& _target : m_targets) {
+				if (_target.Imported == nullptr && _target.Backbuffer == false && _target.FirstPass == static_cast<int32_t>(i)) {
+					_target.Aliased = this->_acquire_texture(_target.Desc, _free);
+				}
+			}
+			for (auto& _target : m_targets) {
+				if (_target.Aliased != nullptr && _target.Output == false && _target.LastPass == static_cast<int32_t>(i)) {
+					_free.emplace_back(TargetKey(_target.Desc.Width, _target.Desc.Height, _target.Desc.Format, _target.Desc.Filter), _target.Aliased);
+				}
+			}
+		}
+	}
+
+	void RenderGraph::_create_framebuffers() {
+		m_used_framebuffers.clear();
+		for (size_t i = 0; i < m_passes.size(); i++) {
+			RenderGraphPass& _pass = m_passes[i];
+			_pass.Framebuffer = nullptr;
+			_pass.InvalidateBefore.clear();
+			_pass.InvalidateAfter.clear();
+			if (_pass.Culled || m_targets[_pass.Writes.front()].Backbuffer) {
+				continue;
+			}
+			FramebufferKey _key;
+			const glw::Texture* _depth = nullptr;
+			glw::AttachmentType _depth_type = glw::AttachmentType::Depth;
+			std::vector<glw::AttachmentType> _colors;
+			for (const auto& _write : _pass.Writes) {
+				const RenderGraphTarget& _target = m_targets[_write];
+				const glw::Texture* _tex = (_target.Imported != nullptr ? _target.Imported : _target.Aliased);
+				glw::AttachmentType _type = RenderTargetPool::get_attachment_type(_target.Desc.Format, static_cast<uint32_t>(_colors.size()));
+				if (_type == glw::AttachmentType::Depth || _type == glw::AttachmentType::DepthStencil) {
+					_depth = _tex;
+					_depth_type = _type;
+				}
+				else {
+					_key.push_back(_tex);
+					_colors.push_back(_type);
+				}
+				if (_target.Aliased != nullptr && _target.FirstPass == static_cast<int32_t>(i)) {
+					_pass.InvalidateBefore.push_back(_type);
+				}
+				if (_target.Aliased != nullptr && _target.Output == false && _target.LastPass == static_cast<int32_t>(i)) {
+					_pass.InvalidateAfter.push_back(_type);
+				}
+			}
+			/* The depth slot is always last, so a color-only and a depth-only set never collide */
+			_key.push_back(_depth);
+			auto _it = m_framebuffer_map.find(_key);
+			if (_it == m_framebuffer_map.end()) {
+				glw::FrameBufferObject* _fbo = new glw::FrameBufferObject();
+				_fbo->bind();
+				if (_colors.empty()) {
+					glw::Context::draw_buffer(glw::DrawBufferType::None);
+					glw::Context::read_buffer(glw::ReadBufferType::None);
+				}
+				for (size_t j = 0; j < _colors.size(); j++) {
+					_fbo->attach_texture(_colors[j], _key[j]);
+				}
+				if (_depth != nullptr) {
+					_fbo->attach_texture(_depth_type, _depth);
+				}
+				if (_colors.size() > 1) {
+					_fbo->set_draw_buffers(_colors);
+				}
+				glw::FrameBufferObject::bind_default();
+				_it = m_framebuffer_map.emplace(_key, _fbo).first;
+			}
+			_pass.Framebuffer = _it->second;
+			m_used_framebuffers.insert(_it->second);
+		}
+	}
+
+	glw::Texture* RenderGraph::_acquire_texture(const RenderTargetDesc& _desc, std::vector<std::pair<TargetKey, glw::Texture*>>& _free) {
+		TargetKey _key(_desc.Width, _desc.Height, _desc.Format, _desc.Filter);
+		glw::Texture* _tex = nullptr;
+		for (auto _it = _free.begin(); _it != _free.end(); ++_it) {
+			if (_it->first == _key) {
+				_tex = _it->second;
+				_free.erase(_it);
+				break;
+			}
+		}
+		if (_tex == nullptr) {
+			bool _is_depth = RenderTargetPool::get_attachment_type(_desc.Format, 0U) != glw::AttachmentType::Color0;
+			_tex = new glw::Texture(RenderTargetPool::make_texture_config(_desc), _desc.Width, _desc.Height, (_is_depth ? 1U : 4U));
+			m_textures.emplace_back(_key, _tex);
+		}
+		m_used_textures.insert(_tex);
+		return _tex;
+	}
+
+	const RenderGraphTarget& RenderGraph::_get_target(RenderTargetHandle _target) const {
+		if (_target >= m_targets.size()) {
+			throw exception::RenderGraphFailure(std::to_string(_target), "Invalid target handle");
+		}
+		return m_targets[_target];
+	}
+
+	PostProcess::PostProcess(Server* _owner)
+		: m_owner(_owner)
+	{
+		/* The fullscreen triangle has no attributes, but core profile still needs a vertex array bound */
+		m_VAO = new glw::VertexArrayObject();
+	}
+
+	PostProcess::~PostProcess() {
+		for (auto& [_key, _mask] : m_shadow_mask_map) {
+			delete _mask.Framebuffer;
+			delete _mask.Texture;
+		}
+		m_shadow_mask_map.clear();
+		delete m_VAO;
+		m_VAO = nullptr;
+	}
+
+	RenderTarget* PostProcess::downsample(const glw::Texture* _source, glw::InternalFormat _format, float _threshold) {
+		const SavedBinding _binding = PostProcess::_begin();
+		RenderTargetDesc _desc;
+		_desc.Width = std::max(1U, _source->width() / 2U);
+		_desc.Height = std::max(1U, _source->height() / 2U);
+		_desc.Format = _format;
+		RenderTarget* _target = m_owner->get_render_target_pool()->acquire(_desc);
+
+		const glw::Program* _program = m_owner->fetch_post_process_program(PostProcessPass::Downsample);
+		_program->use();
+		{
+			_program->set_vec2("uTexelSize", 1.0f / static_cast<float>(_source->width()), 1.0f / static_cast<float>(_source->height()));
+			_program->set_float("uThreshold", _threshold);
+			glw::Context::activate_texture(glw::TextureSlot::S0);
+			_source->bind();
+			_program->set_sampler2D("uTexture", 0);
+			this->_draw(_target->Framebuffer, _desc.Width, _desc.Height, true);
+			glw::Texture::bind_default();
+		}
+		glw::Program::use_default();
+		PostProcess::_end(_binding);
+		return _target;
+	}
+
+	void PostProcess::blur(RenderTarget* _target, float _sigma) {
+		const SavedBinding _binding = PostProcess::_begin();
+		RenderTargetPool* _pool = m_owner->get_render_target_pool();
+		RenderTarget* _temporary = _pool->acquire(_target->Desc);
+		this->_blur_pass(_target->Texture, _temporary->Framebuffer, false, _sigma);
+		this->_blur_pass(_temporary->Texture, _target->Framebuffer, true, _sigma);
+		_pool->release(_temporary);
+		PostProcess::_end(_binding);
+	}
+
+	RenderTarget* PostProcess::blur(const glw::Texture* _source, float _sigma, uint32_t _levels, glw::InternalFormat _format) {
+		RenderTargetPool* _pool = m_owner->get_render_target_pool();
+		RenderTarget* _target = this->downsample(_source, _format);
+		for (uint32_t i = 1U; i < _levels; i++) {
+			RenderTarget* _next = this->downsample(_target->Texture, _format);
+			_pool->release(_target);
+			_target = _next;
+		}
+		this->blur(_target, _sigma);
+		return _target;
+	}
+
+	void PostProcess::bloom(const glw::Texture* _source, const glw::FrameBufferObject* _target, const BloomConfig& _cfg) {
+		const SavedBinding _binding = PostProcess::_begin();
+		RenderTargetPool* _pool = m_owner->get_render_target_pool();
+		const uint32_t _level_count = std::clamp(_cfg.LevelCount, 1U, maximum_bloom_levels);
+
+		std::vector<RenderTarget*> _chain { };
+		_chain.push_back(this->downsample(_source, _cfg.Format, _cfg.Threshold));
+		while (_chain.size() < _level_count) {
+			_chain.push_back(this->downsample(_chain.back()->Texture, _cfg.Format));
+		}
+
+		/* Smallest level first, each blurred one added onto the next larger level before that one is blurred */
+		const glw::Program* _upsample = m_owner->fetch_post_process_program(PostProcessPass::Upsample);
+		for (size_t i = _chain.size(); i-- > 0;) {
+			this->blur(_chain[i], _cfg.Sigma);
+			if (i == 0) {
+				break;
+			}
+			const glw::Texture* _smaller = _chain[i]->Texture;
+			_upsample->use();
+			{
+				_upsample->set_vec2("uTexelSize", 1.0f / static_cast<float>(_smaller->width()), 1.0f / static_cast<float>(_smaller->height()));
+				_upsample->set_float("uIntensity", 1.0f);
+				glw::Context::activate_texture(glw::TextureSlot::S0);
+				_smaller->bind();
+				_upsample->set_sampler2D("uTexture", 0);
+				glw::Context::enable(glw::CapabilityType::Blend);
+				glw::Context::blend_func(glw::BlendFuncType::One, glw::BlendFuncType::One);
+				this->_draw(_chain[i - 1]->Framebuffer, _chain[i - 1]->Desc.Width, _chain[i - 1]->Desc.Height, false);
+				glw::Context::disable(glw::CapabilityType::Blend);
+				glw::Texture::bind_default();
+			}
+			glw::Program::use_default();
+		}
+
+		const glw::Program* _composite = m_owner->fetch_post_process_program(PostProcessPass::Composite);
+		_composite->use();
+		{
+			_composite->set_float("uIntensity", _cfg.Intensity);
+			glw::Context::activate_texture(glw::TextureSlot::S0);
+			_source->bind();
+			_composite->set_sampler2D("uTexture", 0);
+			glw::Context::activate_texture(glw::TextureSlot::S1);
+			_chain.front()->Texture->bind();
+			_composite->set_sampler2D("uBloom", 1);
+			this->_draw(_target, _source->width(), _source->height(), false);
+			glw::Texture::bind_default();
+			glw::Context::activate_texture(glw::TextureSlot::S0);
+			glw::Texture::bind_default();
+		}
+		glw::Program::use_default();
+
+		for (auto& _level : _chain) {
+			_pool->release(_level);
+		}
+		PostProcess::_end(_binding);
+	}
+
+	const ShadowMask& PostProcess::fetch_shadow_mask(float _corner_radius, float _sigma) {
+		const uint32_t _sigma_units = std::max(1U, static_cast<uint32_t>(std::round(_sigma)));
+		/* Panels of different sizes, or animated ones, land on the same few masks */
+		const float _radius_step = std::max(1.0f, static_cast<float>(_sigma_units) * 0.5f);
+		const uint32_t _radius = static_cast<uint32_t>(std::max(0.0f, std::round(_corner_radius / _radius_step) * _radius_step));
+		const std::pair<uint32_t, uint32_t> _key(_radius, _sigma_units);
+		const uint64_t _frame = m_owner->get_frame_index();
+		auto _cached = m_shadow_mask_map.find(_key);
+		if (_cached != m_shadow_mask_map.end()) {
+			_cached->second.LastUsedFrame = _frame;
+			return _cached->second;
+		}
+		/* Masks fetched this frame may still be waiting to be drawn */
+		while (m_shadow_mask_map.size() >= PostProcess::maximum_shadow_masks) {
+			auto _oldest = m_shadow_mask_map.end();
+			for (auto _it = m_shadow_mask_map.begin(); _it != m_shadow_mask_map.end(); _it++) {
+				if (_it->second.LastUsedFrame != _frame && (_oldest == m_shadow_mask_map.end() || _it->second.LastUsedFrame < _oldest->second.LastUsedFrame)) {
+					_oldest = _it;
+				}
+			}
+			if (_oldest == m_shadow_mask_map.end()) {
+				break;
+			}
+			delete _oldest->second.Framebuffer;
+			delete _oldest->second.Texture;
+			m_shadow_mask_map.erase(_oldest);
+		}
+		const SavedBinding _binding = PostProcess::_begin();
+
+		/* Sigmas past maximum_blur_sigma are blurred on a coarser mask, stretched back by the slice sizes */
+		const uint32_t _scale = std::max(1U, static_cast<uint32_t>(std::ceil(static_cast<float>(_sigma_units) / maximum_blur_sigma)));
+		const float _texel_sigma = static_cast<float>(_sigma_units) / static_cast<float>(_scale);
+		const uint32_t _padding = static_cast<uint32_t>(std::ceil(3.0f * _texel_sigma));
+		const uint32_t _corner = static_cast<uint32_t>(std::ceil(static_cast<float>(_radius) / static_cast<float>(_scale)));
+		/* Corner plus blur on both sides of the edge, then a constant band two texels wide */
+		const uint32_t _border = _corner + 2U * _padding;
+		const uint32_t _size = 2U * _border + 2U;
+
+		RenderTargetDesc _desc;
+		_desc.Width = _size;
+		_desc.Height = _size;
+		_desc.Format = glw::InternalFormat::R8;
+		ShadowMask _mask;
+		_mask.Texture = new glw::Texture(RenderTargetPool::make_texture_config(_desc), _size, _size, 1U);
+		_mask.Framebuffer = new glw::FrameBufferObject();
+		_mask.Framebuffer->bind();
+		_mask.Framebuffer->attach_texture(glw::AttachmentType::Color0, _mask.Texture);
+		_mask.Padding = static_cast<float>(_padding * _scale);
+		_mask.Border = static_cast<float>(_border * _scale);
+		_mask.Size = static_cast<float>(_size * _scale);
+		_mask.LastUsedFrame = _frame;
+
+		const glw::Program* _program = m_owner->fetch_post_process_program(PostProcessPass::RoundedMask);
+		const float _half_size = static_cast<float>(_size) * 0.5f - static_cast<float>(_padding);
+		_program->use();
+		{
+			_program->set_vec2("uCenter", static_cast<float>(_size) * 0.5f, static_cast<float>(_size) * 0.5f);
+			_program->set_vec2("uHalfSize", _half_size, _half_size);
+			_program->set_float("uRadius", std::min(static_cast<float>(_radius) / static_cast<float>(_scale), _half_size));
+			this->_draw(_mask.Framebuffer, _size, _size, true);
+		}
+		glw::Program::use_default();
+
+		RenderTargetPool* _pool = m_owner->get_render_target_pool();
+		RenderTarget* _temporary = _pool->acquire(_desc);
+		this->_blur_pass(_mask.Texture, _temporary->Framebuffer, false, _texel_sigma);
+		this->_blur_pass(_temporary->Texture, _mask.Framebuffer, true, _texel_sigma);
+		_pool->release(_temporary);
+
+		PostProcess::_end(_binding);
+		return m_shadow_mask_map.emplace(_key, _mask).first->second;
+	}
+
+	size_t PostProcess::get_shadow_mask_count() const {
+		return m_shadow_mask_map.size();
+	}
+
+	uint32_t PostProcess::compute_blur_taps(float _sigma, float* _out_offsets, float* _out_weights) {
+		_out_offsets[0] = 0.0f;
+		_out_weights[0] = 1.0f;
+		if (_sigma <= 0.0f) {
+			return 1U;
+		}
+		_sigma = std::min(_sigma, maximum_blur_sigma);
+		const int _radius = std::min(static_cast<int>(std::ceil(3.0f * _sigma)), static_cast<int>(maximum_blur_taps - 1U) * 2);
+		auto _gaussian = [_sigma, _radius](int _x) -> float {
+			return (_x > _radius ? 0.0f : std::exp(-static_cast<float>(_x * _x) / (2.0f * _sigma * _sigma)));
+		};
+		float _total = _gaussian(0);
+		for (int i = 1; i <= _radius; i++) {
+			_total += 2.0f * _gaussian(i);
+		}
+		_out_weights[0] = _gaussian(0) / _total;
+		uint32_t _count = 1U;
+		for (int i = 1; i <= _radius; i += 2) {
+			/* Texels i and i + 1 merged into one bilinear tap placed at their weighted center */
+			const float _weight = _gaussian(i) + _gaussian(i + 1);
+			_out_offsets[_count] = (static_cast<float>(i) * _gaussian(i) + static_cast<float>(i + 1) * _gaussian(i + 1)) / _weight;
+			_out_weights[_count] = _weight / _total;
+			_count++;
+		}
+		return _count;
+	}
+
+	PostProcess::SavedBinding PostProcess::_begin() {
+		SavedBinding _binding;
+		_binding.Framebuffer = glw::Context::get_frame_buffer_binding();
+		glw::Context::get_viewport(_binding.X, _binding.Y, _binding.Width, _binding.Height);
+		/* A partial redraw scissors the caller's drawing, not the passes' own targets */
+		_binding.Scissor = glw::Context::get_is_enabled(glw::CapabilityType::Scissor);
+		glw::Context::disable(glw::CapabilityType::Scissor);
+		return _binding;
+	}
+
+	void PostProcess::_end(const SavedBinding& _binding) {
+		glw::Context::bind_frame_buffer(_binding.Framebuffer);
+		glw::Context::viewport(_binding.X, _binding.Y, _binding.Width, _binding.Height);
+		if (_binding.Scissor) {
+			glw::Context::enable(glw::CapabilityType::Scissor);
+		}
+		glw::Context::enable(glw::CapabilityType::CullFace);
+		glw::Context::enable(glw::CapabilityType::DepthTest);
+		glw::Context::disable(glw::CapabilityType::Blend);
+	}
+
+	void PostProcess::_blur_pass(const glw::Texture* _source, const glw::FrameBufferObject* _target, bool _vertical, float _sigma) {
+		float _offsets[maximum_blur_taps] = { };
+		float _weights[maximum_blur_taps] = { };
+		const uint32_t _count = PostProcess::compute_blur_taps(_sigma, _offsets, _weights);
+		const glw::Program* _program = m_owner->fetch_post_process_program(PostProcessPass::Blur);
+		_program->use();
+		{
+			if (_vertical) {
+				_program->set_vec2("uDirection", 0.0f, 1.0f / static_cast<float>(_source->height()));
+			}
+			else {
+				_program->set_vec2("uDirection", 1.0f / static_cast<float>(_source->width()), 0.0f);
+			}
+			_program->set_int("uTapCount", static_cast<int>(_count));
+			_program->set_floats("uOffsets", _offsets, _count);
+			_program->set_floats("uWeights", _weights, _count);
+			glw::Context::activate_texture(glw::TextureSlot::S0);
+			_source->bind();
+			_program->set_sampler2D("uTexture", 0);
+			this->_draw(_target, _source->width(), _source->height(), true);
+			glw::Texture::bind_default();
+		}
+		glw::Program::use_default();
+	}
+
+	void PostProcess::_draw(const glw::FrameBufferObject* _target, uint32_t _width, uint32_t _height, bool _discard) {
+		if (_target == nullptr) {
+			glw::FrameBufferObject::bind_default();
+		}
+		else {
+			_target->bind();
+			if (_discard) {
+				_target->invalidate({ glw::AttachmentType::Color0 });
+			}
+		}
+		glw::Context::viewport(0, 0, _width, _height);
+		glw::Context::disable(glw::CapabilityType::CullFace);
+		glw::Context::disable(glw::CapabilityType::DepthTest);
+		m_VAO->bind();
+		glw::Context::draw_arrays(glw::PrimitiveType::Triangles, 0, 3);
+		glw::VertexArrayObject::bind_default();
+	}
+
+	Server::Server(uint32_t _initial_window_width, uint32_t _initial_window_height, const std::string& _program_cache_directory)
+		: m_initial_window_width(_initial_window_width),
+		m_initial_window_height(_initial_window_height)
+	{
+		m_render_target_pool = new RenderTargetPool(_initial_window_width, _initial_window_height);
+
+		glw::BufferData _rect_vertices; {
+			_rect_vertices.add_float(0.5f);
+			_rect_vertices.add_float(0.5f);
+			_rect_vertices.add_float(0.0f);
+
+			_rect_vertices.add_float(0.5f);
+			_rect_vertices.add_float(-0.5f);
+			_rect_vertices.add_float(0.0f);
+
+			_rect_vertices.add_float(-0.5f);
+			_rect_vertices.add_float(-0.5f);
+			_rect_vertices.add_float(0.0f);
+
+			_rect_vertices.add_float(-0.5f);
+			_rect_vertices.add_float(0.5f);
+			_rect_vertices.add_float(0.0f);
+		}
+		glw::BufferData _rect_indices; {
+			_rect_indices.add_uint32(0);
+			_rect_indices.add_uint32(1);
+			_rect_indices.add_uint32(3);
+
+			_rect_indices.add_uint32(1);
+			_rect_indices.add_uint32(2);
+			_rect_indices.add_uint32(3);
+		}
+
+		glw::BufferData _sprite_vertices; {
+			_sprite_vertices.add_float(0.5f);
+			_sprite_vertices.add_float(0.5f);
+			_sprite_vertices.add_float(0.0f);
+			_sprite_vertices.add_float(1.0f);
+			_sprite_vertices.add_float(1.0f);
+
+			_sprite_vertices.add_float(0.5f);
+			_sprite_vertices.add_float(-0.5f);
+			_sprite_vertices.add_float(0.0f);
+			_sprite_vertices.add_float(1.0f);
+			_sprite_vertices.add_float(0.0f);
+
+			_sprite_vertices.add_float(-0.5f);
+			_sprite_vertices.add_float(-0.5f);
+			_sprite_vertices.add_float(0.0f);
+			_sprite_vertices.add_float(0.0f);
+			_sprite_vertices.add_float(0.0f);
+
+			_sprite_vertices.add_float(-0.5f);
+			_sprite_vertices.add_float(0.5f);
+			_sprite_vertices.add_float(0.0f);
+			_sprite_vertices.add_float(0.0f);
+			_sprite_vertices.add_float(1.0f);
+		}
+		glw::BufferData _sprite_indices; {
+			_sprite_indices.add_uint32(0);
+			_sprite_indices.add_uint32(1);
+			_sprite_indices.add_uint32(3);
+
+			_sprite_indices.add_uint32(1);
+			_sprite_indices.add_uint32(2);
+			_sprite_indices.add_uint32(3);
+		}
+
+		glw::VertexArrayObject* _rectVAO = new glw::VertexArrayObject();
+		glw::VertexBufferObject* _rectVBO = new glw::VertexBufferObject();
+		glw::ElementBufferObject* _rectEBO = new glw::ElementBufferObject();
+
+		_rectVAO->bind();
+		{
+			_rectVBO->bind();
+			_rectVBO->bind_data(_rect_vertices, glw::BufferUsage::StaticDraw);
+			_rectEBO->bind();
+			_rectEBO->bind_data(_rect_indices, glw::BufferUsage::StaticDraw);
+			_rectVAO->attrib_pointer(0, 3, glw::NumericType::Float, sizeof(float) * 3, 0);
+			_rectVAO->attrib_pointer(1, 2, glw::NumericType::Float, sizeof(float) * 3, sizeof(float) * 3);
+		}
+		glw::VertexArrayObject::bind_default();
+		glw::VertexBufferObject::bind_default();
+		glw::ElementBufferObject::bind_default();
+
+		glw::VertexArrayObject* _spriteVAO = new glw::VertexArrayObject();
+		glw::VertexBufferObject* _spriteVBO = new glw::VertexBufferObject();
+		glw::ElementBufferObject* _spriteEBO = new glw::ElementBufferObject();
+
+		_spriteVAO->bind();
+		{
+			_spriteVBO->bind();
+			_spriteVBO->bind_data(_sprite_vertices, glw::BufferUsage::StaticDraw);
+			_spriteEBO->bind();
+			_spriteEBO->bind_data(_sprite_indices, glw::BufferUsage::StaticDraw);
+			_spriteVAO->attrib_pointer(0, 3, glw::NumericType::Float, sizeof(float) * 3 + sizeof(float) * 2, 0);
+			_spriteVAO->attrib_pointer(1, 2, glw::NumericType::Float, sizeof(float) * 3 + sizeof(float) * 2, sizeof(float) * 3);
+		}
+		glw::VertexArrayObject::bind_default();
+		glw::VertexBufferObject::bind_default();
+		glw::ElementBufferObject::bind_default();
+
+		glw::VertexArrayObject* _roundedrectVAO = new glw::VertexArrayObject();
+		glw::VertexBufferObject* _roundedrectVBO = new glw::VertexBufferObject();
+
+		_roundedrectVAO->bind();
+		{
+			_spriteVBO->bind();
+			_spriteEBO->bind();
+			_roundedrectVAO->attrib_pointer(0, 3, glw::NumericType::Float, sizeof(float) * 3 + sizeof(float) * 2, 0);
+			_roundedrectVAO->attrib_pointer(1, 2, glw::NumericType::Float, sizeof(float) * 3 + sizeof(float) * 2, sizeof(float) * 3);
+			_roundedrectVBO->bind();
+			_roundedrectVBO->bind_empty_data(RoundedColorRect::instance_stride, glw::BufferUsage::StreamDraw);
+			for (uint32_t i = 0; i < 8; i++) {
+				_roundedrectVAO->attrib_pointer(2 + i, 4, glw::NumericType::Float, RoundedColorRect::instance_stride, sizeof(float) * 4 * i);
+				_roundedrectVAO->attrib_divisor(2 + i, 1);
+			}
+		}
+		glw::VertexArrayObject::bind_default();
+		glw::VertexBufferObject::bind_default();
+		glw::ElementBufferObject::bind_default();
+
+		glw::VertexArrayObject* _layeredspriteVAO = new glw::VertexArrayObject();
+		glw::VertexBufferObject* _layeredspriteVBO = new glw::VertexBufferObject();
+
+		_layeredspriteVAO->bind();
+		{
+			_spriteVBO->bind();
+			_spriteEBO->bind();
+			_layeredspriteVAO->attrib_pointer(0, 3, glw::NumericType::Float, sizeof(float) * 3 + sizeof(float) * 2, 0);
+			_layeredspriteVAO->attrib_pointer(1, 2, glw::NumericType::Float, sizeof(float) * 3 + sizeof(float) * 2, sizeof(float) * 3);
+			_layeredspriteVBO->bind();
+			_layeredspriteVBO->bind_empty_data(Sprite::instance_stride, glw::BufferUsage::StreamDraw);
+			for (uint32_t i = 0; i < 6; i++) {
+				_layeredspriteVAO->attrib_pointer(2 + i, 4, glw::NumericType::Float, Sprite::instance_stride, sizeof(float) * 4 * i);
+				_layeredspriteVAO->attrib_divisor(2 + i, 1);
+			}
+		}
+		glw::VertexArrayObject::bind_default();
+		glw::VertexBufferObject::bind_default();
+		glw::ElementBufferObject::bind_default();
+
+		glw::VertexArrayObject* _lineVAO = new glw::VertexArrayObject();
+		glw::VertexBufferObject* _lineVBO = new glw::VertexBufferObject();
+
+		_lineVAO->bind();
+		{
+			_lineVBO->bind();
+			_lineVBO->bind_empty_data(Line::segment_stride, glw::BufferUsage::StreamDraw);
+			for (uint32_t i = 0; i < 4; i++) {
+				_lineVAO->attrib_pointer(i, 2, glw::NumericType::Float, Line::segment_stride, sizeof(float) * 2 * i);
+				_lineVAO->attrib_divisor(i, 1);
+			}
+			_lineVAO->attrib_pointer(4, 4, glw::NumericType::Float, Line::segment_stride, sizeof(float) * 8);
+			_lineVAO->attrib_divisor(4, 1);
+			_lineVAO->attrib_pointer(5, 4, glw::NumericType::Float, Line::segment_stride, sizeof(float) * 12);
+			_lineVAO->attrib_divisor(5, 1);
+		}
+		glw::VertexArrayObject::bind_default();
+		glw::VertexBufferObject::bind_default();
+
+		GLWObjectSet _setSlot{};
+
+		std::get<glw::VertexArrayObject*>(_setSlot) = _spriteVAO;
+		std::get<glw::VertexBufferObject*>(_setSlot) = _spriteVBO;
+		std::get<glw::ElementBufferObject*>(_setSlot) = _spriteEBO;
+
+		m_glw_object_set_map[DrawableType::Sprite] = _setSlot;
+		m_glw_object_set_map[DrawableType::BlendedSprite] = _setSlot;
+
+		std::get<glw::VertexArrayObject*>(_setSlot) = _roundedrectVAO;
+		std::get<glw::VertexBufferObject*>(_setSlot) = _roundedrectVBO;
+		std::get<glw::ElementBufferObject*>(_setSlot) = _spriteEBO;
+
+		m_glw_object_set_map[DrawableType::RoundedColorRect] = _setSlot;
+
+		std::get<glw::VertexArrayObject*>(_setSlot) = _layeredspriteVAO;
+		std::get<glw::VertexBufferObject*>(_setSlot) = _layeredspriteVBO;
+		std::get<glw::ElementBufferObject*>(_setSlot) = _spriteEBO;
+
+		m_glw_object_set_map[DrawableType::LayeredSprite] = _setSlot;
+
+		std::get<glw::VertexArrayObject*>(_setSlot) = _lineVAO;
+		std::get<glw::VertexBufferObject*>(_setSlot) = _lineVBO;
+		std::get<glw::ElementBufferObject*>(_setSlot) = nullptr;
+
+		m_glw_object_set_map[DrawableType::Line] = _setSlot;
+		m_glw_object_set_map[DrawableType::LinedRect] = _setSlot;
+
+		std::get<glw::VertexArrayObject*>(_setSlot) = _rectVAO;
+		std::get<glw::VertexBufferObject*>(_setSlot) = _rectVBO;
+		std::get<glw::ElementBufferObject*>(_setSlot) = _rectEBO;
+
+		m_glw_object_set_map[DrawableType::ColorRect] = _setSlot;
+
+		if (_program_cache_directory.empty() == false) {
+			m_program_cache = new glw::ProgramBinaryCache(_program_cache_directory);
+		}
+
+		/* The default quad permutations are compiled up front, the others on first use */
+		glw::Program* _sprite_program = this->_submit_quad_program(ShaderFeature::Textured);
+		glw::Program* _color_rect_program = this->_submit_quad_program(ShaderFeature::None);
+		glw::Program* _rounded_color_rect_program = this->_submit_quad_program(ShaderFeature::Instanced | ShaderFeature::Rounded | ShaderFeature::Outlined);
+		glw::Program* _line_program = this->_submit_program(s_line_vert, s_line_frag);
+		glw::Program* _particle_update_program = this->_submit_program(s_particle_update_vert, nullptr, s_particle_update_varyings, 2);
+		glw::Program* _particle_program = this->_submit_program(s_particle_vert, s_particle_frag);
+		glw::Program* _layered_sprite_program = this->_submit_program(s_layered_sprite_vert, s_layered_sprite_frag);
+		glw::Program* _rect_batch_program = this->_submit_program(s_rect_batch_vert, s_vertex_color_frag);
+
+		/* Every compile and link above is in flight at once when the driver supports parallel compilation */
+		this->_finish_programs();
+
+		for (const auto& [_features, _program] : m_quad_program_map) {
+			this->_register_quad_uniforms(_program, _features);
+		}
+
+		_line_program->register_uniform("uMVP");
+		_line_program->register_uniform("uViewportSize");
+		_line_program->register_uniform("uStripSegmentCount");
+
+		_particle_update_program->register_uniform("uDeltaTime");
+		_particle_update_program->register_uniform("uSeed");
+		_particle_update_program->register_uniform("uCapacity");
+		_particle_update_program->register_uniform("uEmitBegin");
+		_particle_update_program->register_uniform("uEmitCount");
+		_particle_update_program->register_uniform("uEmitterPosition");
+		_particle_update_program->register_uniform("uEmitterRadius");
+		_particle_update_program->register_uniform("uDirection");
+		_particle_update_program->register_uniform("uSpread");
+		_particle_update_program->register_uniform("uSpeedRange");
+		_particle_update_program->register_uniform("uLifetimeRange");
+		_particle_update_program->register_uniform("uAcceleration");
+		_particle_update_program->register_uniform("uDamping");
+
+		_particle_program->register_uniform("uViewProj");
+		_particle_program->register_uniform("uStartColor");
+		_particle_program->register_uniform("uEndColor");
+		_particle_program->register_uniform("uSizeRange");
+		_particle_program->register_uniform("uModulate");
+
+		_layered_sprite_program->register_uniform("uViewProj");
+		_layered_sprite_program->register_uniform("uTextures");
+
+		_rect_batch_program->register_uniform("uMVP");
+		_rect_batch_program->register_uniform("uModulate");
+
+		m_program_map[DrawableType::Sprite] = _sprite_program;
+		/* BlendedSprite picks its permutation by texture count, this is the single-texture one */
+		m_program_map[DrawableType::BlendedSprite] = _sprite_program;
+		m_program_map[DrawableType::Line] = _line_program;
+		m_program_map[DrawableType::Polyline] = _line_program;
+		m_program_map[DrawableType::ColorRect] = _color_rect_program;
+		m_program_map[DrawableType::LinedRect] = _line_program;
+		m_program_map[DrawableType::RoundedColorRect] = _rounded_color_rect_program;
+		m_program_map[DrawableType::ParticleSystem] = _particle_program;
+		m_program_map[DrawableType::RectBatch] = _rect_batch_program;
+		m_program_map[DrawableType::LayeredSprite] = _layered_sprite_program;
+		m_particle_update_program = _particle_update_program;
+
+		m_glw_object_sets.emplace_back(std::make_tuple(_spriteVAO, _spriteVBO, _spriteEBO));
+		m_glw_object_sets.emplace_back(std::make_tuple(_roundedrectVAO, _roundedrectVBO, nullptr));
+		m_glw_object_sets.emplace_back(std::make_tuple(_layeredspriteVAO, _layeredspriteVBO, nullptr));
+		m_glw_object_sets.emplace_back(std::make_tuple(_lineVAO, _lineVBO, nullptr));
+		m_glw_object_sets.emplace_back(std::make_tuple(_rectVAO, _rectVBO, _rectEBO));
+
+		m_programs.emplace_back(_line_program);
+		m_programs.emplace_back(_particle_update_program);
+		m_programs.emplace_back(_particle_program);
+		m_programs.emplace_back(_rect_batch_program);
+		m_programs.emplace_back(_layered_sprite_program);
+	}
+
+	Server::~Server() {
+		/* Pending uploads call back into objects, so they go first */
+		delete m_upload_thread;
+		m_upload_thread = nullptr;
+
+		for (auto& _object : m_objects) {
+			delete _object;
+			_object = nullptr;
+		}
+		m_objects.clear();
+
+		for (auto& [_vao, _vbo, _ebo] : m_glw_object_sets) {
+			delete _vao;
+			delete _vbo;
+			delete _ebo;
+			_vao = nullptr;
+			_vbo = nullptr;
+			_ebo = nullptr;
+		}
+		m_glw_object_sets.clear();
+		m_glw_object_set_map.clear();
+
+		this->disable_partial_redraw();
+
+		/* Shadow masks and temporaries go back before the pool dies */
+		delete m_post_process;
+		m_post_process = nullptr;
+		delete m_render_target_pool;
+		m_render_target_pool = nullptr;
+
+		delete m_shader_registry;
+		m_shader_registry = nullptr;
+		for (auto& _prog : m_programs) {
+			delete _prog;
+			_prog = nullptr;
+		}
+		m_programs.clear();
+		m_program_map.clear();
+		m_quad_program_map.clear();
+		m_particle_update_program = nullptr;
+		m_rect_batch_cull_program = nullptr;
+		delete m_program_cache;
+		m_program_cache = nullptr;
+
+		for (auto& _tex : m_textures) {
+			delete _tex;
+			_tex = nullptr;
+		}
+		m_textures.clear();
+		m_texture_map.clear();
+		m_texture_layer_map.clear();
+		m_texture_array_cursor_map.clear();
+		m_texture_residency_map.clear();
+		m_texture_memory_usage = 0ULL;
+		{
+			std::lock_guard<std::mutex> _lock(m_texture_release_queue->Mutex);
+			m_texture_release_queue->Textures.clear();
+		}
+
+		for (auto& [_prefix, _pack] : m_asset_packs) {
+			delete _pack;
+			_pack = nullptr;
+		}
+		m_asset_packs.clear();
+	}
+
+	TextureRef Server::fetch_texture(const std::string& _path, bool _auto_format, glw::TextureConfig _cfg) {
+		if (_auto_format) {
+			Server::_enable_auto_format_blending();
+		}
+		TextureKey _key = Server::_make_texture_key(_path, _cfg);
+		auto _cached = m_texture_map.find(_key);
+		if (_cached != m_texture_map.end()) {
+			if (TextureRef _ref = _cached->second.lock()) {
+				return _ref;
+			}
+		}
+		TextureResidency _residency;
+		_residency.Path = _path;
+		_residency.AutoFormat = _auto_format;
+		_residency.Config = _cfg;
+		this->_create_texture(_residency);
+		return this->_register_texture(_key, std::move(_residency));
+	}
+
+	void Server::fetch_texture_async(const std::string& _path, std::function<void(TextureRef)> _on_ready, bool _auto_format, glw::TextureConfig _cfg) {
+		if (m_upload_thread == nullptr) {
+			_on_ready(this->fetch_texture(_path, _auto_format, _cfg));
+			return;
+		}
+		if (_auto_format) {
+			Server::_enable_auto_format_blending();
+		}
+		TextureKey _key = Server::_make_texture_key(_path, _cfg);
+		auto _cached = m_texture_map.find(_key);
+		if (_cached != m_texture_map.end()) {
+			if (TextureRef _ref = _cached->second.lock()) {
+				_on_ready(std::move(_ref));
+				return;
+			}
+		}
+		/* Owns the texture until it is registered, so an upload dropped with the upload thread does not leak it */
+		std::shared_ptr<TextureResidency> _residency(new TextureResidency(), [](TextureResidency* _pending) {
+			delete _pending->Texture;
+			delete _pending;
+		});
+		_residency->Path = _path;
+		_residency->AutoFormat = _auto_format;
+		_residency->Config = _cfg;
+		m_upload_thread->submit(
+			[this, _residency]() {
+				this->_create_texture(*_residency);
+			},
+			[this, _residency, _key, _on_ready = std::move(_on_ready)]() {
+				/* A synchronous fetch of the same texture may have finished first */
+				auto _cached = m_texture_map.find(_key);
+				if (_cached != m_texture_map.end()) {
+					if (TextureRef _ref = _cached->second.lock()) {
+						_on_ready(std::move(_ref));
+						return;
+					}
+				}
+				TextureRef _ref = this->_register_texture(_key, std::move(*_residency));
+				_residency->Texture = nullptr;
+				_on_ready(std::move(_ref));
+			}
+		);
+	}
+
+	void Server::_create_texture(TextureResidency& _residency) const {
+		_residency.Image = this->_load_texture_image(_residency.Path, _residency.AutoFormat, _residency.Config);
+		const uint32_t _first_level = Server::_get_streaming_first_level(_residency.Image);
+		_residency.Texture = new glw::Texture(_residency.Config, _residency.Image.Levels.data(), static_cast<uint32_t>(_residency.Image.Levels.size()), _first_level);
+		_residency.ResidentBytes = 0ULL;
+		for (size_t i = _first_level; i < _residency.Image.Levels.size(); i++) {
+			_residency.ResidentBytes += _residency.Image.Levels[i].Length;
+		}
+		if (_first_level == 0U) {
+			_residency.Image = TextureImage();
+		}
+	}
+
+	TextureRef Server::_register_texture(const TextureKey& _key, TextureResidency&& _residency) {
+		glw::Texture* _tex = _residency.Texture;
+		_residency.LastUsedFrame = m_frame_index;
+		m_texture_memory_usage += _residency.ResidentBytes;
+
+		m_textures.emplace_back(_tex);
+		m_texture_residency_map[_tex] = std::move(_residency);
+
+		/* Only queues the texture; deleting GL objects from an arbitrary owner's destructor is not safe */
+		TextureRef _ref(_tex, [_queue = std::weak_ptr<TextureReleaseQueue>(m_texture_release_queue)](const glw::Texture* _released) {
+			if (auto _locked = _queue.lock()) {
+				std::lock_guard<std::mutex> _lock(_locked->Mutex);
+				_locked->Textures.emplace_back(_released);
+			}
+		});
+		m_texture_map[_key] = _ref;
+
+		return _ref;
+	}
+
+	const TextureLayer& Server::fetch_texture_layer(const std::string& _path, bool _auto_format, glw::TextureConfig _cfg) {
+		if (_auto_format) {
+			Server::_enable_auto_format_blending();
+		}
+		TextureKey _key = Server::_make_texture_key(_path, _cfg);
+		if (m_texture_layer_map.find(_key) != m_texture_layer_map.end()) {
+			return m_texture_layer_map.at(_key);
+		}
+		int _width = 0, _height = 0, _channels = 0;
+		const unsigned char* _packed = this->_find_packed_image(_path, _auto_format, _cfg, _width, _height, _channels);
+		unsigned char* _data = (_packed == nullptr) ? Server::_load_image(_path, _auto_format, _cfg, _width, _height, _channels) : nullptr;
+
+		TextureArrayKey _array_key = std::make_tuple(
+			_width,
+			_height,
+			_channels,
+			_cfg.MagFilter,
+			_cfg.MinFilter,
+			_cfg.WrappingS,
+			_cfg.WrappingT,
+			_cfg.FormatInternal,
+			_cfg.FormatTexture,
+			_cfg.FormatData,
+			_cfg.MipmapGeneration
+		);
+		auto _cursor = m_texture_array_cursor_map.find(_array_key);
+		if (_cursor == m_texture_array_cursor_map.end() || _cursor->second.Layer == _cursor->second.Texture->layers()) {
+			glw::Texture* _tex = new glw::Texture(_cfg, _width, _height, m_texture_array_layer_capacity, _channels);
+			m_textures.emplace_back(_tex);
+			m_texture_memory_usage += static_cast<size_t>(_width) * _height * _channels * m_texture_array_layer_capacity;
+			_cursor = m_texture_array_cursor_map.insert_or_assign(_array_key, TextureLayer{ _tex, 0U }).first;
+		}
+		_cursor->second.Texture->set_layer(_cursor->second.Layer, (_packed != nullptr) ? _packed : _data);
+		if (_data != nullptr) {
+			stbi_image_free(_data);
+		}
+
+		m_texture_layer_map[_key] = _cursor->second;
+		_cursor->second.Layer++;
+
+		return m_texture_layer_map.at(_key);
+	}
+
+	void Server::set_texture_cache_directory(const std::string& _path) {
+		m_texture_cache_directory = _path;
+	}
+
+	const std::string& Server::get_texture_cache_directory() const {
+		return m_texture_cache_directory;
+	}
+
+	const AssetPack* Server::mount_asset_pack(const std::string& _path, const std::string& _prefix) {
+		AssetPack* _pack = new AssetPack(_path);
+		const std::string _normalized_prefix = _prefix.empty() ? std::string() : std::filesystem::path(_prefix).lexically_normal().generic_string();
+		m_asset_packs.emplace_back(_normalized_prefix, _pack);
+		return _pack;
+	}
+
+	void Server::enable_background_uploads(glw::Window* _main_window) {
+		if (m_upload_thread == nullptr) {
+			m_upload_thread = new UploadThread(_main_window);
+		}
+	}
+
+	UploadThread* Server::get_upload_thread() {
+		return m_upload_thread;
+	}
+
+	RenderTargetPool* Server::get_render_target_pool() {
+		return m_render_target_pool;
+	}
+
+	void Server::end_frame() {
+		if (m_upload_thread != nullptr) {
+			m_upload_thread->collect();
+		}
+		this->release_unused_textures();
+		this->update_texture_residency();
+		m_render_target_pool->end_frame();
+		if (m_shader_registry != nullptr) {
+			m_shader_registry->update();
+		}
+	}
+
+	void Server::enable_shader_hot_reload(const std::string& _directory) {
+		delete m_shader_registry;
+		m_shader_registry = new ShaderRegistry(_directory);
+		for (const auto& [_features, _program] : m_quad_program_map) {
+			m_shader_registry->add_program(_program, "quad.vert", s_quad_vert, "quad.frag", s_quad_frag, { }, Server::_make_shader_header(_features));
+		}
+		m_shader_registry->add_program(m_program_map.at(DrawableType::Line), "line.vert", s_line_vert, "line.frag", s_line_frag);
+		m_shader_registry->add_program(m_particle_update_program, "particle_update.vert", s_particle_update_vert, "", nullptr, { s_particle_update_varyings[0], s_particle_update_varyings[1] });
+		m_shader_registry->add_program(m_program_map.at(DrawableType::ParticleSystem), "particle.vert", s_particle_vert, "particle.frag", s_particle_frag);
+		m_shader_registry->add_program(m_program_map.at(DrawableType::LayeredSprite), "layered_sprite.vert", s_layered_sprite_vert, "layered_sprite.frag", s_layered_sprite_frag);
+		m_shader_registry->add_program(m_program_map.at(DrawableType::RectBatch), "rect_batch.vert", s_rect_batch_vert, "vertex_color.frag", s_vertex_color_frag);
+	}
+
+	bool Server::pop_shader_reload_error(std::string& _out) {
+		if (m_shader_registry == nullptr) {
+			return false;
+		}
+		return m_shader_registry->pop_error(_out);
+	}
+
+	void Server::release_unused_textures() {
+		std::vector<const glw::Texture*> _released { };
+		{
+			std::lock_guard<std::mutex> _lock(m_texture_release_queue->Mutex);
+			_released.swap(m_texture_release_queue->Textures);
+		}
+		if (_released.empty()) {
+			return;
+		}
+		for (const auto& _tex : _released) {
+			auto _residency = m_texture_residency_map.find(_tex);
+			if (_residency != m_texture_residency_map.end()) {
+				m_texture_memory_usage -= _residency->second.ResidentBytes;
+				m_texture_residency_map.erase(_residency);
+			}
+			m_textures.erase(std::remove(m_textures.begin(), m_textures.end(), _tex), m_textures.end());
+			delete _tex;
+		}
+		for (auto _it = m_texture_map.begin(); _it != m_texture_map.end(); ) {
+			_it = (_it->second.expired() ? m_texture_map.erase(_it) : std::next(_it));
+		}
+	}
+
+	void Server::touch_texture(const glw::Texture* _tex) {
+		auto _it = m_texture_residency_map.find(_tex);
+		if (_it == m_texture_residency_map.end()) {
+			return;
+		}
+		TextureResidency& _residency = _it->second;
+		_residency.LastUsedFrame = m_frame_index;
+		if (_residency.Texture->base_level() == _residency.Texture->levels()) {
+			this->_reload_texture(_residency);
+		}
+	}
+
+	void Server::update_texture_residency() {
+		if (m_texture_memory_budget != 0ULL && m_texture_memory_usage > m_texture_memory_budget) {
+			std::vector<TextureResidency*> _candidates { };
+			for (auto& [_tex, _residency] : m_texture_residency_map) {
+				if (_residency.LastUsedFrame != m_frame_index && _residency.ResidentBytes != 0ULL) {
+					_candidates.emplace_back(&_residency);
+				}
+			}
+			std::sort(_candidates.begin(), _candidates.end(), [](const TextureResidency* _a, const TextureResidency* _b) { return _a->LastUsedFrame < _b->LastUsedFrame; });
+			for (auto& _residency : _candidates) {
+				if (m_texture_memory_usage <= m_texture_memory_budget) {
+					break;
+				}
+				_residency->Texture->release();
+				_residency->Image = TextureImage();
+				m_texture_memory_usage -= _residency->ResidentBytes;
+				_residency->ResidentBytes = 0ULL;
+			}
+		}
+
+		size_t _uploaded = 0ULL;
+		for (auto& [_tex, _residency] : m_texture_residency_map) {
+			if (_residency.LastUsedFrame != m_frame_index || _residency.Image.Levels.empty()) {
+				continue;
+			}
+			glw::Texture* _texture = _residency.Texture;
+			while (_texture->base_level() > 0U) {
+				const glw::CompressedTextureLevel& _level = _residency.Image.Levels[_texture->base_level() - 1U];
+				const bool _over_upload_budget = (_uploaded != 0ULL && _uploaded + _level.Length > m_texture_upload_budget);
+				const bool _over_memory_budget = (m_texture_memory_budget != 0ULL && m_texture_memory_usage + _level.Length > m_texture_memory_budget);
+				if (_over_upload_budget || _over_memory_budget) {
+					break;
+				}
+				_texture->set_level(_texture->base_level() - 1U, _level);
+				_residency.ResidentBytes += _level.Length;
+				m_texture_memory_usage += _level.Length;
+				_uploaded += _level.Length;
+			}
+			if (_texture->base_level() == 0U) {
+				_residency.Image = TextureImage();
+			}
+		}
+
+		m_frame_index++;
+	}
+
+	void Server::set_texture_memory_budget(const size_t& _bytes) {
+		m_texture_memory_budget = _bytes;
+	}
+
+	const size_t& Server::get_texture_memory_budget() const {
+		return m_texture_memory_budget;
+	}
+
+	const size_t& Server::get_texture_memory_usage() const {
+		return m_texture_memory_usage;
+	}
+
+	void Server::set_texture_upload_budget(const size_t& _bytes) {
+		m_texture_upload_budget = _bytes;
+	}
+
+	const size_t& Server::get_texture_upload_budget() const {
+		return m_texture_upload_budget;
+	}
+
+	const uint64_t& Server::get_frame_index() const {
+		return m_frame_index;
+	}
+
+	void Server::set_texture_array_layer_capacity(const uint32_t& _value) {
+		m_texture_array_layer_capacity = (_value == 0U ? 1U : _value);
+	}
+
+	const uint32_t& Server::get_texture_array_layer_capacity() const {
+		return m_texture_array_layer_capacity;
+	}
+
+	const uint32_t& Server::get_initial_window_width() const {
+		return m_initial_window_width;
+	}
+
+	const uint32_t& Server::get_initial_window_height() const {
+		return m_initial_window_height;
+	}
+
+	const Server::GLWObjectSet& Server::get_glw_object_set(const DrawableType& _type) const {
+		return m_glw_object_set_map.at(_type);
+	}
+
+	const glw::Program* Server::get_generic_program(const DrawableType& _type) const {
+		return m_program_map.at(_type);
+	}
+
+	Server::TextureKey Server::_make_texture_key(const std::string& _path, const glw::TextureConfig& _cfg) {
+		return std::make_tuple(
+			_path,
+			_cfg.MagFilter,
+			_cfg.MinFilter,
+			_cfg.WrappingS,
+			_cfg.WrappingT,
+			_cfg.FormatInternal,
+			_cfg.FormatTexture,
+			_cfg.FormatData,
+			_cfg.MipmapGeneration,
+			_cfg.FilpY
+		);
+	}
+
+	unsigned char* Server::_load_image(const std::string& _path, bool _auto_format, glw::TextureConfig& _cfg, int& _out_width, int& _out_height, int& _out_channels) {
+		stbi_set_flip_vertically_on_load(_cfg.FilpY);
+		unsigned char* _data = stbi_load(_path.c_str(), &_out_width, &_out_height, &_out_channels, 0);
+		if (_data == nullptr) {
+			throw exception::STBILoadingFailure(_path);
+		}
+		if (_auto_format) {
+			Server::_apply_auto_format(_cfg, _out_channels);
+		}
+		return _data;
+	}
+
+	const unsigned char* Server::_find_packed_image(const std::string& _path, bool _auto_format, glw::TextureConfig& _cfg, int& _out_width, int& _out_height, int& _out_channels) const {
+		if (m_asset_packs.empty()) {
+			return nullptr;
+		}
+		const std::string _normalized = std::filesystem::path(_path).lexically_normal().generic_string();
+		for (auto _it = m_asset_packs.rbegin(); _it != m_asset_packs.rend(); _it++) {
+			const auto& [_prefix, _pack] = *_it;
+			if (_normalized.compare(0, _prefix.size(), _prefix) != 0) {
+				continue;
+			}
+			/* The prefix has to end at a separator, so a pack at "ui" does not capture "uiextra/" */
+			const bool _at_separator = _prefix.empty() || _prefix.back() == '/' || _normalized.size() == _prefix.size() || _normalized[_prefix.size()] == '/';
+			if (_at_separator == false) {
+				continue;
+			}
+			std::string_view _name(_normalized);
+			_name.remove_prefix(_prefix.size());
+			while (_name.empty() == false && _name.front() == '/') {
+				_name.remove_prefix(1);
+			}
+			const AssetPackEntry* _entry = _pack->find(_name);
+			if (_entry == nullptr || (_entry->FlippedY != 0U) != _cfg.FilpY) {
+				continue;
+			}
+			_out_width = static_cast<int>(_entry->Width);
+			_out_height = static_cast<int>(_entry->Height);
+			_out_channels = static_cast<int>(_entry->Channels);
+			if (_auto_format) {
+				Server::_apply_auto_format(_cfg, _out_channels);
+			}
+			return _pack->get_data(_entry);
+		}
+		return nullptr;
+	}
+
+	void Server::_enable_auto_format_blending() {
+		glw::Context::enable(glw::CapabilityType::Blend);
+		glw::Context::blend_func(glw::BlendFuncType::SrcAlpha, glw::BlendFuncType::OneMinusSrcAlpha);
+	}
+
+	void Server::_apply_auto_format(glw::TextureConfig& _cfg, int _channels) {
+		switch (_channels) {
+		case (4): {
+			_cfg.FormatInternal = glw::InternalFormat::RGBA;
+			_cfg.FormatTexture = glw::TextureFormat::RGBA;
+			break;
+		}
+		case (3): {
+			_cfg.FormatInternal = glw::InternalFormat::RGB;
+			_cfg.FormatTexture = glw::TextureFormat::RGB;
+			break;
+		}
+		case (1): {
+			_cfg.FormatInternal = glw::InternalFormat::Red;
+			_cfg.FormatTexture = glw::TextureFormat::Red;
+			break;
+		}
+		default: {
+			break;
+		}
+		}
+	}
+
+	TextureImage Server::_load_texture_image(const std::string& _path, bool _auto_format, glw::TextureConfig& _cfg) const {
+		TextureImage _image;
+		int _width = 0, _height = 0, _channels = 0;
+		const std::string _extension = std::filesystem::path(_path).extension().string();
+		if (const unsigned char* _packed = this->_find_packed_image(_path, _auto_format, _cfg, _width, _height, _channels)) {
+			_image.Compressed = false;
+			_image.Channels = static_cast<uint32_t>(_channels);
+			_image.Levels.push_back({ _packed, static_cast<size_t>(_width) * _height * _channels, static_cast<uint32_t>(_width), static_cast<uint32_t>(_height) });
+		}
+		else if (_extension == ".dds" || _extension == ".DDS" || _extension == ".ktx2" || _extension == ".KTX2") {
+			_image = (_extension == ".dds" || _extension == ".DDS") ? Server::_load_dds(_path) : Server::_load_ktx2(_path);
+			if (_cfg.FilpY && Server::_flip_compressed_image(_image) == false) {
+				throw exception::TextureFileLoadingFailure(_path, "Cannot flip this format, load it with FilpY off");
+			}
+		}
+		else if (m_texture_cache_directory.empty() == false) {
+			_image = this->_load_cached_image(_path, _auto_format, _cfg);
+		}
+		else {
+			_image = Server::_decode_image(_path, _auto_format, _cfg);
+			if (glw::Texture::is_compressed(_cfg.FormatInternal)) {
+				Server::_encode_image(_image, _cfg);
+			}
+		}
+
+		if (_image.Compressed) {
+			_cfg.FormatInternal = _image.FormatInternal;
+		}
+		else {
+			_image.FormatInternal = _cfg.FormatInternal;
+			_image.FormatTexture = _cfg.FormatTexture;
+			_image.FormatData = _cfg.FormatData;
+			/* Other data types keep a single level, which glw::Texture hands to glGenerateMipmap */
+			if (_cfg.MipmapGeneration && _cfg.FormatData == glw::DataType::UnsignedByte && _image.Levels.size() == 1ULL) {
+				Server::_build_mip_chain(_image);
+			}
+		}
+		return _image;
+	}
+
+	TextureImage Server::_load_cached_image(const std::string& _path, bool _auto_format, glw::TextureConfig& _cfg) const {
+		std::error_code _error;
+		const auto _mtime = std::filesystem::last_write_time(_path, _error);
+		const std::string _key =
+			_path + "|" +
+			std::to_string(_error ? 0 : static_cast<long long>(_mtime.time_since_epoch().count())) + "|" +
+			std::to_string(_auto_format) + "|" +
+			std::to_string(static_cast<uint32_t>(_cfg.MagFilter)) + "|" +
+			std::to_string(static_cast<uint32_t>(_cfg.MinFilter)) + "|" +
+			std::to_string(static_cast<uint32_t>(_cfg.WrappingS)) + "|" +
+			std::to_string(static_cast<uint32_t>(_cfg.WrappingT)) + "|" +
+			std::to_string(static_cast<uint32_t>(_cfg.FormatInternal)) + "|" +
+			std::to_string(static_cast<uint32_t>(_cfg.FormatTexture)) + "|" +
+			std::to_string(static_cast<uint32_t>(_cfg.FormatData)) + "|" +
+			std::to_string(_cfg.MipmapGeneration) + "|" +
+			std::to_string(_cfg.FilpY);
+		const std::filesystem::path _cache_path = std::filesystem::path(m_texture_cache_directory) / (std::to_string(std::hash<std::string>{}(_key)) + ".glwt");
+
+		TextureImage _image;
+		if (Server::_read_texture_cache(_cache_path, _key, _image)) {
+			_cfg.FormatInternal = _image.FormatInternal;
+			_cfg.FormatTexture = _image.FormatTexture;
+			_cfg.FormatData = _image.FormatData;
+			return _image;
+		}
+
+		_image = Server::_decode_image(_path, _auto_format, _cfg);
+		Server::_encode_image(_image, _cfg);
+
+		std::filesystem::create_directories(m_texture_cache_directory, _error);
+		Server::_write_texture_cache(_cache_path, _key, _image);
+		return _image;
+	}
+
+	TextureImage Server::_decode_image(const std::string& _path, bool _auto_format, glw::TextureConfig& _cfg) {
+		int _width = 0, _height = 0, _channels = 0;
+		unsigned char* _data = Server::_load_image(_path, _auto_format, _cfg, _width, _height, _channels);
+
+		TextureImage _image;
+		_image.FormatInternal = _cfg.FormatInternal;
+		_image.FormatTexture = _cfg.FormatTexture;
+		_image.FormatData = _cfg.FormatData;
+		_image.Channels = static_cast<uint32_t>(_channels);
+		_image.Compressed = false;
+		_image.Data.assign(_data, _data + static_cast<size_t>(_width) * _height * _channels);
+		_image.Levels.push_back({ _image.Data.data(), _image.Data.size(), static_cast<uint32_t>(_width), static_cast<uint32_t>(_height) });
+		stbi_image_free(_data);
+		return _image;
+	}
+
+	void Server::_encode_image(TextureImage& _image, const glw::TextureConfig& _cfg) {
+		/* Let the driver encode (and build mipmaps for) the decoded level, then keep what it produced */
+		const glw::CompressedTextureLevel& _base = _image.Levels[0];
+		glw::Texture* _tex = new glw::Texture(_cfg, _base.Data, _base.Width, _base.Height, _image.Channels);
+
+		TextureImage _encoded;
+		_encoded.FormatTexture = _image.FormatTexture;
+		_encoded.FormatData = _image.FormatData;
+		_encoded.Channels = _image.Channels;
+
+		std::vector<unsigned char> _level_data;
+		std::vector<glw::CompressedTextureLevel> _level_sizes;
+		uint32_t _level_width = 0U, _level_height = 0U;
+		for (uint32_t i = 0; i < _tex->levels(); i++) {
+			if (_tex->read_compressed_level(i, _level_data, _level_width, _level_height, _encoded.FormatInternal) == false) {
+				break;
+			}
+			_level_sizes.push_back({ nullptr, _level_data.size(), _level_width, _level_height });
+			_encoded.Data.insert(_encoded.Data.end(), _level_data.begin(), _level_data.end());
+		}
+		delete _tex;
+		if (_level_sizes.empty()) {
+			return;
+		}
+
+		size_t _offset = 0ULL;
+		for (auto& _level : _level_sizes) {
+			_level.Data = _encoded.Data.data() + _offset;
+			_offset += _level.Length;
+		}
+		_encoded.Levels = std::move(_level_sizes);
+		_image = std::move(_encoded);
+	}
+
+	void Server::_build_mip_chain(TextureImage& _image) {
+		const glw::CompressedTextureLevel _base = _image.Levels[0];
+		const uint32_t _channels = _image.Channels;
+		const bool _owns_base = (_image.Data.empty() == false);
+
+		std::vector<glw::CompressedTextureLevel> _levels { _base };
+		size_t _length = (_owns_base ? _base.Length : 0ULL);
+		for (uint32_t _width = _base.Width, _height = _base.Height; _width > 1U || _height > 1U; ) {
+			_width = std::max(_width >> 1U, 1U);
+			_height = std::max(_height >> 1U, 1U);
+			_levels.push_back({ nullptr, static_cast<size_t>(_width) * _height * _channels, _width, _height });
+			_length += _levels.back().Length;
+		}
+
+		std::vector<unsigned char> _data(_length);
+		size_t _offset = 0ULL;
+		if (_owns_base) {
+			std::copy(_base.Data, _base.Data + _base.Length, _data.begin());
+			_levels[0].Data = _data.data();
+			_offset = _base.Length;
+		}
+		for (size_t i = 1; i < _levels.size(); i++) {
+			unsigned char* _dst = _data.data() + _offset;
+			_levels[i].Data = _dst;
+			_offset += _levels[i].Length;
+
+			/* 2x2 box filter, clamped at odd edges */
+			const glw::CompressedTextureLevel& _src = _levels[i - 1];
+			for (uint32_t y = 0; y < _levels[i].Height; y++) {
+				const uint32_t _y0 = std::min(y * 2U, _src.Height - 1U), _y1 = std::min(y * 2U + 1U, _src.Height - 1U);
+				for (uint32_t x = 0; x < _levels[i].Width; x++) {
+					const uint32_t _x0 = std::min(x * 2U, _src.Width - 1U), _x1 = std::min(x * 2U + 1U, _src.Width - 1U);
+					for (uint32_t c = 0; c < _channels; c++) {
+						const uint32_t _sum =
+							_src.Data[(static_cast<size_t>(_y0) * _src.Width + _x0) * _channels + c] +
+							_src.Data[(static_cast<size_t>(_y0) * _src.Width + _x1) * _channels + c] +
+							_src.Data[(static_cast<size_t>(_y1) * _src.Width + _x0) * _channels + c] +
+							_src.Data[(static_cast<size_t>(_y1) * _src.Width + _x1) * _channels + c];
+						_dst[(static_cast<size_t>(y) * _levels[i].Width + x) * _channels + c] = static_cast<unsigned char>((_sum + 2U) >> 2U);
+					}
+				}
+			}
+		}
+		_image.Data = std::move(_data);
+		_image.Levels = std::move(_levels);
+	}
+
+	void Server::_reload_texture(TextureResidency& _residency) {
+		glw::TextureConfig _cfg = _residency.Config;
+		_residency.Image = this->_load_texture_image(_residency.Path, _residency.AutoFormat, _cfg);
+
+		glw::Texture* _tex = _residency.Texture;
+		if (_residency.Image.Levels.size() != _tex->levels() || _residency.Image.Levels[0].Width != _tex->width() || _residency.Image.Levels[0].Height != _tex->height()) {
+			throw exception::TextureFileLoadingFailure(_residency.Path, "Source changed size since it was first loaded");
+		}
+		const uint32_t _first_level = Server::_get_streaming_first_level(_residency.Image);
+		for (uint32_t i = _tex->levels(); i > _first_level; i--) {
+			_tex->set_level(i - 1U, _residency.Image.Levels[i - 1U]);
+			_residency.ResidentBytes += _residency.Image.Levels[i - 1U].Length;
+		}
+		m_texture_memory_usage += _residency.ResidentBytes;
+		if (_first_level == 0U) {
+			_residency.Image = TextureImage();
+		}
+	}
+
+	uint32_t Server::_get_streaming_first_level(const TextureImage& _image) {
+		uint32_t _level = 0U;
+		while (_level + 1U < _image.Levels.size() && std::max(_image.Levels[_level].Width, _image.Levels[_level].Height) > Server::streaming_base_size) {
+			_level++;
+		}
+		return _level;
+	}
+
+	TextureImage Server::_load_dds(const std::string& _path) {
+		std::ifstream _file(_path, std::ios::binary);
+		if (_file.is_open() == false) {
+			throw exception::TextureFileLoadingFailure(_path, "Cannot open file");
+		}
+		std::vector<unsigned char> _bytes((std::istreambuf_iterator<char>(_file)), std::istreambuf_iterator<char>());
+		auto _u32 = [&_bytes](size_t _offset) -> uint32_t {
+			return _bytes[_offset] | (_bytes[_offset + 1] << 8) | (_bytes[_offset + 2] << 16) | (static_cast<uint32_t>(_bytes[_offset + 3]) << 24);
+		};
+		if (_bytes.size() < 128ULL || _u32(0) != 0x20534444U) {
+			throw exception::TextureFileLoadingFailure(_path, "Not a DDS file");
+		}
+
+		TextureImage _image;
+		const uint32_t _height = _u32(12);
+		const uint32_t _width = _u32(16);
+		const uint32_t _level_count = (_u32(28) == 0U ? 1U : _u32(28));
+		size_t _offset = 128ULL;
+		switch (_u32(84)) {
+		case (0x31545844U): {
+			_image.FormatInternal = glw::InternalFormat::CompressedRGBAS3TCDXT1;
+			break;
+		}
+		case (0x35545844U): {
+			_image.FormatInternal = glw::InternalFormat::CompressedRGBAS3TCDXT5;
+			break;
+		}
+		case (0x30315844U): {
+			if (_bytes.size() < 148ULL) {
+				throw exception::TextureFileLoadingFailure(_path, "Truncated DX10 header");
+			}
+			_offset = 148ULL;
+			switch (_u32(128)) {
+			case (71): {
+				_image.FormatInternal = glw::InternalFormat::CompressedRGBAS3TCDXT1;
+				break;
+			}
+			case (72): {
+				_image.FormatInternal = glw::InternalFormat::CompressedSRGBAS3TCDXT1;
+				break;
+			}
+			case (77): {
+				_image.FormatInternal = glw::InternalFormat::CompressedRGBAS3TCDXT5;
+				break;
+			}
+			case (78): {
+				_image.FormatInternal = glw::InternalFormat::CompressedSRGBAS3TCDXT5;
+				break;
+			}
+			case (98): {
+				_image.FormatInternal = glw::InternalFormat::CompressedRGBABPTC;
+				break;
+			}
+			case (99): {
+				_image.FormatInternal = glw::InternalFormat::CompressedSRGBABPTC;
+				break;
+			}
+			default: {
+				throw exception::TextureFileLoadingFailure(_path, "Unsupported DXGI format");
+			}
+			}
+			break;
+		}
+		default: {
+			throw exception::TextureFileLoadingFailure(_path, "Unsupported DDS format");
+		}
+		}
+
+		const size_t _block_size = Server::_get_block_size(_image.FormatInternal);
+		_image.Data.assign(_bytes.begin() + _offset, _bytes.end());
+		size_t _position = 0ULL;
+		for (uint32_t i = 0; i < _level_count; i++) {
+			const uint32_t _level_width = (_width >> i) > 0U ? (_width >> i) : 1U;
+			const uint32_t _level_height = (_height >> i) > 0U ? (_height >> i) : 1U;
+			const size_t _length = ((_level_width + 3ULL) / 4ULL) * ((_level_height + 3ULL) / 4ULL) * _block_size;
+			if (_position + _length > _image.Data.size()) {
+				break;
+			}
+			_image.Levels.push_back({ _image.Data.data() + _position, _length, _level_width, _level_height });
+			_position += _length;
+		}
+		if (_image.Levels.empty()) {
+			throw exception::TextureFileLoadingFailure(_path, "Truncated image data");
+		}
+		return _image;
+	}
+
+	TextureImage Server::_load_ktx2(const std::string& _path) {
+		static constexpr unsigned char _identifier[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+
+		std::ifstream _file(_path, std::ios::binary);
+		if (_file.is_open() == false) {
+			throw exception::TextureFileLoadingFailure(_path, "Cannot open file");
+		}
+		TextureImage _image;
+		_image.Data.assign((std::istreambuf_iterator<char>(_file)), std::istreambuf_iterator<char>());
+		const std::vector<unsigned char>& _bytes = _image.Data;
+		auto _u32 = [&_bytes](size_t _offset) -> uint32_t {
+			return _bytes[_offset] | (_bytes[_offset + 1] << 8) | (_bytes[_offset + 2] << 16) | (static_cast<uint32_t>(_bytes[_offset + 3]) << 24);
+		};
+		auto _u64 = [&_u32](size_t _offset) -> uint64_t {
+			return _u32(_offset) | (static_cast<uint64_t>(_u32(_offset + 4)) << 32);
+		};
+		if (_bytes.size() < 80ULL || std::equal(std::begin(_identifier), std::end(_identifier), _bytes.begin()) == false) {
+			throw exception::TextureFileLoadingFailure(_path, "Not a KTX2 file");
+		}
+		if (_u32(28) > 1U || _u32(32) > 1U || _u32(36) != 1U) {
+			throw exception::TextureFileLoadingFailure(_path, "Only single 2D images are supported");
+		}
+		if (_u32(44) != 0U) {
+			throw exception::TextureFileLoadingFailure(_path, "Supercompressed data is not supported");
+		}
+
+		switch (_u32(12)) {
+		case (131): {
+			_image.FormatInternal = glw::InternalFormat::CompressedRGBS3TCDXT1;
+			break;
+		}
+		case (133): {
+			_image.FormatInternal = glw::InternalFormat::CompressedRGBAS3TCDXT1;
+			break;
+		}
+		case (134): {
+			_image.FormatInternal = glw::InternalFormat::CompressedSRGBAS3TCDXT1;
+			break;
+		}
+		case (137): {
+			_image.FormatInternal = glw::InternalFormat::CompressedRGBAS3TCDXT5;
+			break;
+		}
+		case (138): {
+			_image.FormatInternal = glw::InternalFormat::CompressedSRGBAS3TCDXT5;
+			break;
+		}
+		case (145): {
+			_image.FormatInternal = glw::InternalFormat::CompressedRGBABPTC;
+			break;
+		}
+		case (146): {
+			_image.FormatInternal = glw::InternalFormat::CompressedSRGBABPTC;
+			break;
+		}
+		case (147): {
+			_image.FormatInternal = glw::InternalFormat::CompressedRGB8ETC2;
+			break;
+		}
+		case (148): {
+			_image.FormatInternal = glw::InternalFormat::CompressedSRGB8ETC2;
+			break;
+		}
+		case (151): {
+			_image.FormatInternal = glw::InternalFormat::CompressedRGBA8ETC2EAC;
+			break;
+		}
+		case (152): {
+			_image.FormatInternal = glw::InternalFormat::CompressedSRGB8A8ETC2EAC;
+			break;
+		}
+		default: {
+			throw exception::TextureFileLoadingFailure(_path, "Unsupported VkFormat");
+		}
+		}
+
+		const uint32_t _width = _u32(20);
+		const uint32_t _height = _u32(24);
+		const uint32_t _level_count = (_u32(40) == 0U ? 1U : _u32(40));
+		if (_bytes.size() < 80ULL + 24ULL * _level_count) {
+			throw exception::TextureFileLoadingFailure(_path, "Truncated level index");
+		}
+		for (uint32_t i = 0; i < _level_count; i++) {
+			const uint64_t _offset = _u64(80ULL + 24ULL * i);
+			const uint64_t _length = _u64(80ULL + 24ULL * i + 8ULL);
+			if (_offset + _length > _bytes.size()) {
+				throw exception::TextureFileLoadingFailure(_path, "Truncated image data");
+			}
+			const uint32_t _level_width = (_width >> i) > 0U ? (_width >> i) : 1U;
+			const uint32_t _level_height = (_height >> i) > 0U ? (_height >> i) : 1U;
+			_image.Levels.push_back({ _bytes.data() + _offset, static_cast<size_t>(_length), _level_width, _level_height });
+		}
+		return _image;
+	}
+
+	bool Server::_flip_compressed_image(TextureImage& _image) {
+		bool _alpha_block = false;
+		switch (_image.FormatInternal) {
+		case (glw::InternalFormat::CompressedRGBS3TCDXT1):
+		case (glw::InternalFormat::CompressedRGBAS3TCDXT1):
+		case (glw::InternalFormat::CompressedSRGBAS3TCDXT1): {
+			break;
+		}
+		case (glw::InternalFormat::CompressedRGBAS3TCDXT5):
+		case (glw::InternalFormat::CompressedSRGBAS3TCDXT5): {
+			_alpha_block = true;
+			break;
+		}
+		default: {
+			return false;
+		}
+		}
+		/* A block row mixing texel rows of two source blocks would need both of their endpoints */
+		for (const auto& _level : _image.Levels) {
+			if (_level.Height > 4U && _level.Height % 4U != 0U) {
+				return false;
+			}
+		}
+
+		const size_t _block_size = Server::_get_block_size(_image.FormatInternal);
+		for (const auto& _level : _image.Levels) {
+			unsigned char* _data = _image.Data.data() + (_level.Data - _image.Data.data());
+			const size_t _block_rows = (_level.Height + 3ULL) / 4ULL;
+			const size_t _row_length = ((_level.Width + 3ULL) / 4ULL) * _block_size;
+			if (_block_rows * _row_length > _level.Length) {
+				continue;
+			}
+			for (size_t y = 0; y < _block_rows / 2ULL; y++) {
+				std::swap_ranges(_data + y * _row_length, _data + (y + 1ULL) * _row_length, _data + (_block_rows - 1ULL - y) * _row_length);
+			}
+			/* Levels under four texels tall only use the top rows of their blocks */
+			const uint32_t _texel_rows = std::min(_level.Height, 4U);
+			for (unsigned char* _block = _data; _block < _data + _block_rows * _row_length; _block += _block_size) {
+				unsigned char* _color = _block;
+				if (_alpha_block) {
+					/* Two alpha endpoints, then sixteen 3-bit indices packed little-endian, 12 bits per row */
+					uint64_t _bits = 0ULL;
+					for (size_t i = 0; i < 6; i++) {
+						_bits |= static_cast<uint64_t>(_block[2 + i]) << (8 * i);
+					}
+					uint64_t _flipped = _bits;
+					for (uint32_t r = 0; r < _texel_rows; r++) {
+						const uint64_t _row = (_bits >> (12 * r)) & 0xFFFULL;
+						const uint32_t _target = _texel_rows - 1U - r;
+						_flipped = (_flipped & ~(0xFFFULL << (12 * _target))) | (_row << (12 * _target));
+					}
+					for (size_t i = 0; i < 6; i++) {
+						_block[2 + i] = static_cast<unsigned char>(_flipped >> (8 * i));
+					}
+					_color += 8;
+				}
+				/* Two color endpoints, then one byte of 2-bit indices per row */
+				std::reverse(_color + 4, _color + 4 + _texel_rows);
+			}
+		}
+		return true;
+	}
+
+	bool Server::_read_texture_cache(const std::filesystem::path& _path, const std::string& _key, TextureImage& _out) {
+		std::ifstream _file(_path, std::ios::binary);
+		if (_file.is_open() == false) {
+			return false;
+		}
+		auto _read_u32 = [&_file]() -> uint32_t {
+			uint32_t _value = 0U;
+			_file.read(reinterpret_cast<char*>(&_value), sizeof(_value));
+			return _value;
+		};
+		if (_read_u32() != s_texture_cache_magic || _read_u32() != s_texture_cache_version) {
+			return false;
+		}
+		const uint32_t _key_length = _read_u32();
+		if (_key_length != _key.size()) {
+			return false;
+		}
+		std::string _stored_key(_key_length, '\0');
+		_file.read(_stored_key.data(), static_cast<std::streamsize>(_stored_key.size()));
+		if (_file.good() == false || _stored_key != _key) {
+			return false;
+		}
+
+		_out.FormatInternal = static_cast<glw::InternalFormat>(_read_u32());
+		_out.FormatTexture = static_cast<glw::TextureFormat>(_read_u32());
+		_out.FormatData = static_cast<glw::DataType>(_read_u32());
+		_out.Channels = _read_u32();
+		_out.Compressed = (_read_u32() != 0U);
+		const uint32_t _level_count = _read_u32();
+
+		std::vector<glw::CompressedTextureLevel> _levels(_level_count);
+		for (auto& _level : _levels) {
+			_level.Width = _read_u32();
+			_level.Height = _read_u32();
+			_level.Length = _read_u32();
+		}
+		size_t _total = 0ULL;
+		for (const auto& _level : _levels) {
+			_total += _level.Length;
+		}
+		_out.Data.resize(_total);
+		_file.read(reinterpret_cast<char*>(_out.Data.data()), static_cast<std::streamsize>(_total));
+		if (_file.good() == false || _levels.empty()) {
+			return false;
+		}
+
+		size_t _offset = 0ULL;
+		for (auto& _level : _levels) {
+			_level.Data = _out.Data.data() + _offset;
+			_offset += _level.Length;
+		}
+		_out.Levels = std::move(_levels);
+		return true;
+	}
+
+	void Server::_write_texture_cache(const std::filesystem::path& _path, const std::string& _key, const TextureImage& _image) {
+		std::ofstream _file(_path, std::ios::binary | std::ios::trunc);
+		if (_file.is_open() == false) {
+			return;
+		}
+		auto _write_u32 = [&_file](uint32_t _value) {
+			_file.write(reinterpret_cast<const char*>(&_value), sizeof(_value));
+		};
+		_write_u32(s_texture_cache_magic);
+		_write_u32(s_texture_cache_version);
+		_write_u32(static_cast<uint32_t>(_key.size()));
+		_file.write(_key.data(), static_cast<std::streamsize>(_key.size()));
+
+		_write_u32(static_cast<uint32_t>(_image.FormatInternal));
+		_write_u32(static_cast<uint32_t>(_image.FormatTexture));
+		_write_u32(static_cast<uint32_t>(_image.FormatData));
+		_write_u32(_image.Channels);
+		_write_u32(_image.Compressed ? 1U : 0U);
+		_write_u32(static_cast<uint32_t>(_image.Levels.size()));
+		for (const auto& _level : _image.Levels) {
+			_write_u32(_level.Width);
+			_write_u32(_level.Height);
+			_write_u32(static_cast<uint32_t>(_level.Length));
+		}
+		for (const auto& _level : _image.Levels) {
+			_file.write(reinterpret_cast<const char*>(_level.Data), static_cast<std::streamsize>(_level.Length));
+		}
+	}
+
+	size_t Server::_get_block_size(const glw::InternalFormat& _format) {
+		switch (_format) {
+		case (glw::InternalFormat::CompressedRGBS3TCDXT1):
+		case (glw::InternalFormat::CompressedRGBAS3TCDXT1):
+		case (glw::InternalFormat::CompressedSRGBAS3TCDXT1):
+		case (glw::InternalFormat::CompressedRGB8ETC2):
+		case (glw::InternalFormat::CompressedSRGB8ETC2): {
+			return 8ULL;
+		}
+		default: {
+			break;
+		}
+		}
+		return 16ULL;
+	}
+
+	glw::Program* Server::_submit_program(const char* _vert, const char* _frag, const char* const* _varyings, uint32_t _varying_count) {
+		PendingProgram _pending;
+		_pending.Program = new glw::Program();
+		_pending.Sources = { _vert, _frag };
+		for (uint32_t i = 0; i < _varying_count; i++) {
+			_pending.Sources.emplace_back(_varyings[i]);
+		}
+		if (m_program_cache != nullptr && m_program_cache->load(_pending.Program, _pending.Sources)) {
+			_pending.Cached = true;
+			m_pending_programs.emplace_back(std::move(_pending));
+			return m_pending_programs.back().Program;
+		}
+
+		/* Shaders shared by several programs are compiled once, keyed by their source */
+		const glw::Shader& _vertex_shader = m_pending_shaders.try_emplace(_vert, glw::ShaderType::Vertex, _vert, true).first->second;
+		_pending.Program->attach(&_vertex_shader);
+		_pending.Shaders.emplace_back(&_vertex_shader);
+		if (_frag != nullptr) {
+			const glw::Shader& _fragment_shader = m_pending_shaders.try_emplace(_frag, glw::ShaderType::Fragment, _frag, true).first->second;
+			_pending.Program->attach(&_fragment_shader);
+			_pending.Shaders.emplace_back(&_fragment_shader);
+		}
+		if (_varying_count != 0U) {
+			_pending.Program->set_transform_feedback_varyings(_varyings, _varying_count);
+		}
+		if (m_program_cache != nullptr) {
+			_pending.Program->set_binary_retrievable();
+		}
+		_pending.Program->link_deferred();
+		m_pending_programs.emplace_back(std::move(_pending));
+		return m_pending_programs.back().Program;
+	}
+
+	void Server::_finish_programs() {
+		for (bool _busy = true; _busy; ) {
+			_busy = false;
+			for (const auto& _pending : m_pending_programs) {
+				if (_pending.Cached == false && _pending.Program->is_link_complete() == false) {
+					_busy = true;
+					break;
+				}
+			}
+			if (_busy) {
+				std::this_thread::yield();
+			}
+		}
+		for (const auto& _pending : m_pending_programs) {
+			if (_pending.Cached) {
+				continue;
+			}
+			/* Compile errors first, they explain a failed link better than the link log */
+			for (const auto& _shader : _pending.Shaders) {
+				_shader->check_compile_status();
+			}
+			_pending.Program->check_link_status();
+			if (m_program_cache != nullptr) {
+				m_program_cache->store(_pending.Program, _pending.Sources);
+			}
+		}
+		m_pending_programs.clear();
+		m_pending_shaders.clear();
+		m_pending_sources.clear();
+	}
+
+	glw::Program* Server::_submit_quad_program(ShaderFeature _features) {
+		const std::string _header = Server::_make_shader_header(_features);
+		const std::string& _vert = m_pending_sources.emplace_back(_header + s_quad_vert);
+		const std::string& _frag = m_pending_sources.emplace_back(_header + s_quad_frag);
+		glw::Program* _program = this->_submit_program(_vert.c_str(), _frag.c_str());
+		m_quad_program_map[_features] = _program;
+		m_programs.emplace_back(_program);
+		return _program;
+	}
+
+	void Server::_register_quad_uniforms(glw::Program* _program, ShaderFeature _features) {
+		if ((_features & ShaderFeature::Instanced) != ShaderFeature::None) {
+			_program->register_uniform("uViewProj");
+		}
+		else {
+			_program->register_uniform("uMVP");
+			_program->register_uniform("uSize");
+			_program->register_uniform("uModulate");
+			if ((_features & ShaderFeature::Textured) == ShaderFeature::None) {
+				_program->register_uniform("uColor");
+			}
+		}
+		if ((_features & ShaderFeature::Shadow) != ShaderFeature::None) {
+			_program->register_uniform("uTexture");
+			_program->register_uniform("uShadowSlice");
+		}
+		const uint32_t _texture_count = static_cast<uint32_t>(_features & ShaderFeature::TextureCountMask) >> shader_texture_count_shift;
+		for (uint32_t i = 0; i < _texture_count; i++) {
+			_program->register_uniform("uTextures[" + std::to_string(i) + "]");
+		}
+		if (_texture_count == 0U && (_features & ShaderFeature::Textured) != ShaderFeature::None) {
+			_program->register_uniform("uTexture");
+		}
+	}
+
+	ShaderFeature Server::_normalize_shader_features(ShaderFeature _features) {
+		uint32_t _bits = static_cast<uint32_t>(_features);
+		const uint32_t _texture_count = (_bits & static_cast<uint32_t>(ShaderFeature::TextureCountMask)) >> shader_texture_count_shift;
+		_bits &= ~static_cast<uint32_t>(ShaderFeature::TextureCountMask);
+		_bits |= static_cast<uint32_t>(shader_texture_count(_texture_count));
+		if (_texture_count > 0U) {
+			_bits |= static_cast<uint32_t>(ShaderFeature::Textured);
+		}
+		if ((_bits & static_cast<uint32_t>(ShaderFeature::Rounded | ShaderFeature::Outlined)) != 0U) {
+			_bits |= static_cast<uint32_t>(ShaderFeature::Instanced);
+		}
+		if ((_bits & static_cast<uint32_t>(ShaderFeature::Shadow)) != 0U) {
+			_bits = static_cast<uint32_t>(ShaderFeature::Shadow | ShaderFeature::Instanced);
+		}
+		return static_cast<ShaderFeature>(_bits);
+	}
+
+	std::string Server::_make_shader_header(ShaderFeature _features) {
+		std::string _header = "#version 330 core\n";
+		if ((_features & ShaderFeature::Textured) != ShaderFeature::None) {
+			_header += "#define TEXTURED\n";
+		}
+		if ((_features & ShaderFeature::Instanced) != ShaderFeature::None) {
+			_header += "#define INSTANCED\n";
+		}
+		if ((_features & ShaderFeature::Rounded) != ShaderFeature::None) {
+			_header += "#define ROUNDED\n";
+		}
+		if ((_features & ShaderFeature::Outlined) != ShaderFeature::None) {
+			_header += "#define OUTLINED\n";
+		}
+		if ((_features & ShaderFeature::Shadow) != ShaderFeature::None) {
+			_header += "#define SHADOW\n";
+		}
+		const uint32_t _texture_count = static_cast<uint32_t>(_features & ShaderFeature::TextureCountMask) >> shader_texture_count_shift;
+		if (_texture_count > 0U) {
+			_header += "#define TEXTURE_COUNT " + std::to_string(_texture_count) + "\n";
+		}
+		return _header;
+	}
+
+	const glw::Program* Server::get_particle_update_program() const {
+		return m_particle_update_program;
+	}
+
+	const glw::ComputeProgram* Server::fetch_rect_batch_cull_program() {
+		if (m_rect_batch_cull_program == nullptr) {
+			glw::Shader _rect_batch_cull_comp{ glw::ShaderType::Compute, s_rect_batch_cull_comp };
+			m_rect_batch_cull_program = new glw::ComputeProgram(&_rect_batch_cull_comp);
+			m_rect_batch_cull_program->register_uniform("uMVP");
+			m_rect_batch_cull_program->register_uniform("uGroupCount");
+			m_programs.emplace_back(m_rect_batch_cull_program);
+		}
+		return m_rect_batch_cull_program;
+	}
+
+	const glw::Program* Server::fetch_quad_program(ShaderFeature _features) {
+		_features = Server::_normalize_shader_features(_features);
+		auto _cached = m_quad_program_map.find(_features);
+		if (_cached != m_quad_program_map.end()) {
+			return _cached->second;
+		}
+		glw::Program* _program = this->_submit_quad_program(_features);
+		this->_finish_programs();
+		this->_register_quad_uniforms(_program, _features);
+		if (m_shader_registry != nullptr) {
+			m_shader_registry->add_program(_program, "quad.vert", s_quad_vert, "quad.frag", s_quad_frag, { }, Server::_make_shader_header(_features));
+		}
+		return _program;
+	}
+
+	const glw::Program* Server::fetch_post_process_program(PostProcessPass _pass) {
+		auto _cached = m_post_process_program_map.find(_pass);
+		if (_cached != m_post_process_program_map.end()) {
+			return _cached->second;
+		}
+		const char* _frag = nullptr;
+		std::vector<const char*> _uniforms { };
+		switch (_pass) {
+		case (PostProcessPass::Downsample): {
+			_frag = s_downsample_frag;
+			_uniforms = { "uTexture", "uTexelSize", "uThreshold" };
+			break;
+		}
+		case (PostProcessPass::Blur): {
+			_frag = s_blur_frag;
+			_uniforms = { "uTexture", "uDirection", "uTapCount", "uOffsets", "uWeights" };
+			break;
+		}
+		case (PostProcessPass::Upsample): {
+			_frag = s_upsample_frag;
+			_uniforms = { "uTexture", "uTexelSize", "uIntensity" };
+			break;
+		}
+		case (PostProcessPass::Composite): {
+			_frag = s_composite_frag;
+			_uniforms = { "uTexture", "uBloom", "uIntensity" };
+			break;
+		}
+		case (PostProcessPass::RoundedMask): {
+			_frag = s_rounded_mask_frag;
+			_uniforms = { "uCenter", "uHalfSize", "uRadius" };
+			break;
+		}
+		}
+		glw::Program* _program = this->_submit_program(s_post_process_vert, _frag);
+		this->_finish_programs();
+		for (const auto& _uniform : _uniforms) {
+			_program->register_uniform(_uniform);
+		}
+		m_post_process_program_map[_pass] = _program;
+		m_programs.emplace_back(_program);
+		return _program;
+	}
+
+	PostProcess* Server::fetch_post_process() {
+		if (m_post_process == nullptr) {
+			m_post_process = new PostProcess(this);
+		}
+		return m_post_process;
+	}
+
+	void Server::enable_partial_redraw(uint32_t _width, uint32_t _height) {
+		if (_width == 0U || _height == 0U) {
+			return;
+		}
+		this->disable_partial_redraw();
+		RenderTargetDesc _desc;
+		_desc.Width = _width;
+		_desc.Height = _height;
+		_desc.Filter = glw::FilterType::Nearest;
+		const uint32_t _previous = glw::Context::get_frame_buffer_binding();
+		m_partial_redraw_texture = new glw::Texture(RenderTargetPool::make_texture_config(_desc), _width, _height, 1U);
+		m_partial_redraw_framebuffer = new glw::FrameBufferObject();
+		m_partial_redraw_framebuffer->bind();
+		m_partial_redraw_framebuffer->attach_texture(glw::AttachmentType::Color0, m_partial_redraw_texture);
+		glw::Context::bind_frame_buffer(_previous);
+		m_partial_redraw_width = _width;
+		m_partial_redraw_height = _height;
+		this->damage_all();
+	}
+
+	void Server::disable_partial_redraw() {
+		delete m_partial_redraw_framebuffer;
+		m_partial_redraw_framebuffer = nullptr;
+		delete m_partial_redraw_texture;
+		m_partial_redraw_texture = nullptr;
+		m_partial_redraw_width = 0U;
+		m_partial_redraw_height = 0U;
+		m_damaged = false;
+		m_damaged_all = false;
+	}
+
+	bool Server::get_partial_redraw_enabled() const {
+		return m_partial_redraw_framebuffer != nullptr;
+	}
+
+	void Server::add_damage(const glm::vec4& _rect, float _pixel_padding) {
+		if (m_partial_redraw_framebuffer == nullptr || m_damaged_all) {
+			return;
+		}
+		if (m_damaged == false) {
+			m_damage = _rect;
+			m_damage_padding = _pixel_padding;
+			m_damaged = true;
+			return;
+		}
+		m_damage = { std::min(m_damage.x, _rect.x), std::min(m_damage.y, _rect.y), std::max(m_damage.z, _rect.z), std::max(m_damage.w, _rect.w) };
+		m_damage_padding = std::max(m_damage_padding, _pixel_padding);
+	}
+
+	void Server::damage_all() {
+		if (m_partial_redraw_framebuffer == nullptr) {
+			return;
+		}
+		m_damaged_all = true;
+	}
+
+	bool Server::begin_partial_redraw(Camera2D* _cam, const glm::vec4& _clear_color) {
+		if (m_partial_redraw_framebuffer == nullptr) {
+			throw exception::PartialRedrawFailure("Not enabled");
+		}
+		if (m_damaged == false && m_damaged_all == false) {
+			return false;
+		}
+		m_frame_view_proj_matrix = (_cam != nullptr ? _cam->get_view_proj_matrix() : Camera2D::get_default_view_proj_matrix(m_initial_window_width, m_initial_window_height));
+		if (m_damaged_all) {
+			m_frame_damage = { 0, 0, static_cast<int>(m_partial_redraw_width), static_cast<int>(m_partial_redraw_height) };
+		}
+		else {
+			m_frame_damage = Server::_project_rect(m_damage, m_damage_padding, m_frame_view_proj_matrix, m_partial_redraw_width, m_partial_redraw_height);
+		}
+		m_damaged = false;
+		m_damaged_all = false;
+		if (m_frame_damage.z <= m_frame_damage.x || m_frame_damage.w <= m_frame_damage.y) {
+			return false;
+		}
+
+		m_partial_redraw_framebuffer->bind();
+		glw::Context::viewport(0, 0, m_partial_redraw_width, m_partial_redraw_height);
+		glw::Context::enable(glw::CapabilityType::Scissor);
+		glw::Context::set_scissor(m_frame_damage.x, m_frame_damage.y, static_cast<uint32_t>(m_frame_damage.z - m_frame_damage.x), static_cast<uint32_t>(m_frame_damage.w - m_frame_damage.y));
+		glw::Context::clear_color(_clear_color.r, _clear_color.g, _clear_color.b, _clear_color.a);
+		glw::Context::clear_buffer(glw::BufferType::Color);
+		return true;
+	}
+
+	void Server::end_partial_redraw() {
+		if (m_partial_redraw_framebuffer == nullptr) {
+			throw exception::PartialRedrawFailure("Not enabled");
+		}
+		/* The scissor test applies to blits too */
+		glw::Context::disable(glw::CapabilityType::Scissor);
+		m_partial_redraw_framebuffer->blit_to(nullptr, m_partial_redraw_width, m_partial_redraw_height);
+		m_frame_damage = { 0, 0, 0, 0 };
+	}
+
+	bool Server::intersects_damage(const Object* _object) const {
+		if (m_partial_redraw_framebuffer == nullptr) {
+			return true;
+		}
+		glm::vec4 _bounds;
+		if (_object->get_bounds(_bounds) == false) {
+			return true;
+		}
+		const glm::ivec4 _pixels = Server::_project_rect(_bounds, _object->get_bounds_padding(), m_frame_view_proj_matrix, m_partial_redraw_width, m_partial_redraw_height);
+		return _pixels.x < m_frame_damage.z && m_frame_damage.x < _pixels.z && _pixels.y < m_frame_damage.w && m_frame_damage.y < _pixels.w;
+	}
+
+	glm::ivec4 Server::_project_rect(const glm::vec4& _rect, float _pixel_padding, const glm::mat4& _view_proj_matrix, uint32_t _width, uint32_t _height) {
+		const glm::vec2 _corners[4] = { { _rect.x, _rect.y }, { _rect.z, _rect.y }, { _rect.z, _rect.w }, { _rect.x, _rect.w } };
+		glm::vec2 _min(std::numeric_limits<float>::max());
+		glm::vec2 _max(std::numeric_limits<float>::lowest());
+		for (const auto& _corner : _corners) {
+			const glm::vec4 _clip = _view_proj_matrix * glm::vec4(_corner, 0.0f, 1.0f);
+			const glm::vec2 _pixel = (glm::vec2(_clip) / _clip.w * 0.5f + 0.5f) * glm::vec2(static_cast<float>(_width), static_cast<float>(_height));
+			_min = glm::min(_min, _pixel);
+			_max = glm::max(_max, _pixel);
+		}
+		/* One more pixel covers anti-aliased edges and pixel snapping */
+		const float _padding = _pixel_padding + 1.0f;
+		return {
+			static_cast<int>(std::clamp(std::floor(_min.x - _padding), 0.0f, static_cast<float>(_width))),
+			static_cast<int>(std::clamp(std::floor(_min.y - _padding), 0.0f, static_cast<float>(_height))),
+			static_cast<int>(std::clamp(std::ceil(_max.x + _padding), 0.0f, static_cast<float>(_width))),
+			static_cast<int>(std::clamp(std::ceil(_max.y + _padding), 0.0f, static_cast<float>(_height)))
+		};
+	}
+
+	Object::Object(Server* _owner)
+		: m_owner(_owner)
+	{
+		this->_update_model_matrix();
+	}
+
+	Object::~Object() {
+		/* get_bounds() is not available here anymore, so the last reported bounds stand in for it */
+		if (m_owner == nullptr || m_owner->get_partial_redraw_enabled() == false || m_need_initial_damage) {
+			return;
+		}
+		if (m_has_damaged_bounds) {
+			m_owner->add_damage(m_damaged_bounds, m_damaged_padding);
+		}
+		else {
+			m_owner->damage_all();
+		}
+	}
+
+	void Object::update() {
+		if (m_need_to_update_model_matrix) {
+			m_need_to_update_model_matrix = false;
+			this->_update_model_matrix();
+		}
+		if (m_need_initial_damage && m_owner != nullptr && m_owner->get_partial_redraw_enabled()) {
+			m_need_initial_damage = false;
+			this->_damage();
+		}
+	}
+
+	void Object::draw(Camera2D* _cam) {
+		/* Drawn without an update() first. The damage lands in the next frame. */
+		if (m_need_initial_damage && m_owner != nullptr && m_owner->get_partial_redraw_enabled()) {
+			m_need_initial_damage = false;
+			this->_damage();
+		}
+	}
+
+	void Object::set_position(const glm::vec2& _value) {
+		this->_damage();
+		m_position = _value;
+		m_need_to_update_model_matrix = true;
+		this->_damage();
+	}
+
+	void Object::set_rotation(const float& _value) {
+		this->_damage();
+		m_rotation = _value;
+		m_need_to_update_model_matrix = true;
+		this->_damage();
+	}
+
+	void Object::set_scale(const glm::vec2& _value) {
+		this->_damage();
+		m_scale = _value;
+		m_need_to_update_model_matrix = true;
+		this->_damage();
+	}
+
+	void Object::set_modulate(const glm::vec4& _value) {
+		m_modulate = _value;
+		this->_damage();
+	}
+
+	Server* Object::fetch_owner() {
+		return m_owner;
+	}
+
+	const Server* Object::get_owner() const {
+		return m_owner;
+	}
+
+	const glm::vec2& Object::get_position() const {
+		return m_position;
+	}
+
+	const float& Object::get_rotation() const {
+		return m_rotation;
+	}
+
+	const glm::vec2& Object::get_scale() const {
+		return m_scale;
+	}
+
+	const glm::vec4& Object::get_modulate() const {
+		return m_modulate;
+	}
+
+	const glm::mat4& Object::get_model_matrix() const {
+		return m_model_matrix;
+	}
+
+	bool Object::get_bounds(glm::vec4&) const {
+		return false;
+	}
+
+	float Object::get_bounds_padding() const {
+		return 0.0f;
+	}
+
+	void Object::_damage() {
+		if (m_owner == nullptr || m_owner->get_partial_redraw_enabled() == false) {
+			return;
+		}
+		/* Setters only flag the model matrix, and the bounds must not lag behind them */
+		if (m_need_to_update_model_matrix) {
+			m_need_to_update_model_matrix = false;
+			this->_update_model_matrix();
+		}
+		glm::vec4 _bounds;
+		if (this->get_bounds(_bounds)) {
+			m_damaged_bounds = _bounds;
+			m_damaged_padding = this->get_bounds_padding();
+			m_has_damaged_bounds = true;
+			m_owner->add_damage(m_damaged_bounds, m_damaged_padding);
+		}
+		else {
+			m_has_damaged_bounds = false;
+			m_owner->damage_all();
+		}
+	}
+
+	void Object::_damage(const glm::vec2& _min, const glm::vec2& _max) {
+		if (m_owner == nullptr || m_owner->get_partial_redraw_enabled() == false) {
+			return;
+		}
+		if (m_need_to_update_model_matrix) {
+			m_need_to_update_model_matrix = false;
+			this->_update_model_matrix();
+		}
+		const glm::vec4 _bounds = this->_transform_bounds(_min, _max);
+		const float _padding = this->get_bounds_padding();
+		if (m_has_damaged_bounds) {
+			m_damaged_bounds = { std::min(m_damaged_bounds.x, _bounds.x), std::min(m_damaged_bounds.y, _bounds.y), std::max(m_damaged_bounds.z, _bounds.z), std::max(m_damaged_bounds.w, _bounds.w) };
+			m_damaged_padding = std::max(m_damaged_padding, _padding);
+		}
+		m_owner->add_damage(_bounds, _padding);
+	}
+
+	glm::vec4 Object::_transform_bounds(const glm::vec2& _min, const glm::vec2& _max) const {
+		const glm::vec4 _corners[4] = {
+			m_model_matrix * glm::vec4(_min.x, _min.y, 0.0f, 1.0f),
+			m_model_matrix * glm::vec4(_max.x, _min.y, 0.0f, 1.0f),
+			m_model_matrix * glm::vec4(_max.x, _max.y, 0.0f, 1.0f),
+			m_model_matrix * glm::vec4(_min.x, _max.y, 0.0f, 1.0f)
+		};
+		glm::vec4 _bounds(_corners[0].x, _corners[0].y, _corners[0].x, _corners[0].y);
+		for (const auto& _corner : _corners) {
+			_bounds = { std::min(_bounds.x, _corner.x), std::min(_bounds.y, _corner.y), std::max(_bounds.z, _corner.x), std::max(_bounds.w, _corner.y) };
+		}
+		return _bounds;
+	}
+
+	void Object::_update_model_matrix() {
+		m_model_matrix = glm::mat4(1.0f);
+		m_model_matrix = glm::translate(m_model_matrix, { m_position.x, -m_position.y, 0.0f });
+		m_model_matrix *= glm::eulerAngleZ(m_rotation);
+		m_model_matrix = glm::scale(m_model_matrix, { m_scale.x, m_scale.y, 1.0f });
+	}
+
+	Camera2D::Camera2D(Server* _owner)
+		: Object(_owner)
+	{
+		this->_update_view_proj_matrix();
+	}
+
+	Camera2D::~Camera2D() {
+
+	}
+
+	void Camera2D::update() {
+		if (m_need_to_view_proj_matrix) {
+			m_need_to_view_proj_matrix = false;
+			this->_update_view_proj_matrix();
+		}
+		Object::update();
+	}
+
+	void Camera2D::draw(Camera2D* _cam) {
+		Object::draw(_cam);
+	}
+
+	void Camera2D::set_position(const glm::vec2& _value) {
+		Object::set_position(_value);
+		m_need_to_view_proj_matrix = true;
+	}
+
+	void Camera2D::set_rotation(const float& _value) {
+		Object::set_rotation(_value);
+		m_need_to_view_proj_matrix = true;
+	}
+
+	void Camera2D::set_scale(const glm::vec2& _value) {
+		Object::set_scale(_value);
+		m_need_to_view_proj_matrix = true;
+	}
+
+	void Camera2D::set_zoom(const glm::vec2& _value) {
+		m_zoom = _value;
+		m_need_to_view_proj_matrix = true;
+		this->_damage();
+	}
+
+	const glm::vec2& Camera2D::get_zoom()const {
+		return m_zoom;
+	}
+
+	const glm::mat4& Camera2D::get_view_proj_matrix() const {
+		return m_view_proj_matrix;
+	}
+
+	const glm::mat4& Camera2D::get_default_view_proj_matrix(const uint32_t& _width, const uint32_t& _height) {
+		static glm::mat4 _default_view_proj_matrix = {
+			2.0f / 1280.0f, 0.0f, 0.0f, 0.0f,
+			0.0f, 2.0f / 720.0f, 0.0f, 0.0f,
+			0.0f, 0.0f, 1.0f / (1000.0f - 0.1f), (0.1f) / (0.1f - 1000.0f),
+			0.0f, 0.0f, 0.0f, 1.0f
+		};
+		_default_view_proj_matrix[0][0] = 2.0f / _width;
+		_default_view_proj_matrix[1][1] = 2.0f / _height;
+		return _default_view_proj_matrix;
+	}
+
+	void Camera2D::_update_view_proj_matrix() {
+		m_view_proj_matrix = {
+			2.0f / get_owner()->get_initial_window_width(), 0.0f, 0.0f, 0.0f,
+			0.0f, 2.0f / get_owner()->get_initial_window_height(), 0.0f, 0.0f,
+			0.0f, 0.0f, 1.0f / (1000.0f - 0.1f), (0.1f) / (0.1f - 1000.0f),
+			0.0f, 0.0f, 0.0f, 1.0f
+		};
+		m_view_proj_matrix = glm::scale(m_view_proj_matrix, glm::vec3(m_zoom.x, m_zoom.y, 1.0));
+		m_view_proj_matrix = glm::rotate(m_view_proj_matrix, this->get_rotation(), glm::vec3(0, 0, 1));
+		m_view_proj_matrix = glm::translate(m_view_proj_matrix, glm::vec3(-this->get_position().x, this->get_position().y, 0.0f));
+	}
+
+	Sprite::Sprite(Server* _owner)
+		: Object(_owner)
+	{
+		std::tie(m_VAO, m_VBO, m_EBO) = get_owner()->get_glw_object_set(glwu::DrawableType::Sprite);
+		m_program = get_owner()->get_generic_program(glwu::DrawableType::Sprite);
+	}
+
+	Sprite::~Sprite() {
+
+	}
+
+	void Sprite::update() {
+		Object::update();
+	}
+
+	void Sprite::draw(Camera2D* _cam) {
+		if (m_texture_layer.Texture != nullptr) {
+			glw::BufferData _instances;
+			this->_add_instance(_instances);
+			Sprite::_draw_instances(fetch_owner(), m_texture_layer.Texture, _instances, 1, _cam);
+			Object::draw(_cam);
+			return;
+		}
+		if (m_texture == nullptr) { return; }
+		fetch_owner()->touch_texture(m_texture.get());
+
+		const glm::mat4& _view_proj_matrix = (_cam != nullptr ? _cam->get_view_proj_matrix() : Camera2D::get_default_view_proj_matrix(get_owner()->get_initial_window_width(), get_owner()->get_initial_window_height()));
+		const glm::mat4& _model_matrix = get_model_matrix();
+
+		glw::Context::enable(glw::CapabilityType::Blend);
+		glw::Context::blend_func(glw::BlendFuncType::SrcAlpha, glw::BlendFuncType::OneMinusSrcAlpha);
+		glw::Context::disable(glw::CapabilityType::CullFace);
+		glw::Context::disable(glw::CapabilityType::DepthTest);
+
+		m_program->use();
+		{
+			m_program->set_mat4("uMVP", glm::value_ptr(_view_proj_matrix * _model_matrix));
+			m_program->set_vec2("uSize", static_cast<float>(m_texture->width()), static_cast<float>(m_texture->height()));
+			m_program->set_vec4("uModulate", get_modulate().r, get_modulate().g, get_modulate().b, get_modulate().a);
+
+			glw::Context::activate_texture(glw::TextureSlot::S0);
+			m_texture->bind();
+			m_program->set_sampler2D("uTexture", 0);
+			{
+				m_VAO->bind();
+				glw::Context::draw_elements(glw::PrimitiveType::Triangles, 6, glw::NumericType::UnsignedInt, 0);
+				glw::VertexArrayObject::bind_default();
+			}
+			glw::Texture::bind_default();
+		}
+		glw::Program::use_default();
+
+		glw::Context::enable(glw::CapabilityType::CullFace);
+		glw::Context::enable(glw::CapabilityType::DepthTest);
+		glw::Context::disable(glw::CapabilityType::Blend);
+		Object::draw(_cam);
+	}
+
+	void Sprite::load(const std::string& _path, bool _auto_format, glw::TextureConfig _cfg) {
+		m_load_generation++;
+		this->_damage();
+		m_texture = fetch_owner()->fetch_texture(_path, _auto_format, _cfg);
+		m_texture_layer = TextureLayer();
+		this->_damage();
+	}
+
+	void Sprite::load_async(const std::string& _path, bool _auto_format, glw::TextureConfig _cfg) {
+		const uint64_t _generation = ++m_load_generation;
+		/* Objects live as long as the server, which drops unfinished uploads first */
+		fetch_owner()->fetch_texture_async(_path, [this, _generation](TextureRef _ref) {
+			if (_generation != m_load_generation) {
+				return;
+			}
+			this->_damage();
+			m_texture = std::move(_ref);
+			m_texture_layer = TextureLayer();
+			this->_damage();
+		}, _auto_format, _cfg);
+	}
+
+	void Sprite::load_layered(const std::string& _path, bool _auto_format, glw::TextureConfig _cfg) {
+		m_load_generation++;
+		this->_damage();
+		m_texture_layer = fetch_owner()->fetch_texture_layer(_path, _auto_format, _cfg);
+		m_texture = nullptr;
+		this->_damage();
+	}
+
+	void Sprite::unload() {
+		m_load_generation++;
+		this->_damage();
+		m_texture = nullptr;
+		m_texture_layer = TextureLayer();
+	}
+
+	bool Sprite::get_bounds(glm::vec4& _out) const {
+		const glw::Texture* _texture = (m_texture_layer.Texture != nullptr ? m_texture_layer.Texture : m_texture.get());
+		const glm::vec2 _half_size = (_texture != nullptr ? glm::vec2(static_cast<float>(_texture->width()), static_cast<float>(_texture->height())) * 0.5f : glm::vec2(0.0f));
+		_out = this->_transform_bounds(-_half_size, _half_size);
+		return true;
+	}
+
+	void Sprite::draw_batch(Server* _owner, const std::vector<Sprite*>& _sprites, Camera2D* _cam) {
+		/* Consecutive sprites on the same array page share a call, so the submission order is kept */
+		const glw::Texture* _texture = nullptr;
+		glw::BufferData _instances;
+		uint32_t _count = 0U;
+		auto _flush = [&]() {
+			if (_count > 0U) {
+				Sprite::_draw_instances(_owner, _texture, _instances, _count, _cam);
+			}
+			_instances.clear();
+			_count = 0U;
+		};
+		for (const auto& _sprite : _sprites) {
+			if (_sprite->m_texture_layer.Texture == nullptr) {
+				_flush();
+				_sprite->draw(_cam);
+				continue;
+			}
+			if (_sprite->m_texture_layer.Texture != _texture) {
+				_flush();
+				_texture = _sprite->m_texture_layer.Texture;
+			}
+			_sprite->_add_instance(_instances);
+			_count++;
+		}
+		_flush();
+	}
+
+	void Sprite::_add_instance(glw::BufferData& _out) const {
+		const glm::vec4& _modulate = get_modulate();
+		_out.add_floats(glm::value_ptr(get_model_matrix()), 16);
+		_out.add_floats(glm::value_ptr(_modulate), 4);
+		_out.add_float(static_cast<float>(m_texture_layer.Texture->width()));
+		_out.add_float(static_cast<float>(m_texture_layer.Texture->height()));
+		_out.add_float(static_cast<float>(m_texture_layer.Layer));
+		_out.add_float(0.0f);
+	}
+
+	void Sprite::_draw_instances(Server* _owner, const glw::Texture* _texture, const glw::BufferData& _instances, uint32_t _count, Camera2D* _cam) {
+		const auto& [_VAO, _VBO, _EBO] = _owner->get_glw_object_set(glwu::DrawableType::LayeredSprite);
+		const glw::Program* _program = _owner->get_generic_program(glwu::DrawableType::LayeredSprite);
+
+		const glm::mat4& _view_proj_matrix = (_cam != nullptr ? _cam->get_view_proj_matrix() : Camera2D::get_default_view_proj_matrix(_owner->get_initial_window_width(), _owner->get_initial_window_height()));
+
+		glw::Context::enable(glw::CapabilityType::Blend);
+		glw::Context::blend_func(glw::BlendFuncType::SrcAlpha, glw::BlendFuncType::OneMinusSrcAlpha);
+		glw::Context::disable(glw::CapabilityType::CullFace);
+		glw::Context::disable(glw::CapabilityType::DepthTest);
+
+		_program->use();
+		{
+			_program->set_mat4("uViewProj", glm::value_ptr(_view_proj_matrix));
+
+			_VBO->bind();
+			_VBO->bind_data(_instances, glw::BufferUsage::StreamDraw);
+			glw::VertexBufferObject::bind_default();
+
+			glw::Context::activate_texture(glw::TextureSlot::S0);
+			_texture->generate_pending_mipmap();
+			_texture->bind();
+			_program->set_sampler2D("uTextures", 0);
+			{
+				_VAO->bind();
+				glw::Context::draw_elements_instanced(glw::PrimitiveType::Triangles, 6, glw::NumericType::UnsignedInt, 0, _count);
+				glw::VertexArrayObject::bind_default();
+			}
+			glw::Texture::bind_default(glw::TextureTarget::Texture2DArray);
+		}
+		glw::Program::use_default();
+
+		glw::Context::enable(glw::CapabilityType::CullFace);
+		glw::Context::enable(glw::CapabilityType::DepthTest);
+		glw::Context::disable(glw::CapabilityType::Blend);
+	}
+
+	BlendedSprite::BlendedSprite(Server* _owner)
+		: Object(_owner)
+	{
+		std::tie(m_VAO, m_VBO, m_EBO) = get_owner()->get_glw_object_set(glwu::DrawableType::BlendedSprite);
+	}
+
+	BlendedSprite::~BlendedSprite() {
+
+	}
+
+	void BlendedSprite::update() {
+		Object::update();
+	}
+
+	void BlendedSprite::draw(Camera2D* _cam) {
+		if (m_textures.empty() || m_program == nullptr) { return; }
+		for (const auto& _tex : m_textures) {
+			fetch_owner()->touch_texture(_tex.get());
+		}
+		const glm::mat4& _view_proj_matrix = (_cam != nullptr ? _cam->get_view_proj_matrix() : Camera2D::get_default_view_proj_matrix(get_owner()->get_initial_window_width(), get_owner()->get_initial_window_height()));
+		const glm::mat4& _model_matrix = get_model_matrix();
+
+		glw::Context::enable(glw::CapabilityType::Blend);
+		glw::Context::blend_func(glw::BlendFuncType::SrcAlpha, glw::BlendFuncType::OneMinusSrcAlpha);
+		glw::Context::disable(glw::CapabilityType::CullFace);
+		glw::Context::disable(glw::CapabilityType::DepthTest);
+
+		m_program->use();
+		{
+			m_program->set_mat4("uMVP", glm::value_ptr(_view_proj_matrix * _model_matrix));
+			m_program->set_vec2("uSize", static_cast<float>(m_base_width), static_cast<float>(m_base_height));
+			m_program->set_vec4("uModulate", get_modulate().r, get_modulate().g, get_modulate().b, get_modulate().a);
+
+			const size_t _texs_len = m_textures.size();
+			for (size_t i = 0; i < _texs_len; i++) {
+				glw::TextureSlot _slot = static_cast<glw::TextureSlot>(static_cast<uint32_t>(glw::TextureSlot::S0) + static_cast<uint32_t>(i));
+				glw::Context::activate_texture(_slot);
+				m_textures[i]->bind();
+				m_program->set_sampler2D("uTextures[" + std::to_string(i) + "]", static_cast<int>(i));
+			}
+
+			{
+				m_VAO->bind();
+				glw::Context::draw_elements(glw::PrimitiveType::Triangles, 6, glw::NumericType::UnsignedInt, 0);
+				glw::VertexArrayObject::bind_default();
+			}
+			glw::Texture::bind_default();
+		}
+		glw::Program::use_default();
+
+		glw::Context::enable(glw::CapabilityType::CullFace);
+		glw::Context::enable(glw::CapabilityType::DepthTest);
+		glw::Context::disable(glw::CapabilityType::Blend);
+		Object::draw(_cam);
+	}
+
+	void BlendedSprite::set_base_size(const uint32_t& _width, const uint32_t& _height) {
+		this->_damage();
+		m_base_width = _width;
+		m_base_height = _height;
+		this->_damage();
+	}
+
+	void BlendedSprite::clear_textures() {
+		m_textures.clear();
+		this->_damage();
+	}
+
+	void BlendedSprite::load_extra_texture(const std::string& _path, bool _auto_format, glw::TextureConfig _cfg) {
+		if (m_textures.size() < BlendedSprite::maximum_blended_texture_count) {
+			m_textures.emplace_back(fetch_owner()->fetch_texture(_path, _auto_format, _cfg));
+			/* The blend loop is unrolled per texture count */
+			m_program = fetch_owner()->fetch_quad_program(ShaderFeature::Textured | shader_texture_count(static_cast<uint32_t>(m_textures.size())));
+			this->_damage();
+		}
+	}
+
+	size_t BlendedSprite::get_loaded_texture_count() const {
+		return m_textures.size();
+	}
+
+	bool BlendedSprite::get_bounds(glm::vec4& _out) const {
+		const glm::vec2 _half_size = glm::vec2(static_cast<float>(m_base_width), static_cast<float>(m_base_height)) * 0.5f;
+		_out = this->_transform_bounds(-_half_size, _half_size);
+		return true;
+	}
+
+	ColoredObject::ColoredObject(Server* _owner)
+		: Object(_owner)
+	{
+
+	}
+
+	ColoredObject::~ColoredObject() {
+
+	}
+
+	void ColoredObject::update() {
+		Object::update();
+	}
+
+	void ColoredObject::draw(Camera2D* _cam) {
+		Object::draw(_cam);
+	}
+
+	void ColoredObject::set_color(const glm::vec4& _value) {
+		m_color = _value;
+		this->_damage();
+	}
+
+	const glm::vec4& ColoredObject::get_color() const {
+		return m_color;
+	}
+
+	Line::Line(Server* _owner)
+		: ColoredObject(_owner)
+	{
+		std::tie(m_VAO, m_VBO, m_EBO) = get_owner()->get_glw_object_set(glwu::DrawableType::Line);
+		m_program = get_owner()->get_generic_program(glwu::DrawableType::Line);
+	}
+
+	Line::~Line() {
+
+	}
+
+	void Line::update() {
+		ColoredObject::update();
+	}
+
+	void Line::draw(Camera2D* _cam) {
+		glw::BufferData _segments; {
+			this->_add_segment(_segments);
+		}
+		Line::draw_segments(fetch_owner(), _segments, 1, _cam);
+		ColoredObject::draw(_cam);
+	}
+
+	void Line::set_width(const float& _value) {
+		this->_damage();
+		m_width = _value;
+		this->_damage();
+	}
+
+	void Line::set_cap(const LineCap& _value) {
+		this->_damage();
+		m_cap = _value;
+		this->_damage();
+	}
+
+	void Line::set_begin(const glm::vec2& _value) {
+		this->_damage();
+		m_point_begin = _value;
+		this->_damage();
+	}
+
+	void Line::set_end(const glm::vec2& _value) {
+		this->_damage();
+		m_point_end = _value;
+		this->_damage();
+	}
+
+	const float& Line::get_width() const {
+		return m_width;
+	}
+
+	const LineCap& Line::get_cap() const {
+		return m_cap;
+	}
+
+	const glm::vec2& Line::get_begin() const {
+		return m_point_begin;
+	}
+
+	const glm::vec2& Line::get_end() const {
+		return m_point_end;
+	}
+
+	bool Line::get_bounds(glm::vec4& _out) const {
+		/* Points are drawn with y flipped */
+		const glm::vec2 _begin(m_point_begin.x, -m_point_begin.y);
+		const glm::vec2 _end(m_point_end.x, -m_point_end.y);
+		_out = this->_transform_bounds(glm::min(_begin, _end), glm::max(_begin, _end));
+		return true;
+	}
+
+	float Line::get_bounds_padding() const {
+		return Line::get_pixel_extent(m_width);
+	}
+
+	void Line::draw_batch(Server* _owner, const std::vector<Line*>& _lines, Camera2D* _cam) {
+		if (_lines.empty()) { return; }
+		glw::BufferData _segments; {
+			_segments.reserve(Line::segment_stride * _lines.size());
+			for (const auto& _line : _lines) {
+				_line->_add_segment(_segments);
+			}
+		}
+		Line::draw_segments(_owner, _segments, static_cast<uint32_t>(_lines.size()), _cam);
+	}
+
+	void Line::add_segment(glw::BufferData& _out, const glm::vec2& _prev, const glm::vec2& _begin, const glm::vec2& _end, const glm::vec2& _next, const glm::vec4& _color, float _width, LineCap _cap, LineJoin _join, bool _pixel_snapped) {
+		_out.add_floats(glm::value_ptr(_prev), 2);
+		_out.add_floats(glm::value_ptr(_begin), 2);
+		_out.add_floats(glm::value_ptr(_end), 2);
+		_out.add_floats(glm::value_ptr(_next), 2);
+		_out.add_floats(glm::value_ptr(_color), 4);
+		_out.add_float(_width);
+		_out.add_float(static_cast<float>(_cap));
+		_out.add_float(static_cast<float>(_join));
+		_out.add_float(_pixel_snapped ? 1.0f : 0.0f);
+	}
+
+	void Line::draw_segments(Server* _owner, const glw::BufferData& _segments, uint32_t _count, Camera2D* _cam) {
+		const glw::VertexArrayObject* _VAO = nullptr;
+		const glw::VertexBufferObject* _VBO = nullptr;
+		const glw::ElementBufferObject* _EBO = nullptr;
+		std::tie(_VAO, _VBO, _EBO) = _owner->get_glw_object_set(glwu::DrawableType::Line);
+		const glw::Program* _program = _owner->get_generic_program(glwu::DrawableType::Line);
+
+		const glm::mat4& _view_proj_matrix = (_cam != nullptr ? _cam->get_view_proj_matrix() : Camera2D::get_default_view_proj_matrix(_owner->get_initial_window_width(), _owner->get_initial_window_height()));
+
+		int _viewport_x = 0, _viewport_y = 0;
+		uint32_t _viewport_width = 0U, _viewport_height = 0U;
+		glw::Context::get_viewport(_viewport_x, _viewport_y, _viewport_width, _viewport_height);
+
+		glw::Context::enable(glw::CapabilityType::Blend);
+		glw::Context::blend_func(glw::BlendFuncType::SrcAlpha, glw::BlendFuncType::OneMinusSrcAlpha);
+		glw::Context::disable(glw::CapabilityType::CullFace);
+		glw::Context::disable(glw::CapabilityType::DepthTest);
+
+		_program->use();
+		{
+			_program->set_mat4("uMVP", glm::value_ptr(_view_proj_matrix));
+			_program->set_vec2("uViewportSize", static_cast<float>(_viewport_width), static_cast<float>(_viewport_height));
+			_program->set_int("uStripSegmentCount", 0);
+
+			_VBO->bind();
+			_VBO->bind_data(_segments, glw::BufferUsage::StreamDraw);
+			glw::VertexBufferObject::bind_default();
+
+			_VAO->bind();
+			{
+				glw::Context::draw_arrays_instanced(glw::PrimitiveType::TriangleStrip, 0, 4, _count);
 			}
+			glw::VertexArrayObject::bind_default();
 		}
-		glw::Texture* _tex = new glw::Texture(_cfg, _data, _width, _height, _channels);
-		stbi_image_free(_data);
+		glw::Program::use_default();
 
-		m_texture_map[_key] = _tex;
-		m_textures.emplace_back(_tex);
+		glw::Context::enable(glw::CapabilityType::CullFace);
+		glw::Context::enable(glw::CapabilityType::DepthTest);
+		glw::Context::disable(glw::CapabilityType::Blend);
+	}
 
-		return _tex;
+	float Line::get_pixel_extent(float _width) {
+		/* Matches the vertex shader : one pixel of anti-aliasing, and miters clamped at four times the extent */
+		return (std::max(_width, 1.0f) * 0.5f + 1.0f) * 4.0f;
 	}
 
-	const uint32_t& Server::get_initial_window_width() const {
-		return m_initial_window_width;
+	void Line::_add_segment(glw::BufferData& _out) const {
+		const glm::vec4 _begin = get_model_matrix() * glm::vec4(m_point_begin.x, -m_point_begin.y, 0.0f, 1.0f);
+		const glm::vec4 _end = get_model_matrix() * glm::vec4(m_point_end.x, -m_point_end.y, 0.0f, 1.0f);
+		Line::add_segment(
+			_out,
+			{ _begin.x, _begin.y },
+			{ _begin.x, _begin.y },
+			{ _end.x, _end.y },
+			{ _end.x, _end.y },
+			get_color() * get_modulate(),
+			m_width,
+			m_cap,
+			LineJoin::Miter,
+			false
+		);
 	}
 
-	const uint32_t& Server::get_initial_window_height() const {
-		return m_initial_window_height;
+	LinedRect::LinedRect(Server* _owner) 
+		: ColoredObject(_owner)
+	{
+		std::tie(m_VAO, m_VBO, m_EBO) = get_owner()->get_glw_object_set(glwu::DrawableType::LinedRect);
+		m_program = get_owner()->get_generic_program(glwu::DrawableType::LinedRect);
 	}
 
-	const Server::GLWObjectSet& Server::get_glw_object_set(const DrawableType& _type) const {
-		return m_glw_object_set_map.at(_type);
+	LinedRect::~LinedRect() {
+
 	}
 
-	const glw::Program* Server::get_generic_program(const DrawableType& _type) const {
-		return m_program_map.at(_type);
+	void LinedRect::update() {
+		ColoredObject::update();
 	}
 
-	Object::Object(Server* _owner)
-		: m_owner(_owner)
-	{
-		this->_update_model_matrix();
+	void LinedRect::draw(Camera2D* _cam) {
+		const glm::mat4& _model_matrix = get_model_matrix();
+		const glm::vec2 _half_size = m_size * 0.5f;
+		const glm::vec4 _corners[4] = {
+			_model_matrix * glm::vec4(-_half_size.x, _half_size.y, 0.0f, 1.0f),
+			_model_matrix * glm::vec4(_half_size.x, _half_size.y, 0.0f, 1.0f),
+			_model_matrix * glm::vec4(_half_size.x, -_half_size.y, 0.0f, 1.0f),
+			_model_matrix * glm::vec4(-_half_size.x, -_half_size.y, 0.0f, 1.0f)
+		};
+
+		glw::BufferData _segments; {
+			_segments.reserve(Line::segment_stride * 4);
+			for (size_t i = 0; i < 4; i++) {
+				const glm::vec4& _prev = _corners[(i + 3) % 4];
+				const glm::vec4& _begin = _corners[i];
+				const glm::vec4& _end = _corners[(i + 1) % 4];
+				const glm::vec4& _next = _corners[(i + 2) % 4];
+				Line::add_segment(
+					_segments,
+					{ _prev.x, _prev.y },
+					{ _begin.x, _begin.y },
+					{ _end.x, _end.y },
+					{ _next.x, _next.y },
+					get_color() * get_modulate(),
+					m_line_width,
+					LineCap::Butt,
+					m_line_join,
+					true
+				);
+			}
+		}
+		Line::draw_segments(fetch_owner(), _segments, 4, _cam);
+		ColoredObject::draw(_cam);
 	}
 
-	Object::~Object() {
+	void LinedRect::set_line_width(const float& _value) {
+		this->_damage();
+		m_line_width = _value;
+		this->_damage();
+	}
 
+	void LinedRect::set_line_join(const LineJoin& _value) {
+		m_line_join = _value;
+		this->_damage();
 	}
 
-	void Object::update() {
-		if (m_need_to_update_model_matrix) {
-			m_need_to_update_model_matrix = false;
-			this->_update_model_matrix();
-		}
+	void LinedRect::set_size(const glm::vec2& _value) {
+		this->_damage();
+		m_size = _value;
+		this->_damage();
 	}
 
-	void Object::draw(Camera2D* _cam) {
+	const float& LinedRect::get_line_width() const {
+		return m_line_width;
+	}
 
+	const LineJoin& LinedRect::get_line_join() const {
+		return m_line_join;
 	}
 
-	void Object::set_position(const glm::vec2& _value) {
-		m_position = _value;
-		m_need_to_update_model_matrix = true;
+	const glm::vec2& LinedRect::get_size() const {
+		return m_size;
 	}
 
-	void Object::set_rotation(const float& _value) {
-		m_rotation = _value;
-		m_need_to_update_model_matrix = true;
+	bool LinedRect::get_bounds(glm::vec4& _out) const {
+		_out = this->_transform_bounds(m_size * -0.5f, m_size * 0.5f);
+		return true;
 	}
 
-	void Object::set_scale(const glm::vec2& _value) {
-		m_scale = _value;
-		m_need_to_update_model_matrix = true;
+	float LinedRect::get_bounds_padding() const {
+		return Line::get_pixel_extent(m_line_width);
 	}
 
-	void Object::set_modulate(const glm::vec4& _value) {
-		m_modulate = _value;
+	Polyline::Polyline(Server* _owner)
+		: ColoredObject(_owner),
+		m_point_VAO(new glw::VertexArrayObject()),
+		m_point_VBO(new glw::VertexBufferObject()),
+		m_points(Polyline::default_capacity)
+	{
+		m_program = get_owner()->get_generic_program(glwu::DrawableType::Polyline);
 	}
 
-	Server* Object::fetch_owner() {
-		return m_owner;
+	Polyline::~Polyline() {
+		delete m_point_VAO;
+		delete m_point_VBO;
+		m_point_VAO = nullptr;
+		m_point_VBO = nullptr;
 	}
 
-	const Server* Object::get_owner() const {
-		return m_owner;
+	void Polyline::update() {
+		ColoredObject::update();
 	}
 
-	const glm::vec2& Object::get_position() const {
-		return m_position;
+	void Polyline::draw(Camera2D* _cam) {
+		if (m_count < 2) { return; }
+		const glm::mat4& _view_proj_matrix = (_cam != nullptr ? _cam->get_view_proj_matrix() : Camera2D::get_default_view_proj_matrix(get_owner()->get_initial_window_width(), get_owner()->get_initial_window_height()));
+		const glm::mat4 _model_matrix = glm::scale(get_model_matrix(), { 1.0f, -1.0f, 1.0f });
+		const glm::vec4 _color = get_color() * get_modulate();
+
+		int _viewport_x = 0, _viewport_y = 0;
+		uint32_t _viewport_width = 0U, _viewport_height = 0U;
+		glw::Context::get_viewport(_viewport_x, _viewport_y, _viewport_width, _viewport_height);
+
+		this->_upload();
+
+		glw::Context::enable(glw::CapabilityType::Blend);
+		glw::Context::blend_func(glw::BlendFuncType::SrcAlpha, glw::BlendFuncType::OneMinusSrcAlpha);
+		glw::Context::disable(glw::CapabilityType::CullFace);
+		glw::Context::disable(glw::CapabilityType::DepthTest);
+
+		m_program->use();
+		{
+			m_program->set_mat4("uMVP", glm::value_ptr(_view_proj_matrix * _model_matrix));
+			m_program->set_vec2("uViewportSize", static_cast<float>(_viewport_width), static_cast<float>(_viewport_height));
+			m_program->set_int("uStripSegmentCount", static_cast<int>(m_count - 1));
+
+			m_point_VAO->bind();
+			{
+				if (m_bound_head != m_head) {
+					m_point_VBO->bind();
+					for (uint32_t i = 0; i < 4; i++) {
+						m_point_VAO->attrib_pointer(i, 2, glw::NumericType::Float, sizeof(glm::vec2), sizeof(glm::vec2) * (m_head + i));
+						m_point_VAO->attrib_divisor(i, 1);
+					}
+					glw::VertexBufferObject::bind_default();
+					m_bound_head = m_head;
+				}
+				glw::Context::set_vertex_attrib_vec4(4, _color.r, _color.g, _color.b, _color.a);
+				glw::Context::set_vertex_attrib_vec4(5, m_width, static_cast<float>(m_cap), static_cast<float>(m_join), 0.0f);
+				glw::Context::draw_arrays_instanced(glw::PrimitiveType::TriangleStrip, 0, 4, static_cast<uint32_t>(m_count - 1));
+			}
+			glw::VertexArrayObject::bind_default();
+		}
+		glw::Program::use_default();
+
+		glw::Context::enable(glw::CapabilityType::CullFace);
+		glw::Context::enable(glw::CapabilityType::DepthTest);
+		glw::Context::disable(glw::CapabilityType::Blend);
+		ColoredObject::draw(_cam);
 	}
 
-	const float& Object::get_rotation() const {
-		return m_rotation;
+	void Polyline::set_capacity(size_t _value) {
+		if (_value < 2) { _value = 2; }
+		this->_damage();
+		std::vector<glm::vec2> _points(_value);
+		const size_t _kept = std::min(m_count, _value);
+		for (size_t i = 0; i < _kept; i++) {
+			_points[i] = this->get_point(m_count - _kept + i);
+		}
+		m_points = std::move(_points);
+		m_head = 0;
+		m_count = _kept;
+		m_need_to_reallocate = true;
+		this->_damage();
 	}
 
-	const glm::vec2& Object::get_scale() const {
-		return m_scale;
+	void Polyline::push_back(const glm::vec2& _value) {
+		const size_t _capacity = m_points.size();
+		if (m_count == _capacity) {
+			this->_damage_points(0, 0);
+			m_head = (m_head + 1) % _capacity;
+			m_count--;
+		}
+		this->_write((m_head + m_count) % _capacity, _value);
+		m_count++;
+		this->_damage_points(m_count - 1, m_count - 1);
 	}
 
-	const glm::vec4& Object::get_modulate() const {
-		return m_modulate;
+	void Polyline::append(const std::vector<glm::vec2>& _values) {
+		for (const auto& _value : _values) {
+			this->push_back(_value);
+		}
 	}
 
-	const glm::mat4& Object::get_model_matrix() const {
-		return m_model_matrix;
+	void Polyline::pop_front(size_t _count) {
+		_count = std::min(_count, m_count);
+		if (_count == 0) { return; }
+		this->_damage_points(0, _count - 1);
+		m_head = (m_head + _count) % m_points.size();
+		m_count -= _count;
 	}
 
-	void Object::_update_model_matrix() {
-		m_model_matrix = glm::mat4(1.0f);
-		m_model_matrix = glm::translate(m_model_matrix, { m_position.x, -m_position.y, 0.0f });
-		m_model_matrix *= glm::eulerAngleZ(m_rotation);
-		m_model_matrix = glm::scale(m_model_matrix, { m_scale.x, m_scale.y, 1.0f });
+	void Polyline::clear() {
+		this->_damage();
+		m_head = 0;
+		m_count = 0;
 	}
 
-	Camera2D::Camera2D(Server* _owner)
-		: Object(_owner)
-	{
-		this->_update_view_proj_matrix();
+	void Polyline::set_point(size_t _index, const glm::vec2& _value) {
+		if (_index >= m_count) {
+			throw std::out_of_range("[GLWU] : Polyline point out of range : Index = " + std::to_string(_index));
+		}
+		this->_damage_points(_index, _index);
+		this->_write((m_head + _index) % m_points.size(), _value);
+		this->_damage_points(_index, _index);
 	}
 
-	Camera2D::~Camera2D() {
+	void Polyline::set_width(const float& _value) {
+		this->_damage();
+		m_width = _value;
+		this->_damage();
+	}
 
+	void Polyline::set_cap(const LineCap& _value) {
+		m_cap = _value;
+		this->_damage();
 	}
 
-	void Camera2D::update() {
-		if (m_need_to_view_proj_matrix) {
-			m_need_to_view_proj_matrix = false;
-			this->_update_view_proj_matrix();
+	void Polyline::set_join(const LineJoin& _value) {
+		m_join = _value;
+		this->_damage();
+	}
+
+	const glm::vec2& Polyline::get_point(size_t _index) const {
+		if (_index >= m_count) {
+			throw std::out_of_range("[GLWU] : Polyline point out of range : Index = " + std::to_string(_index));
 		}
-		Object::update();
+		return m_points[(m_head + _index) % m_points.size()];
 	}
 
-	void Camera2D::draw(Camera2D* _cam) {
-		Object::draw(_cam);
+	size_t Polyline::get_point_count() const {
+		return m_count;
 	}
 
-	void Camera2D::set_position(const glm::vec2& _value) {
-		Object::set_position(_value);
-		m_need_to_view_proj_matrix = true;
+	size_t Polyline::get_capacity() const {
+		return m_points.size();
 	}
 
-	void Camera2D::set_rotation(const float& _value) {
-		Object::set_rotation(_value);
-		m_need_to_view_proj_matrix = true;
+	const float& Polyline::get_width() const {
+		return m_width;
 	}
 
-	void Camera2D::set_scale(const glm::vec2& _value) {
-		Object::set_scale(_value);
-		m_need_to_view_proj_matrix = true;
+	const LineCap& Polyline::get_cap() const {
+		return m_cap;
 	}
 
-	void Camera2D::set_zoom(const glm::vec2& _value) {
-		m_zoom = _value;
-		m_need_to_view_proj_matrix = true;
+	const LineJoin& Polyline::get_join() const {
+		return m_join;
 	}
 
-	const glm::vec2& Camera2D::get_zoom()const {
-		return m_zoom;
+	bool Polyline::get_bounds(glm::vec4& _out) const {
+		if (m_count == 0) {
+			_out = this->_transform_bounds(glm::vec2(0.0f), glm::vec2(0.0f));
+			return true;
+		}
+		glm::vec2 _min = this->get_point(0);
+		glm::vec2 _max = _min;
+		for (size_t i = 1; i < m_count; i++) {
+			_min = glm::min(_min, this->get_point(i));
+			_max = glm::max(_max, this->get_point(i));
+		}
+		/* Points are drawn with y flipped */
+		_out = this->_transform_bounds({ _min.x, -_max.y }, { _max.x, -_min.y });
+		return true;
 	}
 
-	const glm::mat4& Camera2D::get_view_proj_matrix() const {
-		return m_view_proj_matrix;
+	float Polyline::get_bounds_padding() const {
+		return Line::get_pixel_extent(m_width);
 	}
 
-	const glm::mat4& Camera2D::get_default_view_proj_matrix(const uint32_t& _width, const uint32_t& _height) {
-		static glm::mat4 _default_view_proj_matrix = {
-			2.0f / 1280.0f, 0.0f, 0.0f, 0.0f,
-			0.0f, 2.0f / 720.0f, 0.0f, 0.0f,
-			0.0f, 0.0f, 1.0f / (1000.0f - 0.1f), (0.1f) / (0.1f - 1000.0f),
-			0.0f, 0.0f, 0.0f, 1.0f
-		};
-		_default_view_proj_matrix[0][0] = 2.0f / _width;
-		_default_view_proj_matrix[1][1] = 2.0f / _height;
-		return _default_view_proj_matrix;
+	void Polyline::_write(size_t _slot, const glm::vec2& _value) {
+		m_points[_slot] = _value;
+		m_dirty_begin = std::min(m_dirty_begin, _slot);
+		m_dirty_end = std::max(m_dirty_end, _slot + 1);
 	}
 
-	void Camera2D::_update_view_proj_matrix() {
-		m_view_proj_matrix = {
-			2.0f / get_owner()->get_initial_window_width(), 0.0f, 0.0f, 0.0f,
-			0.0f, 2.0f / get_owner()->get_initial_window_height(), 0.0f, 0.0f,
-			0.0f, 0.0f, 1.0f / (1000.0f - 0.1f), (0.1f) / (0.1f - 1000.0f),
-			0.0f, 0.0f, 0.0f, 1.0f
-		};
-		m_view_proj_matrix = glm::scale(m_view_proj_matrix, glm::vec3(m_zoom.x, m_zoom.y, 1.0));
-		m_view_proj_matrix = glm::rotate(m_view_proj_matrix, this->get_rotation(), glm::vec3(0, 0, 1));
-		m_view_proj_matrix = glm::translate(m_view_proj_matrix, glm::vec3(-this->get_position().x, this->get_position().y, 0.0f));
+	void Polyline::_upload() {
+		const size_t _capacity = m_points.size();
+		if (m_need_to_reallocate) {
+			m_need_to_reallocate = false;
+			m_dirty_begin = 0;
+			m_dirty_end = _capacity;
+			m_bound_head = SIZE_MAX;
+			m_point_VBO->bind();
+			m_point_VBO->bind_empty_data(sizeof(glm::vec2) * (_capacity * 2 + 2), glw::BufferUsage::DynamicDraw);
+			glw::VertexBufferObject::bind_default();
+		}
+		if (m_dirty_begin >= m_dirty_end) { return; }
+		const size_t _length = sizeof(glm::vec2) * (m_dirty_end - m_dirty_begin);
+		m_point_VBO->bind();
+		m_point_VBO->bind_sub_data(&m_points[m_dirty_begin], _length, sizeof(glm::vec2) * (1 + m_dirty_begin));
+		m_point_VBO->bind_sub_data(&m_points[m_dirty_begin], _length, sizeof(glm::vec2) * (1 + _capacity + m_dirty_begin));
+		glw::VertexBufferObject::bind_default();
+		m_dirty_begin = SIZE_MAX;
+		m_dirty_end = 0;
 	}
 
-	Sprite::Sprite(Server* _owner)
-		: Object(_owner)
+	void Polyline::_damage_points(size_t _first, size_t _last) {
+		if (m_count == 0 || get_owner()->get_partial_redraw_enabled() == false) { return; }
+		_first = (_first > 0 ? _first - 1 : 0);
+		_last = std::min(_last + 1, m_count - 1);
+		glm::vec2 _min = this->get_point(_first);
+		glm::vec2 _max = _min;
+		for (size_t i = _first + 1; i <= _last; i++) {
+			_min = glm::min(_min, this->get_point(i));
+			_max = glm::max(_max, this->get_point(i));
+		}
+		this->_damage({ _min.x, -_max.y }, { _max.x, -_min.y });
+	}
+
+	ColorRect::ColorRect(Server* _owner)
+		: ColoredObject(_owner)
 	{
-		std::tie(m_VAO, m_VBO, m_EBO) = get_owner()->get_glw_object_set(glwu::DrawableType::Sprite);
-		m_program = get_owner()->get_generic_program(glwu::DrawableType::Sprite);
+		std::tie(m_VAO, m_VBO, m_EBO) = get_owner()->get_glw_object_set(glwu::DrawableType::ColorRect);
+		m_program = get_owner()->get_generic_program(glwu::DrawableType::ColorRect);
 	}
 
-	Sprite::~Sprite() {
+	ColorRect::~ColorRect() {
 
 	}
 
-	void Sprite::update() {
-		Object::update();
+	void ColorRect::update() {
+		ColoredObject::update();
 	}
 
-	void Sprite::draw(Camera2D* _cam) {
-		if (m_texture == nullptr) { return; }
-
+	void ColorRect::draw(Camera2D* _cam) {
 		const glm::mat4& _view_proj_matrix = (_cam != nullptr ? _cam->get_view_proj_matrix() : Camera2D::get_default_view_proj_matrix(get_owner()->get_initial_window_width(), get_owner()->get_initial_window_height()));
 		const glm::mat4& _model_matrix = get_model_matrix();
 
@@ -807,251 +4645,356 @@ void main() {
 		m_program->use();
 		{
 			m_program->set_mat4("uMVP", glm::value_ptr(_view_proj_matrix * _model_matrix));
-			m_program->set_vec2("uSize", static_cast<float>(m_texture->width()), static_cast<float>(m_texture->height()));
+			m_program->set_vec4("uColor", get_color().r, get_color().g, get_color().b, get_color().a);
 			m_program->set_vec4("uModulate", get_modulate().r, get_modulate().g, get_modulate().b, get_modulate().a);
+			m_program->set_vec2("uSize", m_size.x, m_size.y);
 
-			glw::Context::activate_texture(glw::TextureSlot::S0);
-			m_texture->bind();
-			m_program->set_sampler2D("uTexture", 0);
+			m_VAO->bind();
 			{
-				m_VAO->bind();
 				glw::Context::draw_elements(glw::PrimitiveType::Triangles, 6, glw::NumericType::UnsignedInt, 0);
-				glw::VertexArrayObject::bind_default();
 			}
-			glw::Texture::bind_default();
+			glw::VertexArrayObject::bind_default();
 		}
 		glw::Program::use_default();
 
 		glw::Context::enable(glw::CapabilityType::CullFace);
 		glw::Context::enable(glw::CapabilityType::DepthTest);
 		glw::Context::disable(glw::CapabilityType::Blend);
-		Object::draw(_cam);
+		ColoredObject::draw(_cam);
 	}
 
-	void Sprite::load(const std::string& _path, bool _auto_format, glw::TextureConfig _cfg) {
-		m_texture = fetch_owner()->fetch_texture(_path, _auto_format, _cfg);
+	void ColorRect::set_size(const glm::vec2& _value){
+		this->_damage();
+		m_size = _value;
+		this->_damage();
 	}
 
-	BlendedSprite::BlendedSprite(Server* _owner)
-		: Object(_owner)
+	const glm::vec2& ColorRect::get_size() const {
+		return m_size;
+	}
+
+	bool ColorRect::get_bounds(glm::vec4& _out) const {
+		_out = this->_transform_bounds(m_size * -0.5f, m_size * 0.5f);
+		return true;
+	}
+
+	RoundedColorRect::RoundedColorRect(Server* _owner) 
+		: ColoredObject(_owner)
 	{
-		std::tie(m_VAO, m_VBO, m_EBO) = get_owner()->get_glw_object_set(glwu::DrawableType::BlendedSprite);
-		m_program = get_owner()->get_generic_program(glwu::DrawableType::BlendedSprite);
+		std::tie(m_VAO, m_VBO, m_EBO) = get_owner()->get_glw_object_set(glwu::DrawableType::RoundedColorRect);
+		m_program = get_owner()->get_generic_program(glwu::DrawableType::RoundedColorRect);
 	}
 
-	BlendedSprite::~BlendedSprite() {
+	RoundedColorRect::~RoundedColorRect() {
+
+	}
+	
+	void RoundedColorRect::update() {
+		ColoredObject::update();
+	}
+	
+	void RoundedColorRect::draw(Camera2D* _cam) {
+		if (m_shadow_enabled) {
+			RoundedColorRect::_draw_shadows(fetch_owner(), { this }, _cam);
+		}
+		glw::BufferData _instances; {
+			this->_add_instance(_instances);
+		}
+		RoundedColorRect::_draw_instances(fetch_owner(), _instances, 1, this->_get_shader_features(), _cam);
+		ColoredObject::draw(_cam);
+	}
 
+	void RoundedColorRect::draw_batch(Server* _owner, const std::vector<RoundedColorRect*>& _rects, Camera2D* _cam) {
+		if (_rects.empty()) { return; }
+		RoundedColorRect::_draw_shadows(_owner, _rects, _cam);
+		ShaderFeature _features = ShaderFeature::Instanced;
+		glw::BufferData _instances; {
+			_instances.reserve(RoundedColorRect::instance_stride * _rects.size());
+			for (const auto& _rect : _rects) {
+				_rect->_add_instance(_instances);
+				_features = _features | _rect->_get_shader_features();
+			}
+		}
+		RoundedColorRect::_draw_instances(_owner, _instances, static_cast<uint32_t>(_rects.size()), _features, _cam);
 	}
 
-	void BlendedSprite::update() {
-		Object::update();
+	void RoundedColorRect::set_size(const glm::vec2& _value) {
+		this->_damage();
+		m_size = _value;
+		this->_damage();
 	}
 
-	void BlendedSprite::draw(Camera2D* _cam) {
-		if (m_textures.empty()) { return; }
-		const glm::mat4& _view_proj_matrix = (_cam != nullptr ? _cam->get_view_proj_matrix() : Camera2D::get_default_view_proj_matrix(get_owner()->get_initial_window_width(), get_owner()->get_initial_window_height()));
-		const glm::mat4& _model_matrix = get_model_matrix();
+	void RoundedColorRect::set_outline_width(const float& _value) {
+		m_outline_width = _value;
+		this->_damage();
+	}
 
-		glw::Context::enable(glw::CapabilityType::Blend);
-		glw::Context::blend_func(glw::BlendFuncType::SrcAlpha, glw::BlendFuncType::OneMinusSrcAlpha);
-		glw::Context::disable(glw::CapabilityType::CullFace);
-		glw::Context::disable(glw::CapabilityType::DepthTest);
+	void RoundedColorRect::set_outline_color(const glm::vec4& _value) {
+		m_outline_color = _value;
+		this->_damage();
+	}
 
-		m_program->use();
-		{
-			m_program->set_mat4("uMVP", glm::value_ptr(_view_proj_matrix * _model_matrix));
-			m_program->set_vec2("uSize", static_cast<float>(m_base_width), static_cast<float>(m_base_height));
-			m_program->set_vec4("uModulate", get_modulate().r, get_modulate().g, get_modulate().b, get_modulate().a);
+	void RoundedColorRect::set_corner_radius(const float& _value) {
+		m_corner_radii = { _value, _value, _value, _value };
+		this->_damage();
+	}
 
-			const size_t _texs_len = m_textures.size();
-			m_program->set_int("uTextureCount", static_cast<int>(_texs_len));
+	void RoundedColorRect::set_corner_radii(const glm::vec4& _value) {
+		m_corner_radii = _value;
+		this->_damage();
+	}
 
-			for (size_t i = 0; i < _texs_len; i++) {
-				glw::TextureSlot _slot = static_cast<glw::TextureSlot>(static_cast<uint32_t>(glw::TextureSlot::S0) + static_cast<uint32_t>(i));
-				glw::Context::activate_texture(_slot);
-				m_textures[i]->bind();
-				m_program->set_sampler2D("uTextures[" + std::to_string(i) + "]", static_cast<int>(i));
-			}
+	void RoundedColorRect::set_shadow_enabled(bool _value) {
+		this->_damage();
+		m_shadow_enabled = _value;
+		this->_damage();
+	}
 
-			{
-				m_VAO->bind();
-				glw::Context::draw_elements(glw::PrimitiveType::Triangles, 6, glw::NumericType::UnsignedInt, 0);
-				glw::VertexArrayObject::bind_default();
-			}
-			glw::Texture::bind_default();
-		}
-		glw::Program::use_default();
+	void RoundedColorRect::set_shadow_color(const glm::vec4& _value) {
+		m_shadow_color = _value;
+		this->_damage();
+	}
 
-		glw::Context::enable(glw::CapabilityType::CullFace);
-		glw::Context::enable(glw::CapabilityType::DepthTest);
-		glw::Context::disable(glw::CapabilityType::Blend);
-		Object::draw(_cam);
+	void RoundedColorRect::set_shadow_offset(const glm::vec2& _value) {
+		this->_damage();
+		m_shadow_offset = _value;
+		this->_damage();
 	}
 
-	void BlendedSprite::set_base_size(const uint32_t& _width, const uint32_t& _height) {
-		m_base_width = _width;
-		m_base_height = _height;
+	void RoundedColorRect::set_shadow_sigma(const float& _value) {
+		this->_damage();
+		m_shadow_sigma = _value;
+		this->_damage();
 	}
 
-	void BlendedSprite::clear_textures() {
-		m_textures.clear();
+	const glm::vec2& RoundedColorRect::get_size() const{
+		return m_size;
 	}
 
-	void BlendedSprite::load_extra_texture(const std::string& _path, bool _auto_format, glw::TextureConfig _cfg) {
-		if (m_textures.size() < BlendedSprite::maximum_blended_texture_count) {
-			m_textures.emplace_back(fetch_owner()->fetch_texture(_path, _auto_format, _cfg));
-		}
+	const float& RoundedColorRect::get_outline_width() const {
+		return m_outline_width;
 	}
 
-	size_t BlendedSprite::get_loaded_texture_count() const {
-		return m_textures.size();
+	const glm::vec4& RoundedColorRect::get_outline_color() const {
+		return m_outline_color;
 	}
 
-	ColoredObject::ColoredObject(Server* _owner)
-		: Object(_owner)
-	{
+	const float& RoundedColorRect::get_corner_radius() const {
+		return m_corner_radii.x;
+	}
 
+	const glm::vec4& RoundedColorRect::get_corner_radii() const {
+		return m_corner_radii;
 	}
 
-	ColoredObject::~ColoredObject() {
+	bool RoundedColorRect::get_shadow_enabled() const {
+		return m_shadow_enabled;
+	}
 
+	const glm::vec4& RoundedColorRect::get_shadow_color() const {
+		return m_shadow_color;
 	}
 
-	void ColoredObject::update() {
-		Object::update();
+	const glm::vec2& RoundedColorRect::get_shadow_offset() const {
+		return m_shadow_offset;
 	}
 
-	void ColoredObject::draw(Camera2D* _cam) {
-		Object::draw(_cam);
+	const float& RoundedColorRect::get_shadow_sigma() const {
+		return m_shadow_sigma;
 	}
 
-	void ColoredObject::set_color(const glm::vec4& _value) {
-		m_color = _value;
+	bool RoundedColorRect::get_bounds(glm::vec4& _out) const {
+		/* The quad keeps one unit of padding for the anti-aliased edge */
+		const glm::vec2 _half_size = m_size * 0.5f + 1.0f;
+		_out = this->_transform_bounds(-_half_size, _half_size);
+		if (m_shadow_enabled) {
+			/* Three sigmas of blur, plus one for the rounding of cached masks */
+			const glm::vec2 _shadow_half_size = m_size * 0.5f + 4.0f * std::max(m_shadow_sigma, 1.0f);
+			const glm::vec4 _shadow = this->_transform_bounds(-_shadow_half_size, _shadow_half_size) + glm::vec4(m_shadow_offset.x, -m_shadow_offset.y, m_shadow_offset.x, -m_shadow_offset.y);
+			_out = { std::min(_out.x, _shadow.x), std::min(_out.y, _shadow.y), std::max(_out.z, _shadow.z), std::max(_out.w, _shadow.w) };
+		}
+		return true;
 	}
 
-	const glm::vec4& ColoredObject::get_color() const {
-		return m_color;
+	void RoundedColorRect::_add_instance(glw::BufferData& _out) const {
+		const glm::vec4 _color = get_color() * get_modulate();
+		const glm::vec4 _outline_color = m_outline_color * get_modulate();
+		_out.add_floats(glm::value_ptr(get_model_matrix()), 16);
+		_out.add_floats(glm::value_ptr(_color), 4);
+		_out.add_floats(glm::value_ptr(_outline_color), 4);
+		_out.add_float(m_corner_radii.y);
+		_out.add_float(m_corner_radii.z);
+		_out.add_float(m_corner_radii.x);
+		_out.add_float(m_corner_radii.w);
+		_out.add_float(m_size.x);
+		_out.add_float(m_size.y);
+		_out.add_float(m_outline_width);
+		_out.add_float(0.0f);
 	}
 
-	Line::Line(Server* _owner)
-		: ColoredObject(_owner)
-	{
-		std::tie(m_VAO, m_VBO, m_EBO) = get_owner()->get_glw_object_set(glwu::DrawableType::Line);
-		m_program = get_owner()->get_generic_program(glwu::DrawableType::Line);
+	void RoundedColorRect::_add_shadow_instance(glw::BufferData& _out, const ShadowMask& _mask) const {
+		const glm::vec4 _color = m_shadow_color * get_modulate();
+		/* Same y convention as set_position() */
+		const glm::mat4 _model_matrix = glm::translate(glm::mat4(1.0f), glm::vec3(m_shadow_offset.x, -m_shadow_offset.y, 0.0f)) * get_model_matrix();
+		_out.add_floats(glm::value_ptr(_model_matrix), 16);
+		_out.add_floats(glm::value_ptr(_color), 4);
+		_out.add_floats(glm::value_ptr(_color), 4);
+		for (size_t i = 0; i < 4; i++) {
+			_out.add_float(0.0f);
+		}
+		_out.add_float(m_size.x + 2.0f * _mask.Padding);
+		_out.add_float(m_size.y + 2.0f * _mask.Padding);
+		_out.add_float(0.0f);
+		_out.add_float(0.0f);
 	}
 
-	Line::~Line() {
+	const ShadowMask& RoundedColorRect::_fetch_shadow_mask() {
+		const float _largest = std::max(std::max(m_corner_radii.x, m_corner_radii.y), std::max(m_corner_radii.z, m_corner_radii.w));
+		const float _radius = std::clamp(_largest, 0.0f, 1.0f) * 0.5f * std::min(m_size.x, m_size.y);
+		return fetch_owner()->fetch_post_process()->fetch_shadow_mask(_radius, m_shadow_sigma);
+	}
 
+	ShaderFeature RoundedColorRect::_get_shader_features() const {
+		ShaderFeature _features = ShaderFeature::Instanced;
+		if (m_corner_radii != glm::vec4(0.0f)) {
+			_features = _features | ShaderFeature::Rounded;
+		}
+		if (m_outline_width > 0.0f) {
+			_features = _features | ShaderFeature::Outlined;
+		}
+		return _features;
 	}
 
-	void Line::update() {
-		ColoredObject::update();
+	void RoundedColorRect::_draw_shadows(Server* _owner, const std::vector<RoundedColorRect*>& _rects, Camera2D* _cam) {
+		std::map<const ShadowMask*, std::pair<glw::BufferData, uint32_t>> _groups { };
+		for (const auto& _rect : _rects) {
+			if (_rect->m_shadow_enabled == false) {
+				continue;
+			}
+			const ShadowMask& _mask = _rect->_fetch_shadow_mask();
+			auto& [_instances, _count] = _groups[&_mask];
+			_rect->_add_shadow_instance(_instances, _mask);
+			_count++;
+		}
+		for (const auto& [_mask, _group] : _groups) {
+			RoundedColorRect::_draw_instances(_owner, _group.first, _group.second, ShaderFeature::Shadow, _cam, _mask);
+		}
 	}
 
-	void Line::draw(Camera2D* _cam) {
-		const glm::mat4& _view_proj_matrix = (_cam != nullptr ? _cam->get_view_proj_matrix() : Camera2D::get_default_view_proj_matrix(get_owner()->get_initial_window_width(), get_owner()->get_initial_window_height()));
-		const glm::mat4& _model_matrix = get_model_matrix();
+	void RoundedColorRect::_draw_instances(Server* _owner, const glw::BufferData& _instances, uint32_t _count, ShaderFeature _features, Camera2D* _cam, const ShadowMask* _shadow) {
+		const glw::VertexArrayObject* _VAO = nullptr;
+		const glw::VertexBufferObject* _VBO = nullptr;
+		const glw::ElementBufferObject* _EBO = nullptr;
+		std::tie(_VAO, _VBO, _EBO) = _owner->get_glw_object_set(glwu::DrawableType::RoundedColorRect);
+		const glw::Program* _program = _owner->fetch_quad_program(_features);
+
+		const glm::mat4& _view_proj_matrix = (_cam != nullptr ? _cam->get_view_proj_matrix() : Camera2D::get_default_view_proj_matrix(_owner->get_initial_window_width(), _owner->get_initial_window_height()));
 
 		glw::Context::enable(glw::CapabilityType::Blend);
 		glw::Context::blend_func(glw::BlendFuncType::SrcAlpha, glw::BlendFuncType::OneMinusSrcAlpha);
 		glw::Context::disable(glw::CapabilityType::CullFace);
 		glw::Context::disable(glw::CapabilityType::DepthTest);
 
-		m_program->use();
+		_program->use();
 		{
-			m_program->set_mat4("uMVP", glm::value_ptr(_view_proj_matrix * _model_matrix));
-			m_program->set_vec4("uColor", get_color().r, get_color().g, get_color().b, get_color().a);
-			m_program->set_vec4("uModulate", get_modulate().r, get_modulate().g, get_modulate().b, get_modulate().a);
-
-			glw::Context::set_line_width(m_width);
-
-			glw::BufferData _vertices; {
-				_vertices.add_float(m_point_begin.x);
-				_vertices.add_float(-m_point_begin.y);
-				_vertices.add_float(0.0f);
-
-				_vertices.add_float(m_point_end.x);
-				_vertices.add_float(-m_point_end.y);
-				_vertices.add_float(0.0f);
+			_program->set_mat4("uViewProj", glm::value_ptr(_view_proj_matrix));
+			if (_shadow != nullptr) {
+				_program->set_vec2("uShadowSlice", _shadow->Border, _shadow->Size);
+				glw::Context::activate_texture(glw::TextureSlot::S0);
+				_shadow->Texture->bind();
+				_program->set_sampler2D("uTexture", 0);
 			}
 
-			m_VAO->bind();
+			_VBO->bind();
+			_VBO->bind_data(_instances, glw::BufferUsage::StreamDraw);
+			glw::VertexBufferObject::bind_default();
+
+			_VAO->bind();
 			{
-				m_VBO->bind();
-				m_VBO->bind_sub_data(_vertices, 0);
-				glw::Context::draw_arrays(glw::PrimitiveType::Lines, 0, 2);
+				glw::Context::draw_elements_instanced(glw::PrimitiveType::Triangles, 6, glw::NumericType::UnsignedInt, 0, _count);
 			}
 			glw::VertexArrayObject::bind_default();
-			glw::VertexBufferObject::bind_default();
+			if (_shadow != nullptr) {
+				glw::Texture::bind_default();
+			}
 		}
 		glw::Program::use_default();
 
 		glw::Context::enable(glw::CapabilityType::CullFace);
 		glw::Context::enable(glw::CapabilityType::DepthTest);
 		glw::Context::disable(glw::CapabilityType::Blend);
-		ColoredObject::draw(_cam);
-	}
-
-	void Line::set_width(const float& _value) {
-		m_width = _value;
-	}
-
-	void Line::set_begin(const glm::vec2& _value) {
-		m_point_begin = _value;
-	}
-
-	void Line::set_end(const glm::vec2& _value) {
-		m_point_end = _value;
-	}
-
-	const float& Line::get_width() const {
-		return m_width;
-	}
-
-	const glm::vec2& Line::get_begin() const {
-		return m_point_begin;
-	}
-
-	const glm::vec2& Line::get_end() const {
-		return m_point_end;
 	}
 
-	LinedRect::LinedRect(Server* _owner) 
-		: ColoredObject(_owner)
+	ParticleSystem::ParticleSystem(Server* _owner)
+		: Object(_owner)
 	{
-		std::tie(m_VAO, m_VBO, m_EBO) = get_owner()->get_glw_object_set(glwu::DrawableType::LinedRect);
-		m_program = get_owner()->get_generic_program(glwu::DrawableType::LinedRect);
+		m_update_program = get_owner()->get_particle_update_program();
+		m_program = get_owner()->get_generic_program(glwu::DrawableType::ParticleSystem);
+		for (size_t i = 0; i < 2; i++) {
+			m_VBOs[i] = new glw::VertexBufferObject();
+			m_update_VAOs[i] = new glw::VertexArrayObject();
+			m_render_VAOs[i] = new glw::VertexArrayObject();
+		}
+		this->set_capacity(ParticleSystem::default_capacity);
 	}
 
-	LinedRect::~LinedRect() {
-
+	ParticleSystem::~ParticleSystem() {
+		for (size_t i = 0; i < 2; i++) {
+			delete m_render_VAOs[i];
+			delete m_update_VAOs[i];
+			delete m_VBOs[i];
+			m_render_VAOs[i] = nullptr;
+			m_update_VAOs[i] = nullptr;
+			m_VBOs[i] = nullptr;
+		}
 	}
 
-	void LinedRect::update() {
-		ColoredObject::update();
+	void ParticleSystem::update() {
+		const double _now = glw::Context::get_time();
+		const float _delta = (m_last_time < 0.0 ? 0.0f : std::min(static_cast<float>(_now - m_last_time), ParticleSystem::maximum_delta_time));
+		m_last_time = _now;
+
+		if (m_emitting) {
+			m_emit_accumulator += m_config.Rate * _delta;
+		}
+		const size_t _emitted = static_cast<size_t>(m_emit_accumulator);
+		m_emit_accumulator -= static_cast<float>(_emitted);
+		const size_t _emit_count = std::min(_emitted + m_pending_burst, m_capacity);
+		m_pending_burst = 0;
+
+		this->_simulate(_delta, _emit_count);
+		m_emit_cursor = (m_emit_cursor + _emit_count) % m_capacity;
+		if (_emit_count > 0) {
+			m_live_until = _now + static_cast<double>(std::max(m_config.LifetimeRange.x, m_config.LifetimeRange.y));
+		}
+		/* Particles are not bounded, so the whole target is redrawn while any of them lives, and once more after */
+		const bool _live = _now <= m_live_until;
+		if (_live || m_was_live) {
+			this->_damage();
+		}
+		m_was_live = _live;
+		Object::update();
 	}
 
-	void LinedRect::draw(Camera2D* _cam) {
+	void ParticleSystem::draw(Camera2D* _cam) {
 		const glm::mat4& _view_proj_matrix = (_cam != nullptr ? _cam->get_view_proj_matrix() : Camera2D::get_default_view_proj_matrix(get_owner()->get_initial_window_width(), get_owner()->get_initial_window_height()));
-		const glm::mat4& _model_matrix = get_model_matrix();
 
 		glw::Context::enable(glw::CapabilityType::Blend);
-		glw::Context::blend_func(glw::BlendFuncType::SrcAlpha, glw::BlendFuncType::OneMinusSrcAlpha);
+		glw::Context::blend_func(glw::BlendFuncType::SrcAlpha, (m_config.Additive ? glw::BlendFuncType::One : glw::BlendFuncType::OneMinusSrcAlpha));
 		glw::Context::disable(glw::CapabilityType::CullFace);
 		glw::Context::disable(glw::CapabilityType::DepthTest);
 
 		m_program->use();
 		{
-			m_program->set_mat4("uMVP", glm::value_ptr(_view_proj_matrix * _model_matrix));
-			m_program->set_vec4("uColor", get_color().r, get_color().g, get_color().b, get_color().a);
+			m_program->set_mat4("uViewProj", glm::value_ptr(_view_proj_matrix));
+			m_program->set_vec4("uStartColor", m_config.StartColor.r, m_config.StartColor.g, m_config.StartColor.b, m_config.StartColor.a);
+			m_program->set_vec4("uEndColor", m_config.EndColor.r, m_config.EndColor.g, m_config.EndColor.b, m_config.EndColor.a);
+			m_program->set_vec2("uSizeRange", m_config.StartSize, m_config.EndSize);
 			m_program->set_vec4("uModulate", get_modulate().r, get_modulate().g, get_modulate().b, get_modulate().a);
-			m_program->set_vec2("uSize", m_size.x, m_size.y);
-
-			glw::Context::set_line_width(m_line_width);
 
-			m_VAO->bind();
+			m_render_VAOs[m_current]->bind();
 			{
-				glw::Context::draw_arrays(glw::PrimitiveType::LineLoop, 0, 4);
+				glw::Context::draw_arrays_instanced(glw::PrimitiveType::TriangleStrip, 0, 4, static_cast<uint32_t>(m_capacity));
 			}
 			glw::VertexArrayObject::bind_default();
 		}
@@ -1060,96 +5003,170 @@ void main() {
 		glw::Context::enable(glw::CapabilityType::CullFace);
 		glw::Context::enable(glw::CapabilityType::DepthTest);
 		glw::Context::disable(glw::CapabilityType::Blend);
-		ColoredObject::draw(_cam);
+		Object::draw(_cam);
 	}
 
-	void LinedRect::set_line_width(const float& _value) {
-		m_line_width = _value;
+	void ParticleSystem::set_config(const ParticleEmitterConfig& _value) {
+		m_config = _value;
+		this->_damage();
 	}
 
-	void LinedRect::set_size(const glm::vec2& _value) {
-		m_size = _value;
+	void ParticleSystem::set_capacity(size_t _value) {
+		if (_value == 0) { _value = 1; }
+		m_capacity = _value;
+		m_current = 0;
+		m_emit_cursor = 0;
+		m_live_until = -1.0;
+		m_was_live = false;
+		this->_damage();
+
+		/* Zeroed state reads as age == lifetime == 0, so every slot starts out dead. */
+		const std::vector<float> _zeros(m_capacity * (ParticleSystem::particle_stride / sizeof(float)), 0.0f);
+		for (size_t i = 0; i < 2; i++) {
+			m_VBOs[i]->bind();
+			m_VBOs[i]->bind_empty_data(m_capacity * ParticleSystem::particle_stride, glw::BufferUsage::DynamicCopy);
+			m_VBOs[i]->bind_sub_data(_zeros.data(), _zeros.size() * sizeof(float), 0);
+
+			m_update_VAOs[i]->bind();
+			{
+				m_update_VAOs[i]->attrib_pointer(0, 4, glw::NumericType::Float, ParticleSystem::particle_stride, 0);
+				m_update_VAOs[i]->attrib_pointer(1, 4, glw::NumericType::Float, ParticleSystem::particle_stride, sizeof(float) * 4);
+			}
+			m_render_VAOs[i]->bind();
+			{
+				m_render_VAOs[i]->attrib_pointer(0, 4, glw::NumericType::Float, ParticleSystem::particle_stride, 0);
+				m_render_VAOs[i]->attrib_divisor(0, 1);
+				m_render_VAOs[i]->attrib_pointer(1, 4, glw::NumericType::Float, ParticleSystem::particle_stride, sizeof(float) * 4);
+				m_render_VAOs[i]->attrib_divisor(1, 1);
+			}
+			glw::VertexArrayObject::bind_default();
+		}
+		glw::VertexBufferObject::bind_default();
 	}
 
-	const float& LinedRect::get_line_width() const {
-		return m_line_width;
+	void ParticleSystem::set_emitting(bool _value) {
+		m_emitting = _value;
 	}
 
-	const glm::vec2& LinedRect::get_size() const {
-		return m_size;
+	void ParticleSystem::burst(size_t _count) {
+		m_pending_burst += _count;
 	}
 
-	ColorRect::ColorRect(Server* _owner)
-		: ColoredObject(_owner)
-	{
-		std::tie(m_VAO, m_VBO, m_EBO) = get_owner()->get_glw_object_set(glwu::DrawableType::ColorRect);
-		m_program = get_owner()->get_generic_program(glwu::DrawableType::ColorRect);
+	const ParticleEmitterConfig& ParticleSystem::get_config() const {
+		return m_config;
 	}
 
-	ColorRect::~ColorRect() {
-
+	size_t ParticleSystem::get_capacity() const {
+		return m_capacity;
 	}
 
-	void ColorRect::update() {
-		ColoredObject::update();
+	bool ParticleSystem::get_emitting() const {
+		return m_emitting;
 	}
 
-	void ColorRect::draw(Camera2D* _cam) {
-		const glm::mat4& _view_proj_matrix = (_cam != nullptr ? _cam->get_view_proj_matrix() : Camera2D::get_default_view_proj_matrix(get_owner()->get_initial_window_width(), get_owner()->get_initial_window_height()));
-		const glm::mat4& _model_matrix = get_model_matrix();
+	void ParticleSystem::_simulate(float _delta, size_t _emit_count) {
+		const size_t _next = 1 - m_current;
 
-		glw::Context::enable(glw::CapabilityType::Blend);
-		glw::Context::blend_func(glw::BlendFuncType::SrcAlpha, glw::BlendFuncType::OneMinusSrcAlpha);
-		glw::Context::disable(glw::CapabilityType::CullFace);
-		glw::Context::disable(glw::CapabilityType::DepthTest);
+		glw::Context::enable(glw::CapabilityType::RasterizerDiscard);
 
-		m_program->use();
+		m_update_program->use();
 		{
-			m_program->set_mat4("uMVP", glm::value_ptr(_view_proj_matrix * _model_matrix));
-			m_program->set_vec4("uColor", get_color().r, get_color().g, get_color().b, get_color().a);
-			m_program->set_vec4("uModulate", get_modulate().r, get_modulate().g, get_modulate().b, get_modulate().a);
-			m_program->set_vec2("uSize", m_size.x, m_size.y);
-
-			m_VAO->bind();
+			m_update_program->set_float("uDeltaTime", _delta);
+			m_update_program->set_uint("uSeed", m_seed++);
+			m_update_program->set_int("uCapacity", static_cast<int>(m_capacity));
+			m_update_program->set_int("uEmitBegin", static_cast<int>(m_emit_cursor));
+			m_update_program->set_int("uEmitCount", static_cast<int>(_emit_count));
+			m_update_program->set_vec2("uEmitterPosition", get_position().x, get_position().y);
+			m_update_program->set_float("uEmitterRadius", m_config.Radius);
+			m_update_program->set_float("uDirection", m_config.Direction + get_rotation());
+			m_update_program->set_float("uSpread", m_config.Spread);
+			m_update_program->set_vec2("uSpeedRange", m_config.SpeedRange.x, m_config.SpeedRange.y);
+			m_update_program->set_vec2("uLifetimeRange", m_config.LifetimeRange.x, m_config.LifetimeRange.y);
+			m_update_program->set_vec2("uAcceleration", m_config.Acceleration.x, m_config.Acceleration.y);
+			m_update_program->set_float("uDamping", m_config.Damping);
+
+			m_update_VAOs[m_current]->bind();
+			m_VBOs[_next]->bind_base(glw::ArrayBufferType::TransformFeedbackBuffer, 0);
 			{
-				glw::Context::draw_elements(glw::PrimitiveType::Triangles, 6, glw::NumericType::UnsignedInt, 0);
+				glw::Context::begin_transform_feedback(glw::PrimitiveType::Points);
+				glw::Context::draw_arrays(glw::PrimitiveType::Points, 0, static_cast<uint32_t>(m_capacity));
+				glw::Context::end_transform_feedback();
 			}
+			glw::Context::bind_buffer_base(glw::ArrayBufferType::TransformFeedbackBuffer, 0, 0U);
 			glw::VertexArrayObject::bind_default();
 		}
 		glw::Program::use_default();
 
-		glw::Context::enable(glw::CapabilityType::CullFace);
-		glw::Context::enable(glw::CapabilityType::DepthTest);
-		glw::Context::disable(glw::CapabilityType::Blend);
-		ColoredObject::draw(_cam);
+		glw::Context::disable(glw::CapabilityType::RasterizerDiscard);
+		m_current = _next;
 	}
 
-	void ColorRect::set_size(const glm::vec2& _value){
-		m_size = _value;
+	RectBatch::RectBatch(Server* _owner)
+		: Object(_owner),
+		m_batch_VAO(new glw::VertexArrayObject()),
+		m_instance_VBO(new glw::VertexBufferObject()),
+		m_group_SSBO(new glw::ShaderStorageBufferObject()),
+		m_command_buffer(new glw::DrawIndirectBufferObject())
+	{
+		m_program = get_owner()->get_generic_program(glwu::DrawableType::RectBatch);
+
+		const auto& [_sprite_VAO, _sprite_VBO, _sprite_EBO] = get_owner()->get_glw_object_set(glwu::DrawableType::Sprite);
+		m_batch_VAO->bind();
+		{
+			_sprite_VBO->bind();
+			_sprite_EBO->bind();
+			m_batch_VAO->attrib_pointer(0, 3, glw::NumericType::Float, sizeof(float) * 3 + sizeof(float) * 2, 0);
+			m_instance_VBO->bind();
+			m_instance_VBO->bind_empty_data(RectBatch::instance_stride, glw::BufferUsage::StaticDraw);
+			m_batch_VAO->attrib_pointer(1, 4, glw::NumericType::Float, RectBatch::instance_stride, 0);
+			m_batch_VAO->attrib_divisor(1, 1);
+			m_batch_VAO->attrib_pointer(2, 4, glw::NumericType::Float, RectBatch::instance_stride, sizeof(float) * 4);
+			m_batch_VAO->attrib_divisor(2, 1);
+		}
+		glw::VertexArrayObject::bind_default();
+		glw::VertexBufferObject::bind_default();
+		glw::ElementBufferObject::bind_default();
 	}
 
-	const glm::vec2& ColorRect::get_size() const {
-		return m_size;
+	RectBatch::~RectBatch() {
+		delete m_batch_VAO;
+		delete m_instance_VBO;
+		delete m_group_SSBO;
+		delete m_command_buffer;
+		m_batch_VAO = nullptr;
+		m_instance_VBO = nullptr;
+		m_group_SSBO = nullptr;
+		m_command_buffer = nullptr;
 	}
 
-	RoundedColorRect::RoundedColorRect(Server* _owner) 
-		: ColoredObject(_owner)
-	{
-		std::tie(m_VAO, m_VBO, m_EBO) = get_owner()->get_glw_object_set(glwu::DrawableType::RoundedColorRect);
-		m_program = get_owner()->get_generic_program(glwu::DrawableType::RoundedColorRect);
+	void RectBatch::update() {
+		Object::update();
 	}
 
-	RoundedColorRect::~RoundedColorRect() {
+	void RectBatch::draw(Camera2D* _cam) {
+		if (m_groups.empty()) { return; }
+		if (m_need_to_upload) {
+			m_need_to_upload = false;
+			this->_upload();
+		}
 
-	}
-	
-	void RoundedColorRect::update() {
-		ColoredObject::update();
-	}
-	
-	void RoundedColorRect::draw(Camera2D* _cam) {
 		const glm::mat4& _view_proj_matrix = (_cam != nullptr ? _cam->get_view_proj_matrix() : Camera2D::get_default_view_proj_matrix(get_owner()->get_initial_window_width(), get_owner()->get_initial_window_height()));
-		const glm::mat4& _model_matrix = get_model_matrix();
+		const glm::mat4 _mvp = _view_proj_matrix * get_model_matrix();
+		const uint32_t _group_count = static_cast<uint32_t>(m_groups.size());
+
+		if (m_culling) {
+			const glw::ComputeProgram* _cull_program = fetch_owner()->fetch_rect_batch_cull_program();
+			_cull_program->use();
+			{
+				_cull_program->set_mat4("uMVP", glm::value_ptr(_mvp));
+				_cull_program->set_uint("uGroupCount", _group_count);
+				m_group_SSBO->bind_base(0);
+				m_command_buffer->bind_base(glw::ArrayBufferType::ShaderStorageBuffer, 1);
+				_cull_program->dispatch(_cull_program->get_group_count(_group_count));
+				glw::Context::memory_barrier(glw::MemoryBarrierType::Command);
+			}
+			glw::Program::use_default();
+		}
 
 		glw::Context::enable(glw::CapabilityType::Blend);
 		glw::Context::blend_func(glw::BlendFuncType::SrcAlpha, glw::BlendFuncType::OneMinusSrcAlpha);
@@ -1158,18 +5175,15 @@ void main() {
 
 		m_program->use();
 		{
-			m_program->set_mat4("uMVP", glm::value_ptr(_view_proj_matrix * _model_matrix));
-			m_program->set_vec4("uColor", get_color().r, get_color().g, get_color().b, get_color().a);
+			m_program->set_mat4("uMVP", glm::value_ptr(_mvp));
 			m_program->set_vec4("uModulate", get_modulate().r, get_modulate().g, get_modulate().b, get_modulate().a);
-			m_program->set_vec2("uSize", m_size.x, m_size.y);
-			m_program->set_float("uCornerRadius", m_corner_radius);
-			m_program->set_float("uOutlineWidth", m_outline_width);
-			m_program->set_vec4("uOutlineColor", m_outline_color.r, m_outline_color.g, m_outline_color.b, m_outline_color.a);
 
-			m_VAO->bind();
+			m_batch_VAO->bind();
+			m_command_buffer->bind();
 			{
-				glw::Context::draw_elements(glw::PrimitiveType::Triangles, 6, glw::NumericType::UnsignedInt, 0);
+				glw::Context::multi_draw_elements_indirect(glw::PrimitiveType::Triangles, glw::NumericType::UnsignedInt, 0, _group_count, sizeof(glw::DrawElementsIndirectCommand));
 			}
+			glw::DrawIndirectBufferObject::bind_default();
 			glw::VertexArrayObject::bind_default();
 		}
 		glw::Program::use_default();
@@ -1177,38 +5191,104 @@ void main() {
 		glw::Context::enable(glw::CapabilityType::CullFace);
 		glw::Context::enable(glw::CapabilityType::DepthTest);
 		glw::Context::disable(glw::CapabilityType::Blend);
-		ColoredObject::draw(_cam);
+		Object::draw(_cam);
 	}
 
-	void RoundedColorRect::set_size(const glm::vec2& _value) {
-		m_size = _value;
+	size_t RectBatch::add_group() {
+		m_groups.emplace_back();
+		m_need_to_upload = true;
+		return m_groups.size() - 1;
 	}
 
-	void RoundedColorRect::set_outline_width(const float& _value) {
-		m_outline_width = _value;
+	void RectBatch::add_rect(size_t _group, const glm::vec2& _position, const glm::vec2& _size, const glm::vec4& _color) {
+		m_groups.at(_group).emplace_back(_position.x, _position.y, _size.x, _size.y);
+		m_groups.at(_group).emplace_back(_color);
+		m_need_to_upload = true;
+		this->_damage({ _position.x - _size.x * 0.5f, -_position.y - _size.y * 0.5f }, { _position.x + _size.x * 0.5f, -_position.y + _size.y * 0.5f });
 	}
 
-	void RoundedColorRect::set_outline_color(const glm::vec4& _value) {
-		m_outline_color = _value;
+	void RectBatch::clear_group(size_t _group) {
+		m_groups.at(_group).clear();
+		m_need_to_upload = true;
+		this->_damage();
 	}
 
-	void RoundedColorRect::set_corner_radius(const float& _value) {
-		m_corner_radius = _value;
+	void RectBatch::clear() {
+		m_groups.clear();
+		m_need_to_upload = true;
+		this->_damage();
 	}
 
-	const glm::vec2& RoundedColorRect::get_size() const{
-		return m_size;
+	void RectBatch::set_culling(bool _value) {
+		if (m_culling == _value) { return; }
+		m_culling = _value;
+		m_need_to_upload = true;
 	}
 
-	const float& RoundedColorRect::get_outline_width() const {
-		return m_outline_width;
+	bool RectBatch::get_culling() const {
+		return m_culling;
 	}
 
-	const glm::vec4& RoundedColorRect::get_outline_color() const {
-		return m_outline_color;
+	size_t RectBatch::get_group_count() const {
+		return m_groups.size();
 	}
 
-	const float& RoundedColorRect::get_corner_radius() const {
-		return m_corner_radius;
+	size_t RectBatch::get_rect_count() const {
+		size_t _count = 0;
+		for (const auto& _group : m_groups) {
+			_count += _group.size() / 2;
+		}
+		return _count;
+	}
+
+	void RectBatch::_upload() {
+		glw::BufferData _instances;
+		glw::BufferData _groups;
+		std::vector<glw::DrawElementsIndirectCommand> _commands(m_groups.size());
+
+		uint32_t _base_instance = 0U;
+		for (size_t i = 0; i < m_groups.size(); i++) {
+			const auto& _group = m_groups[i];
+			glm::vec2 _min { std::numeric_limits<float>::max() };
+			glm::vec2 _max { -std::numeric_limits<float>::max() };
+			for (size_t j = 0; j < _group.size(); j += 2) {
+				const glm::vec2 _center { _group[j].x, _group[j].y };
+				const glm::vec2 _half { _group[j].z * 0.5f, _group[j].w * 0.5f };
+				_min = glm::min(_min, _center - _half);
+				_max = glm::max(_max, _center + _half);
+				_instances.add_floats(glm::value_ptr(_group[j]), 4);
+				_instances.add_floats(glm::value_ptr(_group[j + 1]), 4);
+			}
+			const uint32_t _rect_count = static_cast<uint32_t>(_group.size() / 2);
+
+			_groups.add_float(_min.x);
+			_groups.add_float(_min.y);
+			_groups.add_float(_max.x);
+			_groups.add_float(_max.y);
+			_groups.add_uint32(_rect_count);
+			_groups.add_uint32(_base_instance);
+			_groups.add_uint32(0U);
+			_groups.add_uint32(0U);
+
+			_commands[i].Count = 6U;
+			_commands[i].InstanceCount = _rect_count;
+			_commands[i].BaseInstance = _base_instance;
+			_base_instance += _rect_count;
+		}
+
+		if (_instances.get_length() > 0) {
+			m_instance_VBO->bind();
+			m_instance_VBO->bind_data(_instances, glw::BufferUsage::StaticDraw);
+			glw::VertexBufferObject::bind_default();
+		}
+
+		m_group_SSBO->bind();
+		m_group_SSBO->bind_data(_groups, glw::BufferUsage::StaticDraw);
+		glw::ShaderStorageBufferObject::bind_default();
+
+		m_command_buffer->bind();
+		m_command_buffer->bind_empty_data(sizeof(glw::DrawElementsIndirectCommand) * _commands.size(), glw::BufferUsage::DynamicDraw);
+		m_command_buffer->bind_sub_data(_commands.data(), sizeof(glw::DrawElementsIndirectCommand) * _commands.size(), 0);
+		glw::DrawIndirectBufferObject::bind_default();
 	}
 }
\ No newline at end of file
@@ -12,14 +12,26 @@
 
 	Features
 		Buffer object & Program Caching
+		Memory-mapped Asset Pack
+		Texture Streaming & VRAM Budget
+		Background Uploads
+		Shader Hot-reload
+		Quad Shader Permutations
+		Render Target Pool
+		Render Graph
+		Post-processing (Blur, Bloom, Drop Shadows)
+		Partial Redraw
 		Object interface
 			Sprite
 			BlendedSprite
 			Camera
 			Line
 			LinedRect
+			Polyline
 			ColorRect
 			RoundedColorRect
+			ParticleSystem
+			RectBatch
 	Dependencies
 		glw
 			C++ 17+
@@ -33,6 +45,18 @@
 #include <stdexcept> // std::runtime_error
 #include <vector>    // std::vector
 #include <tuple>     // std::tuple
+#include <limits>    // std::numeric_limits
+#include <fstream>   // std::ifstream, std::ofstream
+#include <filesystem> // std::filesystem
+#include <string_view> // std::string_view
+#include <algorithm> // std::min, std::max, std::sort
+#include <memory>    // std::shared_ptr, std::weak_ptr
+#include <mutex>     // std::mutex
+#include <thread>    // std::this_thread
+#include <queue>     // std::queue
+#include <set>       // std::set
+#include <deque>     // std::deque
+#include <condition_variable> // std::condition_variable
 /* glw */
 #include <glw.hpp>
 /* stb_image */
@@ -53,17 +77,107 @@ namespace glwu {
 			STBILoadingFailure(const std::string& _path)
 				: std::runtime_error("[STBI] : Failed to load image : Path = " + _path) { }
 		};
+		class TextureFileLoadingFailure : public std::runtime_error {
+		public:
+			TextureFileLoadingFailure(const std::string& _path, const std::string& _reason)
+				: std::runtime_error("[GLWU] : Failed to load texture file : Path = " + _path + " : Reason = " + _reason) { }
+		};
+		class AssetPackLoadingFailure : public std::runtime_error {
+		public:
+			AssetPackLoadingFailure(const std::string& _path, const std::string& _reason)
+				: std::runtime_error("[GLWU] : Failed to load asset pack : Path = " + _path + " : Reason = " + _reason) { }
+		};
+		class RenderTargetPoolFailure : public std::runtime_error {
+		public:
+			RenderTargetPoolFailure(const std::string& _reason)
+				: std::runtime_error("[GLWU] : Render target pool failure : Reason = " + _reason) { }
+		};
+		class RenderGraphFailure : public std::runtime_error {
+		public:
+			RenderGraphFailure(const std::string& _name, const std::string& _reason)
+				: std::runtime_error("[GLWU] : Invalid render graph : Name = " + _name + " : Reason = " + _reason) { }
+		};
+		class PartialRedrawFailure : public std::runtime_error {
+		public:
+			PartialRedrawFailure(const std::string& _reason)
+				: std::runtime_error("[GLWU] : Partial redraw failure : Reason = " + _reason) { }
+		};
 	}
 
 	enum class DrawableType {
 		Sprite,
+		LayeredSprite,
 		BlendedSprite,
 		Line,
 		LinedRect,
+		Polyline,
 		ColorRect,
-		RoundedColorRect
+		RoundedColorRect,
+		ParticleSystem,
+		RectBatch
+	};
+
+	/* Fullscreen programs of PostProcess, see Server::fetch_post_process_program() */
+	enum class PostProcessPass : uint32_t {
+		Downsample,
+		Blur,
+		Upsample,
+		Composite,
+		RoundedMask
+	};
+
+	enum class LineCap : uint32_t {
+		Butt = 0,
+		Square,
+		Round
+	};
+
+	enum class LineJoin : uint32_t {
+		Miter = 0,
+		Round
 	};
 
+	/* Permutation bits of the quad uber-shader. Server::fetch_quad_program() turns each into a #define. */
+	enum class ShaderFeature : uint32_t {
+		None = 0U,
+		/* TEXTURED : samples uTexture as is */
+		Textured = 1U << 0,
+		/* INSTANCED : reads the per-instance layout of RoundedColorRect instead of uMVP, uSize and uColor */
+		Instanced = 1U << 1,
+		/* ROUNDED : rounded corners, implies Instanced */
+		Rounded = 1U << 2,
+		/* OUTLINED : outline band, implies Instanced */
+		Outlined = 1U << 3,
+		/* SHADOW : nine-slices the blurred mask in uTexture instead of shading a box, implies Instanced and excludes the others */
+		Shadow = 1U << 4,
+		/* TEXTURE_COUNT : blends uTextures[0 .. n - 1] over each other (BlendedSprite), implies Textured. Set with shader_texture_count(). */
+		TextureCountMask = 7U << 8
+	};
+
+	_GLW_FLAG_COMPOSITION(ShaderFeature, uint32_t);
+
+	static constexpr uint32_t shader_texture_count_shift = 8U;
+	static constexpr uint32_t maximum_shader_texture_count = 4U;
+
+	static inline ShaderFeature shader_texture_count(uint32_t _count) {
+		return static_cast<ShaderFeature>(std::min(_count, maximum_shader_texture_count) << shader_texture_count_shift);
+	}
+
+	struct TextureLayer;
+	struct TextureImage;
+	struct TextureResidency;
+	struct TextureReleaseQueue;
+	struct PendingProgram;
+	struct UploadJob;
+	struct AssetPackHeader;
+	struct AssetPackEntry;
+
+	class AssetPack;
+	class ShaderRegistry;
+	class UploadThread;
+	class RenderTargetPool;
+	class RenderGraph;
+	class PostProcess;
 	class Server;
 	class Object;
 		class Camera2D;
@@ -72,8 +186,471 @@ namespace glwu {
 		class ColoredObject;
 			class Line;
 			class LinedRect;
+			class Polyline;
 			class ColorRect;
 			class RoundedColorRect;
+		class ParticleSystem;
+		class RectBatch;
+
+	struct ParticleEmitterConfig;
+
+	struct RenderTargetDesc;
+	struct RenderTarget;
+	struct RenderGraphTarget;
+	struct RenderGraphPass;
+	struct BloomConfig;
+	struct ShadowMask;
+
+	/* Shared ownership of a fetched texture. The texture is deleted by the first Server::end_frame() after the last reference drops. */
+	using TextureRef = std::shared_ptr<const glw::Texture>;
+
+	/* One layer of a GL_TEXTURE_2D_ARRAY shared by every same-sized image with the same config */
+	struct TextureLayer {
+		const glw::Texture* Texture = nullptr;
+		uint32_t Layer = 0U;
+	};
+
+	/* Decoded or block-compressed pixels, largest level first. Levels point into Data. */
+	struct TextureImage {
+		glw::InternalFormat FormatInternal = glw::InternalFormat::RGBA;
+		glw::TextureFormat FormatTexture = glw::TextureFormat::RGBA;
+		glw::DataType FormatData = glw::DataType::UnsignedByte;
+		uint32_t Channels = 0U;
+		bool Compressed = true;
+		std::vector<unsigned char> Data { };
+		std::vector<glw::CompressedTextureLevel> Levels { };
+	};
+
+	/* Where a fetched texture comes from and how much of it is on the GPU */
+	struct TextureResidency {
+		glw::Texture* Texture = nullptr;
+		std::string Path { };
+		bool AutoFormat = false;
+		glw::TextureConfig Config { };
+		/* Source levels, kept only until every level is resident */
+		TextureImage Image { };
+		size_t ResidentBytes = 0ULL;
+		uint64_t LastUsedFrame = 0ULL;
+	};
+
+	/* A program whose compile and link were submitted, but whose status has not been checked yet */
+	struct PendingProgram {
+		glw::Program* Program = nullptr;
+		std::vector<const char*> Sources { };
+		std::vector<const glw::Shader*> Shaders { };
+		bool Cached = false;
+	};
+
+	/* Filled by TextureRef deleters, which may run on any thread */
+	struct TextureReleaseQueue {
+		std::mutex Mutex { };
+		std::vector<const glw::Texture*> Textures { };
+	};
+
+	/*
+		Asset pack layout (little-endian) :
+			AssetPackHeader
+			AssetPackEntry[EntryCount]
+			name table (NameTableLength bytes, names are not null-terminated)
+			pixel data, every entry aligned to AssetPackAlignment
+	*/
+	static constexpr uint32_t AssetPackMagic = 0x50574C47U; /* "GLWP" */
+	static constexpr uint32_t AssetPackVersion = 1U;
+	static constexpr uint64_t AssetPackAlignment = 16U;
+
+	struct AssetPackHeader {
+		uint32_t Magic = AssetPackMagic;
+		uint32_t Version = AssetPackVersion;
+		uint32_t EntryCount = 0U;
+		uint32_t NameTableLength = 0U;
+	};
+
+	/* Data holds Width * Height * Channels unsigned bytes, rows bottom-up when FlippedY is set. */
+	struct AssetPackEntry {
+		uint64_t DataOffset = 0U;
+		uint64_t DataLength = 0U;
+		uint32_t NameOffset = 0U;
+		uint32_t NameLength = 0U;
+		uint32_t Width = 0U;
+		uint32_t Height = 0U;
+		uint32_t Channels = 0U;
+		uint32_t FlippedY = 0U;
+	};
+
+	static_assert(sizeof(AssetPackHeader) == 16, "AssetPackHeader must be tightly packed");
+	static_assert(sizeof(AssetPackEntry) == 40, "AssetPackEntry must be tightly packed");
+
+	/* Read-only mapping of a whole pack. Entry data stays valid for the lifetime of the pack. */
+	class AssetPack final {
+	private:
+		std::string m_path { };
+		const unsigned char* m_data = nullptr;
+		size_t m_length = 0U;
+#ifdef _WIN32
+		void* m_file_handle = nullptr;
+		void* m_mapping_handle = nullptr;
+#else
+		int m_file_descriptor = -1;
+#endif
+	private:
+		std::map<std::string_view, const AssetPackEntry*> m_entry_map { };
+	public:
+		AssetPack() = delete;
+		AssetPack(const std::string& _path);
+		AssetPack(const AssetPack&) = delete;
+		AssetPack& operator=(const AssetPack&) = delete;
+		~AssetPack();
+	public:
+		const AssetPackEntry* find(const std::string_view& _name) const;
+		const unsigned char* get_data(const AssetPackEntry* _entry) const;
+	public:
+		const std::string& path() const;
+		size_t entry_count() const;
+	private:
+		void _unmap();
+	};
+
+	/* Work for the upload thread's context, and what the render thread does once the GPU has finished it */
+	struct UploadJob {
+		std::function<void()> Work { };
+		std::function<void()> OnReady { };
+		GLsync Fence = nullptr;
+		std::exception_ptr Error = nullptr;
+	};
+
+	/*
+		Runs uploads on its own thread, through a hidden context shared with the main window. Each job is followed
+		by a fence, and collect() hands finished jobs to the render thread once their fence has signaled, without waiting.
+		Only textures, buffers and other shareable objects may be created by Work (not VAOs or FBOs).
+	*/
+	class UploadThread final {
+	private:
+		glw::Window* m_context_window = nullptr;
+		std::thread m_thread { };
+		mutable std::mutex m_mutex { };
+		std::condition_variable m_condition { };
+		std::deque<UploadJob> m_jobs { };
+		std::deque<UploadJob> m_fenced_jobs { };
+		bool m_stopping = false;
+	public:
+		UploadThread() = delete;
+		/* Call on the main thread, which creates the hidden window */
+		UploadThread(glw::Window* _main_window);
+		UploadThread(const UploadThread&) = delete;
+		UploadThread& operator=(const UploadThread&) = delete;
+		/* Jobs that have not reached the render thread are dropped without running OnReady */
+		~UploadThread();
+	public:
+		void submit(std::function<void()> _work, std::function<void()> _on_ready);
+		/* Render thread. Runs OnReady of every job whose fence has signaled, in submission order, and rethrows errors from Work. */
+		void collect();
+		size_t pending_count() const;
+	private:
+		void _run();
+	};
+
+	/* Index of a target in the RenderGraph being built */
+	using RenderTargetHandle = uint32_t;
+
+	/* Size and format of a pooled or render graph target */
+	struct RenderTargetDesc {
+		uint32_t Width = 0U;
+		uint32_t Height = 0U;
+		glw::InternalFormat Format = glw::InternalFormat::RGBA8;
+		glw::FilterType Filter = glw::FilterType::Linear;
+		/* Above 1, the target is a multisampled renderbuffer that cannot be sampled. Not supported by RenderGraph. */
+		uint32_t Samples = 1U;
+	};
+
+	/* A framebuffer with a single attachment, handed out by RenderTargetPool */
+	struct RenderTarget {
+		RenderTargetDesc Desc { };
+		glw::FrameBufferObject* Framebuffer = nullptr;
+		/* Set when Desc.Samples is 1 */
+		glw::Texture* Texture = nullptr;
+		/* Set when Desc.Samples is above 1 */
+		glw::RenderBufferObject* RenderBuffer = nullptr;
+		uint64_t LastUsedFrame = 0ULL;
+		bool InUse = false;
+	};
+
+	/*
+		Hands out framebuffer and texture pairs for the current frame and recycles them, keyed by size, format, filter and samples.
+		Targets left acquired are released by end_frame(), and targets unused for more than get_retained_frames() frames are deleted,
+		so after a resize the old sizes age out instead of being reallocated up front.
+		Allocation binds the default framebuffer, so acquire before binding a framebuffer of your own.
+	*/
+	class RenderTargetPool final {
+		using TargetKey = std::tuple<uint32_t, uint32_t, glw::InternalFormat, glw::FilterType, uint32_t>;
+	private:
+		std::multimap<TargetKey, RenderTarget*> m_target_map { };
+		uint32_t m_reference_width = 0U;
+		uint32_t m_reference_height = 0U;
+		uint32_t m_retained_frames = 2U;
+		uint64_t m_frame_index = 0ULL;
+		size_t m_in_use_count = 0ULL;
+		size_t m_memory_usage = 0ULL;
+	public:
+		RenderTargetPool() = delete;
+		/* The reference size is what acquire_scaled() scales, usually the window size */
+		RenderTargetPool(uint32_t _reference_width, uint32_t _reference_height);
+		RenderTargetPool(const RenderTargetPool&) = delete;
+		RenderTargetPool& operator=(const RenderTargetPool&) = delete;
+		~RenderTargetPool();
+	public:
+		/* Valid until release() or end_frame() */
+		RenderTarget* acquire(const RenderTargetDesc& _desc);
+		/* Sized as a fraction of the reference size, e.g. 0.5f for a half resolution target */
+		RenderTarget* acquire_scaled(float _scale, glw::InternalFormat _format = glw::InternalFormat::RGBA8, glw::FilterType _filter = glw::FilterType::Linear, uint32_t _samples = 1U);
+		void release(RenderTarget* _target);
+		/*
+			Blits a multisampled target into a single-sampled one of the same desc, acquired here, and releases _source.
+			The result can be sampled or blitted on to the window. Single-sampled sources are returned as they are.
+		*/
+		RenderTarget* resolve(RenderTarget* _source);
+		void end_frame();
+		/* Deletes every target that is not acquired */
+		void clear();
+	public:
+		/* Call when the window is resized */
+		void set_reference_size(uint32_t _width, uint32_t _height);
+		const uint32_t& get_reference_width() const;
+		const uint32_t& get_reference_height() const;
+		void set_retained_frames(const uint32_t& _value);
+		const uint32_t& get_retained_frames() const;
+	public:
+		size_t get_target_count() const;
+		const size_t& get_in_use_count() const;
+		/* Approximate */
+		const size_t& get_memory_usage() const;
+	public:
+		static glw::AttachmentType get_attachment_type(glw::InternalFormat _format, uint32_t _color_index = 0U);
+		static glw::TextureConfig make_texture_config(const RenderTargetDesc& _desc);
+		static size_t get_pixel_size(glw::InternalFormat _format);
+	private:
+		RenderTarget* _create_target(const RenderTargetDesc& _desc);
+		void _delete_target(RenderTarget* _target);
+		static TargetKey _make_key(const RenderTargetDesc& _desc);
+	};
+
+	struct RenderGraphTarget {
+		std::string Name { };
+		RenderTargetDesc Desc { };
+		/* Texture given to import_texture(), never aliased nor invalidated */
+		const glw::Texture* Imported = nullptr;
+		/* Texture assigned by compile(), shared by targets with equal descs whose lifetimes do not overlap */
+		glw::Texture* Aliased = nullptr;
+		bool Backbuffer = false;
+		bool Output = false;
+		int32_t FirstPass = -1;
+		int32_t LastPass = -1;
+	};
+
+	struct RenderGraphPass {
+		std::string Name { };
+		std::vector<RenderTargetHandle> Reads { };
+		std::vector<RenderTargetHandle> Writes { };
+		std::function<void(const RenderGraph&)> Execute { };
+		bool Culled = true;
+		glw::FrameBufferObject* Framebuffer = nullptr;
+		/* Attachments whose previous contents are dead when the pass starts, and the ones nobody reads after it */
+		std::vector<glw::AttachmentType> InvalidateBefore { };
+		std::vector<glw::AttachmentType> InvalidateAfter { };
+	};
+
+	/*
+		Passes declare the targets they read and write, in execution order, and compile() works out the rest :
+		passes none of whose writes reach an output are culled, transient targets with equal descs share a texture
+		once the previous one is dead, each set of write targets gets one cached FBO, and attachments are invalidated
+		where their contents stop mattering. Build the graph again every frame after reset(); textures and FBOs are kept.
+		A pass writes either the backbuffer or any number of color targets plus at most one depth target.
+	*/
+	class RenderGraph final {
+		using TargetKey = std::tuple<uint32_t, uint32_t, glw::InternalFormat, glw::FilterType>;
+		using FramebufferKey = std::vector<const glw::Texture*>;
+	private:
+		std::vector<RenderGraphTarget> m_targets { };
+		std::vector<RenderGraphPass> m_passes { };
+		bool m_compiled = false;
+	private:
+		std::vector<std::pair<TargetKey, glw::Texture*>> m_textures { };
+		std::map<FramebufferKey, glw::FrameBufferObject*> m_framebuffer_map { };
+		std::set<const glw::Texture*> m_used_textures { };
+		std::set<const glw::FrameBufferObject*> m_used_framebuffers { };
+	public:
+		RenderGraph() = default;
+		RenderGraph(const RenderGraph&) = delete;
+		RenderGraph& operator=(const RenderGraph&) = delete;
+		~RenderGraph();
+	public:
+		RenderTargetHandle create_target(const std::string& _name, const RenderTargetDesc& _desc);
+		/* Written imported targets are outputs. Their FBOs stay cached until trim(), so trim() after deleting one. */
+		RenderTargetHandle import_texture(const std::string& _name, const glw::Texture* _tex);
+		RenderTargetHandle import_backbuffer(uint32_t _width, uint32_t _height);
+		/* Keeps a transient target alive after execute(), until reset() */
+		void mark_output(RenderTargetHandle _target);
+		void add_pass(const std::string& _name, const std::vector<RenderTargetHandle>& _reads, const std::vector<RenderTargetHandle>& _writes, std::function<void(const RenderGraph&)> _execute);
+		void compile();
+		/* Compiles if needed. Each pass runs with its framebuffer bound and the viewport set to its write targets. */
+		void execute();
+		/* Forgets the passes and targets of this frame */
+		void reset();
+		/* Deletes the textures and FBOs the last compile() did not use */
+		void trim();
+	public:
+		/* Valid inside execute(), and afterwards for outputs */
+		const glw::Texture* get_texture(RenderTargetHandle _target) const;
+		size_t get_pass_count() const;
+		size_t get_culled_pass_count() const;
+		size_t get_texture_count() const;
+		size_t get_framebuffer_count() const;
+	private:
+		void _cull();
+		void _compute_lifetimes();
+		void _assign_textures();
+		void _create_framebuffers();
+		glw::Texture* _acquire_texture(const RenderTargetDesc& _desc, std::vector<std::pair<TargetKey, glw::Texture*>>& _free);
+		const RenderGraphTarget& _get_target(RenderTargetHandle _target) const;
+	};
+
+	struct BloomConfig {
+		/* Brightness above which pixels bloom. 0 blooms everything. */
+		float Threshold = 0.8f;
+		float Intensity = 1.0f;
+		/* In texels of each level */
+		float Sigma = 2.0f;
+		/* Half resolution first, then a quarter, and so on */
+		uint32_t LevelCount = 2U;
+		glw::InternalFormat Format = glw::InternalFormat::RGBA16F;
+	};
+
+	/* Blurred rounded box, nine-sliced under every RoundedColorRect with the same corner radius and shadow sigma. Sizes in world units. */
+	struct ShadowMask {
+		glw::Texture* Texture = nullptr;
+		glw::FrameBufferObject* Framebuffer = nullptr;
+		/* How far the shadow reaches past the box */
+		float Padding = 0.0f;
+		/* Slice border : everything closer to the mask edge is a corner or an edge, the rest is constant */
+		float Border = 0.0f;
+		float Size = 0.0f;
+		uint64_t LastUsedFrame = 0ULL;
+	};
+
+	/*
+		Fullscreen passes over pooled render targets : a downsample chain, separable Gaussian blur and bloom.
+		Blur taps land between texel pairs, so bilinear filtering fetches two texels per tap and a kernel of radius 3 sigma
+		costs about 1.5 sigma taps per axis. Every call restores the bound framebuffer and the viewport.
+	*/
+	class PostProcess final {
+	public:
+		/* Must match the uOffsets and uWeights array size of the blur shader */
+		static constexpr uint32_t maximum_blur_taps = 16U;
+		/* The widest sigma whose 3 sigma kernel fits maximum_blur_taps. Downsample first for wider blurs. */
+		static constexpr float maximum_blur_sigma = 10.0f;
+		static constexpr uint32_t maximum_bloom_levels = 6U;
+		/* Masks beyond this many are evicted least recently used first, except those fetched this frame */
+		static constexpr size_t maximum_shadow_masks = 32ULL;
+	private:
+		Server* m_owner = nullptr;
+		glw::VertexArrayObject* m_VAO = nullptr;
+		std::map<std::pair<uint32_t, uint32_t>, ShadowMask> m_shadow_mask_map { };
+	public:
+		PostProcess() = delete;
+		PostProcess(Server* _owner);
+		PostProcess(const PostProcess&) = delete;
+		PostProcess& operator=(const PostProcess&) = delete;
+		~PostProcess();
+	public:
+		/* Half the size of _source, in a pooled target of _format. A positive _threshold keeps only what is brighter than it. */
+		RenderTarget* downsample(const glw::Texture* _source, glw::InternalFormat _format = glw::InternalFormat::RGBA8, float _threshold = 0.0f);
+		/* In place, through a pooled target of the same desc */
+		void blur(RenderTarget* _target, float _sigma);
+		/* _source blurred at 1 / 2^_levels of its size, in a pooled target. _sigma is in texels of the result. */
+		RenderTarget* blur(const glw::Texture* _source, float _sigma, uint32_t _levels = 1U, glw::InternalFormat _format = glw::InternalFormat::RGBA8);
+		/* _source plus its bloom into _target, or the default framebuffer when nullptr, at the size of _source */
+		void bloom(const glw::Texture* _source, const glw::FrameBufferObject* _target, const BloomConfig& _cfg = BloomConfig());
+		/*
+			Built on first use per sigma, rounded to whole units, and per corner radius, rounded to half a sigma since the blur hides the difference.
+			Valid until the next frame's fetches, see maximum_shadow_masks.
+		*/
+		const ShadowMask& fetch_shadow_mask(float _corner_radius, float _sigma);
+		size_t get_shadow_mask_count() const;
+	public:
+		/* Center tap first. Offsets are in texels. Returns the tap count. */
+		static uint32_t compute_blur_taps(float _sigma, float* _out_offsets, float* _out_weights);
+	private:
+		struct SavedBinding {
+			uint32_t Framebuffer = 0U;
+			int X = 0;
+			int Y = 0;
+			uint32_t Width = 0U;
+			uint32_t Height = 0U;
+			bool Scissor = false;
+		};
+		/* Saves the binding and disables the scissor test for the passes */
+		static SavedBinding _begin();
+		/* Restores the binding and the scissor test, and leaves the other capabilities the way the objects' draw() does */
+		static void _end(const SavedBinding& _binding);
+		void _blur_pass(const glw::Texture* _source, const glw::FrameBufferObject* _target, bool _vertical, float _sigma);
+		/* Draws one fullscreen triangle with the program in use. _discard invalidates the target first since it is fully overwritten. */
+		void _draw(const glw::FrameBufferObject* _target, uint32_t _width, uint32_t _height, bool _discard);
+	};
+
+	/* A program rebuilt from shader files, plus the recompile currently in flight for it */
+	struct ShaderRegistryProgram {
+		glw::Program* Program = nullptr;
+		std::string VertexFile { };
+		std::string FragmentFile { };
+		std::vector<std::string> Varyings { };
+		/* Prepended to both files, for sources whose #version and #defines are generated */
+		std::string Header { };
+		glw::Program* Rebuild = nullptr;
+		std::vector<glw::Shader> RebuildShaders { };
+	};
+
+	/*
+		Loads program sources from files in a directory and rebuilds the programs when the files change
+		(inotify on Linux, modification times elsewhere). Rebuilds compile in the background and are moved
+		into the original glw::Program, so every pointer to it stays valid. A failed rebuild keeps the old program.
+	*/
+	class ShaderRegistry final {
+	public:
+		/* Modification times are checked once every this many update() calls where inotify is unavailable */
+		static constexpr uint32_t poll_interval = 30U;
+	private:
+		std::filesystem::path m_directory { };
+		std::vector<ShaderRegistryProgram> m_programs { };
+		std::queue<std::string> m_errors { };
+#ifdef __linux__
+		int m_inotify_descriptor = -1;
+		/* Events read early by add_program() that belong to the next update() */
+		std::set<std::string> m_changed_files { };
+#else
+		std::map<std::string, std::filesystem::file_time_type> m_write_times { };
+		uint32_t m_poll_countdown = 0U;
+#endif
+	public:
+		ShaderRegistry() = delete;
+		ShaderRegistry(const std::string& _directory);
+		ShaderRegistry(const ShaderRegistry&) = delete;
+		ShaderRegistry& operator=(const ShaderRegistry&) = delete;
+		~ShaderRegistry();
+	public:
+		/*
+			Watches _program's shaders. Missing files are created from _vert / _frag (_frag may be null).
+			The program is rebuilt from the files right away, so edits from a previous session apply.
+		*/
+		void add_program(glw::Program* _program, const std::string& _vert_file, const char* _vert, const std::string& _frag_file, const char* _frag, const std::vector<std::string>& _varyings = { }, const std::string& _header = "");
+		/* Call once per frame on the GL thread. Starts rebuilds for changed files and swaps in finished ones. */
+		void update();
+		bool pop_error(std::string& _out);
+	public:
+		const std::filesystem::path& directory() const;
+	private:
+		std::set<std::string> _collect_changed_files();
+		void _rebuild(ShaderRegistryProgram& _entry);
+		bool _read_file(const std::string& _file, std::string& _out) const;
+	};
 
 	class Server final {
 		using GLWObjectSet = std::tuple<glw::VertexArrayObject*, glw::VertexBufferObject*, glw::ElementBufferObject*>;
@@ -90,6 +667,20 @@ namespace glwu {
 				bool,
 				bool
 			>;
+		using TextureArrayKey =
+			std::tuple <
+				int,
+				int,
+				int,
+				glw::FilterType,
+				glw::FilterType,
+				glw::WrappingType,
+				glw::WrappingType,
+				glw::InternalFormat,
+				glw::TextureFormat,
+				glw::DataType,
+				bool
+			>;
 	private:
 		std::vector<GLWObjectSet> m_glw_object_sets { };
 		std::vector<glw::Program*> m_programs { };
@@ -97,24 +688,175 @@ namespace glwu {
 	private:
 		std::map<DrawableType, GLWObjectSet> m_glw_object_set_map { };
 		std::map<DrawableType, glw::Program*> m_program_map { };
-		std::map<TextureKey, glw::Texture*> m_texture_map { };
+		std::map<ShaderFeature, glw::Program*> m_quad_program_map { };
+		std::map<TextureKey, std::weak_ptr<const glw::Texture>> m_texture_map { };
+		std::shared_ptr<TextureReleaseQueue> m_texture_release_queue { std::make_shared<TextureReleaseQueue>() };
+		std::map<TextureKey, TextureLayer> m_texture_layer_map { };
+		std::map<TextureArrayKey, TextureLayer> m_texture_array_cursor_map { };
+		uint32_t m_texture_array_layer_capacity = 16U;
+		std::string m_texture_cache_directory { };
+	private:
+		std::map<const glw::Texture*, TextureResidency> m_texture_residency_map { };
+		size_t m_texture_memory_budget = 0ULL;
+		size_t m_texture_memory_usage = 0ULL;
+		size_t m_texture_upload_budget = 4ULL * 1024ULL * 1024ULL;
+		uint64_t m_frame_index = 0ULL;
+	private:
+		std::vector<std::pair<std::string, AssetPack*>> m_asset_packs { };
 	private:
 		std::vector<Object*> m_objects { };
+	private:
+		glw::Program* m_particle_update_program = nullptr;
+		glw::ComputeProgram* m_rect_batch_cull_program = nullptr;
+		glw::ProgramBinaryCache* m_program_cache = nullptr;
+		std::vector<PendingProgram> m_pending_programs { };
+		std::map<const char*, glw::Shader> m_pending_shaders { };
+		/* Generated sources of the pending programs; a deque keeps their c_str() stable */
+		std::deque<std::string> m_pending_sources { };
+		ShaderRegistry* m_shader_registry = nullptr;
+		UploadThread* m_upload_thread = nullptr;
+		RenderTargetPool* m_render_target_pool = nullptr;
+		PostProcess* m_post_process = nullptr;
+		std::map<PostProcessPass, glw::Program*> m_post_process_program_map { };
+	private:
+		glw::Texture* m_partial_redraw_texture = nullptr;
+		glw::FrameBufferObject* m_partial_redraw_framebuffer = nullptr;
+		uint32_t m_partial_redraw_width = 0U;
+		uint32_t m_partial_redraw_height = 0U;
+		/* Union of the world rects damaged since the last begin_partial_redraw(), as (min x, min y, max x, max y) */
+		glm::vec4 m_damage { 0.0f, 0.0f, 0.0f, 0.0f };
+		float m_damage_padding = 0.0f;
+		bool m_damaged = false;
+		bool m_damaged_all = false;
+		/* Pixel rect being redrawn this frame as (x0, y0, x1, y1), and the matrix it was projected with */
+		glm::ivec4 m_frame_damage { 0, 0, 0, 0 };
+		glm::mat4 m_frame_view_proj_matrix = glm::mat4(1.0f);
 	private:
 		uint32_t m_initial_window_width = 1280;
 		uint32_t m_initial_window_height = 720;
+	public:
+		/* Levels up to this size are uploaded by fetch_texture, larger ones are streamed in while the texture is drawn */
+		static constexpr uint32_t streaming_base_size = 64U;
 	public:
 		Server() = delete;
-		Server(uint32_t _initial_window_width, uint32_t _initial_window_height);
+		/* Linked programs are cached in _program_cache_directory when the driver supports program binaries. Empty disables it. */
+		Server(uint32_t _initial_window_width, uint32_t _initial_window_height, const std::string& _program_cache_directory = "");
 		~Server();
 	public:
-		const glw::Texture* fetch_texture(const std::string& _path, bool _auto_format = false, glw::TextureConfig _cfg = glw::TextureConfig());
+		/*
+			.dds and .ktx2 files are stored top row first and are flipped block by block when _cfg.FilpY is set.
+			Only DXT1 and DXT5 blocks can be flipped, so load BPTC and ETC2 files with FilpY off and author them bottom row first.
+		*/
+		TextureRef fetch_texture(const std::string& _path, bool _auto_format = false, glw::TextureConfig _cfg = glw::TextureConfig());
+		/*
+			Decodes and uploads on the upload thread, then calls _on_ready from end_frame() once the texture is usable.
+			Falls back to fetch_texture() when background uploads are disabled. Asset packs and the texture cache directory
+			are read from the upload thread, so set them up before the first call.
+		*/
+		void fetch_texture_async(const std::string& _path, std::function<void(TextureRef)> _on_ready, bool _auto_format = false, glw::TextureConfig _cfg = glw::TextureConfig());
+		const TextureLayer& fetch_texture_layer(const std::string& _path, bool _auto_format = false, glw::TextureConfig _cfg = glw::TextureConfig());
+	public:
+		/*
+			Decoded images are stored here keyed by source path, mtime and config, so warm starts skip decoding.
+			A compressed FormatInternal makes the driver encode once and the compressed levels are stored instead.
+			Empty disables the cache.
+		*/
+		void set_texture_cache_directory(const std::string& _path);
+		const std::string& get_texture_cache_directory() const;
+	public:
+		/*
+			Textures whose path starts with _prefix are uploaded straight from the mapped pack, without decoding or copying.
+			Packs mounted later take precedence. Entries packed with a different FlippedY than the config fall back to disk.
+		*/
+		const AssetPack* mount_asset_pack(const std::string& _path, const std::string& _prefix = "");
+	public:
+		/* Call on the main thread with the window whose context the server renders through */
+		void enable_background_uploads(glw::Window* _main_window);
+		/* nullptr unless enabled. Submit custom buffer uploads here; end_frame() collects them. */
+		UploadThread* get_upload_thread();
+	public:
+		/* Sized after the initial window size; forward resizes with set_reference_size(). end_frame() recycles it. */
+		RenderTargetPool* get_render_target_pool();
+	public:
+		/* Call once per frame after drawing : release_unused_textures(), update_texture_residency(), finished uploads, pooled render targets and the shader registry */
+		void end_frame();
+		/* Deletes every texture whose last TextureRef has been dropped. Texture arrays live until the server dies. */
+		void release_unused_textures();
+	public:
+		/* Marks a fetched texture as used this frame, reloading it first if it was evicted. Called by draw(). */
+		void touch_texture(const glw::Texture* _tex);
+		/*
+			Called by end_frame(). Evicts least recently used textures while over the memory budget,
+			then streams the next larger level of every texture used this frame, up to the upload budget.
+		*/
+		void update_texture_residency();
+		/* 0 disables eviction */
+		void set_texture_memory_budget(const size_t& _bytes);
+		const size_t& get_texture_memory_budget() const;
+		/* Approximate, counts texture arrays as always resident */
+		const size_t& get_texture_memory_usage() const;
+		/* At least one level is streamed per update regardless */
+		void set_texture_upload_budget(const size_t& _bytes);
+		const size_t& get_texture_upload_budget() const;
+		const uint64_t& get_frame_index() const;
+	public:
+		/* Applies to texture arrays created afterwards. Every array allocates all of its layers up front. */
+		void set_texture_array_layer_capacity(const uint32_t& _value);
+		const uint32_t& get_texture_array_layer_capacity() const;
 	public:
 		const uint32_t& get_initial_window_width() const;
 		const uint32_t& get_initial_window_height() const;
 	public:
 		const GLWObjectSet& get_glw_object_set(const DrawableType& _type) const;
+		/*
+			Sprite, ColorRect and RoundedColorRect map to their default quad permutation. BlendedSprite maps to the
+			single-texture one. Its multi-texture permutations come from fetch_quad_program().
+		*/
 		const glw::Program* get_generic_program(const DrawableType& _type) const;
+		const glw::Program* get_particle_update_program() const;
+	public:
+		/* Compiled on first use, since it needs GL 4.3. */
+		const glw::ComputeProgram* fetch_rect_batch_cull_program();
+		/*
+			The quad uber-shader specialized for _features, compiled on first use and cached by mask.
+			Each permutation is branch-free : features it lacks are removed by the preprocessor.
+		*/
+		const glw::Program* fetch_quad_program(ShaderFeature _features);
+		/* Compiled on first use */
+		const glw::Program* fetch_post_process_program(PostProcessPass _pass);
+		/* Created on first use, on top of get_render_target_pool() */
+		PostProcess* fetch_post_process();
+	public:
+		/*
+			Objects are then drawn into a cached framebuffer of this size, and each frame only the union of the rects damaged
+			by their setters is cleared and redrawn, scissored, before the whole framebuffer is blitted to the window.
+			Call again with the new size on resize. Everything starts out damaged.
+		*/
+		void enable_partial_redraw(uint32_t _width, uint32_t _height);
+		void disable_partial_redraw();
+		bool get_partial_redraw_enabled() const;
+		/* Rects are in world units with y up, like Object::get_bounds(), and grown by _pixel_padding once projected */
+		void add_damage(const glm::vec4& _rect, float _pixel_padding = 0.0f);
+		/* For changes no setter reports, such as pixels written into a fetched texture */
+		void damage_all();
+		/*
+			Binds the cached framebuffer with the scissor set to the damaged pixels, clears them and returns true.
+			Returns false when nothing changed : skip the draws, end_partial_redraw() and the buffer swap to idle.
+			_cam must be the camera the objects are drawn with.
+		*/
+		bool begin_partial_redraw(Camera2D* _cam = nullptr, const glm::vec4& _clear_color = { 0.0f, 0.0f, 0.0f, 1.0f });
+		/* Blits the cached framebuffer to the window and leaves the window bound */
+		void end_partial_redraw();
+		/* Between begin and end, false when _object lies outside the pixels being redrawn so its draw can be skipped. Always true while disabled. */
+		bool intersects_damage(const Object* _object) const;
+	public:
+		/*
+			Writes the built-in shaders into _directory (existing files are kept) and from then on rebuilds
+			the generic programs whenever those files change. end_frame() drives the rebuilds.
+		*/
+		void enable_shader_hot_reload(const std::string& _directory);
+		/* Compile or link logs of failed rebuilds. The previous program keeps running. */
+		bool pop_shader_reload_error(std::string& _out);
 	public:
 		template<typename T>
 		T* fetch_object() {
@@ -122,6 +864,44 @@ namespace glwu {
 			m_objects.emplace_back(_object);
 			return _object;
 		}
+	private:
+		/* Submits without waiting. The program can be used once _finish_programs() returns. */
+		glw::Program* _submit_program(const char* _vert, const char* _frag, const char* const* _varyings = nullptr, uint32_t _varying_count = 0U);
+		/* Waits for every submitted program, throws on compile or link failure, and stores fresh binaries in the cache */
+		void _finish_programs();
+		/* Submits a quad permutation and records it. Uniforms are registered by _register_quad_uniforms() once finished. */
+		glw::Program* _submit_quad_program(ShaderFeature _features);
+		static void _register_quad_uniforms(glw::Program* _program, ShaderFeature _features);
+		static ShaderFeature _normalize_shader_features(ShaderFeature _features);
+		static std::string _make_shader_header(ShaderFeature _features);
+	private:
+		static TextureKey _make_texture_key(const std::string& _path, const glw::TextureConfig& _cfg);
+		static unsigned char* _load_image(const std::string& _path, bool _auto_format, glw::TextureConfig& _cfg, int& _out_width, int& _out_height, int& _out_channels);
+		TextureImage _load_texture_image(const std::string& _path, bool _auto_format, glw::TextureConfig& _cfg) const;
+		TextureImage _load_cached_image(const std::string& _path, bool _auto_format, glw::TextureConfig& _cfg) const;
+		static TextureImage _decode_image(const std::string& _path, bool _auto_format, glw::TextureConfig& _cfg);
+		static void _encode_image(TextureImage& _image, const glw::TextureConfig& _cfg);
+		static void _build_mip_chain(TextureImage& _image);
+		static uint32_t _get_streaming_first_level(const TextureImage& _image);
+		void _reload_texture(TextureResidency& _residency);
+		/* Loads _residency.Path and creates its texture. Only reads server state, so the upload thread may call it. */
+		void _create_texture(TextureResidency& _residency) const;
+		TextureRef _register_texture(const TextureKey& _key, TextureResidency&& _residency);
+		const unsigned char* _find_packed_image(const std::string& _path, bool _auto_format, glw::TextureConfig& _cfg, int& _out_width, int& _out_height, int& _out_channels) const;
+		/* Picks the formats only, so the upload thread may call it */
+		static void _apply_auto_format(glw::TextureConfig& _cfg, int _channels);
+		/* Blend state is per context, so this stays on the calling thread of the fetch_texture*() functions */
+		static void _enable_auto_format_blending();
+		/* Screen rect of _rect as (x0, y0, x1, y1), grown by _pixel_padding plus one pixel and clamped to the target */
+		static glm::ivec4 _project_rect(const glm::vec4& _rect, float _pixel_padding, const glm::mat4& _view_proj_matrix, uint32_t _width, uint32_t _height);
+	private:
+		static TextureImage _load_dds(const std::string& _path);
+		static TextureImage _load_ktx2(const std::string& _path);
+		/* Flips every level upside down in place. False when the format or a level height cannot be flipped without decoding. */
+		static bool _flip_compressed_image(TextureImage& _image);
+		static bool _read_texture_cache(const std::filesystem::path& _path, const std::string& _key, TextureImage& _out);
+		static void _write_texture_cache(const std::filesystem::path& _path, const std::string& _key, const TextureImage& _image);
+		static size_t _get_block_size(const glw::InternalFormat& _format);
 	};
 
 	class Object abstract {
@@ -136,6 +916,13 @@ namespace glwu {
 	private:
 		bool      m_need_to_update_model_matrix = false;
 		glm::mat4 m_model_matrix = glm::mat4(1.0f);
+	private:
+		/* Set until the first update() or draw() with partial redraw enabled, which damages the object once */
+		bool      m_need_initial_damage = true;
+		/* What the object last covered, damaged again by the destructor. Without it the destructor damages everything. */
+		bool      m_has_damaged_bounds = false;
+		glm::vec4 m_damaged_bounds { 0.0f, 0.0f, 0.0f, 0.0f };
+		float     m_damaged_padding = 0.0f;
 	public:
 		Object() = delete;
 		Object(Server* _owner);
@@ -157,6 +944,24 @@ namespace glwu {
 		const glm::vec2& get_scale() const;
 		const glm::vec4& get_modulate() const;
 		const glm::mat4& get_model_matrix() const;
+	public:
+		/*
+			World rect the object draws into as (min x, min y, max x, max y), in model matrix space where y points up.
+			False when it cannot bound itself, in which case its changes damage everything.
+		*/
+		virtual bool get_bounds(glm::vec4& _out) const;
+		/* Pixels the drawing may reach past get_bounds(), for sizes given in pixels such as line widths */
+		virtual float get_bounds_padding() const;
+	protected:
+		/*
+			Reports get_bounds() to the owner while partial redraw is enabled. Setters call it before and after a change,
+			and so do the first update() or draw() and the destructor.
+		*/
+		void _damage();
+		/* Reports a local rect only, for changes to part of the object */
+		void _damage(const glm::vec2& _min, const glm::vec2& _max);
+		/* Bounds of the local rect through the model matrix */
+		glm::vec4 _transform_bounds(const glm::vec2& _min, const glm::vec2& _max) const;
 	private:
 		void _update_model_matrix();
 	};
@@ -177,6 +982,7 @@ namespace glwu {
 		virtual void set_position(const glm::vec2& _value);
 		virtual void set_rotation(const float& _value);
 		virtual void set_scale(const glm::vec2& _value);
+		/* Moving the camera damages everything */
 		void set_zoom(const glm::vec2& _value);
 	public:
 		const glm::vec2& get_zoom()const;
@@ -188,6 +994,8 @@ namespace glwu {
 	};
 
 	class Sprite : public Object {
+	public:
+		static constexpr size_t instance_stride = sizeof(float) * 24ULL;
 	private:
 		const glw::VertexArrayObject* m_VAO = nullptr;
 		const glw::VertexBufferObject* m_VBO = nullptr;
@@ -195,7 +1003,10 @@ namespace glwu {
 	private:
 		const glw::Program* m_program = nullptr;
 	private:
-		const glw::Texture* m_texture = nullptr;
+		TextureRef m_texture { };
+		TextureLayer m_texture_layer { };
+		/* Bumped by every load, so an async load finishing after a newer one is ignored */
+		uint64_t m_load_generation = 0ULL;
 	public:
 		Sprite(Server* _owner);
 		~Sprite() override;
@@ -204,6 +1015,20 @@ namespace glwu {
 		void draw(Camera2D* _cam) override;
 	public:
 		void load(const std::string& _path, bool _auto_format = false, glw::TextureConfig _cfg = glw::TextureConfig());
+		/* Keeps drawing the current texture, if any, until the new one is uploaded in the background */
+		void load_async(const std::string& _path, bool _auto_format = false, glw::TextureConfig _cfg = glw::TextureConfig());
+		/* Packs the image into a texture array layer, so sprites with different images can share a draw_batch() call */
+		void load_layered(const std::string& _path, bool _auto_format = false, glw::TextureConfig _cfg = glw::TextureConfig());
+		/* Drops the texture reference, so the texture can be released once nothing else uses it */
+		void unload();
+	public:
+		bool get_bounds(glm::vec4& _out) const override;
+	public:
+		/* Draws in order. Runs of layered sprites on the same texture array share one instanced call. */
+		static void draw_batch(Server* _owner, const std::vector<Sprite*>& _sprites, Camera2D* _cam = nullptr);
+	private:
+		void _add_instance(glw::BufferData& _out) const;
+		static void _draw_instances(Server* _owner, const glw::Texture* _texture, const glw::BufferData& _instances, uint32_t _count, Camera2D* _cam);
 	};
 
 	class BlendedSprite : public Object {
@@ -218,7 +1043,7 @@ namespace glwu {
 	private:
 		uint32_t m_base_width = 0U;
 		uint32_t m_base_height = 0U;
-		std::vector<const glw::Texture*> m_textures { };
+		std::vector<TextureRef> m_textures { };
 	public:
 		BlendedSprite(Server* _owner);
 		~BlendedSprite() override;
@@ -232,6 +1057,8 @@ namespace glwu {
 		void load_extra_texture(const std::string& _path, bool _auto_format = false, glw::TextureConfig _cfg = glw::TextureConfig());
 	public:
 		size_t get_loaded_texture_count() const;
+	public:
+		bool get_bounds(glm::vec4& _out) const override;
 	};
 
 	class ColoredObject : public Object {
@@ -256,8 +1083,11 @@ namespace glwu {
 	};
 
 	class Line final : public ColoredObject {
+	public:
+		static constexpr size_t segment_stride = sizeof(float) * 16ULL;
 	private:
 		float m_width = 1.0f;
+		LineCap m_cap = LineCap::Butt;
 	private:
 		glm::vec2 m_point_begin = { 0.0f, 0.0f };
 		glm::vec2 m_point_end = { 100.0f, 100.0f };
@@ -269,12 +1099,27 @@ namespace glwu {
 		void draw(Camera2D* _cam) override;
 	public:
 		void set_width(const float& _value);
+		void set_cap(const LineCap& _value);
 		void set_begin(const glm::vec2& _value);
 		void set_end(const glm::vec2& _value);
 	public:
 		const float& get_width() const;
+		const LineCap& get_cap() const;
 		const glm::vec2& get_begin() const;
 		const glm::vec2& get_end() const;
+	public:
+		bool get_bounds(glm::vec4& _out) const override;
+		float get_bounds_padding() const override;
+	public:
+		static void draw_batch(Server* _owner, const std::vector<Line*>& _lines, Camera2D* _cam = nullptr);
+	public:
+		/* Points are in world space, widths in pixels. A neighbor equal to its end point caps that end. */
+		static void add_segment(glw::BufferData& _out, const glm::vec2& _prev, const glm::vec2& _begin, const glm::vec2& _end, const glm::vec2& _next, const glm::vec4& _color, float _width, LineCap _cap, LineJoin _join, bool _pixel_snapped);
+		static void draw_segments(Server* _owner, const glw::BufferData& _segments, uint32_t _count, Camera2D* _cam);
+		/* Pixels a segment of _width reaches past its points, sharpest miter included */
+		static float get_pixel_extent(float _width);
+	private:
+		void _add_segment(glw::BufferData& _out) const;
 	};
 
 	class LinedRect final : public ColoredObject {
@@ -282,6 +1127,7 @@ namespace glwu {
 		glm::vec2 m_size{ 100.0f, 100.0f };
 	private:
 		float m_line_width = 1.0f;
+		LineJoin m_line_join = LineJoin::Miter;
 	public:
 		LinedRect(Server* _owner);
 		~LinedRect();
@@ -290,10 +1136,74 @@ namespace glwu {
 		void draw(Camera2D* _cam) override;
 	public:
 		void set_line_width(const float& _value);
+		void set_line_join(const LineJoin& _value);
 		void set_size(const glm::vec2& _value);
 	public:
 		const float& get_line_width() const;
+		const LineJoin& get_line_join() const;
 		const glm::vec2& get_size() const;
+	public:
+		bool get_bounds(glm::vec4& _out) const override;
+		float get_bounds_padding() const override;
+	};
+
+	/*
+		Streaming line strip drawn with a single instanced call.
+		Points live in a ring buffer mirrored twice in the VBO, so the live window is always contiguous
+		and only the points written since the last draw are uploaded.
+	*/
+	class Polyline final : public ColoredObject {
+	public:
+		static constexpr size_t default_capacity = 1024ULL;
+	private:
+		glw::VertexArrayObject* m_point_VAO = nullptr;
+		glw::VertexBufferObject* m_point_VBO = nullptr;
+	private:
+		std::vector<glm::vec2> m_points { };
+		size_t m_head = 0ULL;
+		size_t m_count = 0ULL;
+	private:
+		bool   m_need_to_reallocate = true;
+		size_t m_dirty_begin = SIZE_MAX;
+		size_t m_dirty_end = 0ULL;
+		size_t m_bound_head = SIZE_MAX;
+	private:
+		float m_width = 1.0f;
+		LineCap m_cap = LineCap::Butt;
+		LineJoin m_join = LineJoin::Miter;
+	public:
+		Polyline(Server* _owner);
+		~Polyline();
+	public:
+		void update() override;
+		void draw(Camera2D* _cam) override;
+	public:
+		void set_capacity(size_t _value);
+		void push_back(const glm::vec2& _value);
+		void append(const std::vector<glm::vec2>& _values);
+		void pop_front(size_t _count = 1ULL);
+		void clear();
+	public:
+		/* Throws std::out_of_range past get_point_count(), like get_point() */
+		void set_point(size_t _index, const glm::vec2& _value);
+		void set_width(const float& _value);
+		void set_cap(const LineCap& _value);
+		void set_join(const LineJoin& _value);
+	public:
+		const glm::vec2& get_point(size_t _index) const;
+		size_t get_point_count() const;
+		size_t get_capacity() const;
+		const float& get_width() const;
+		const LineCap& get_cap() const;
+		const LineJoin& get_join() const;
+	public:
+		bool get_bounds(glm::vec4& _out) const override;
+		float get_bounds_padding() const override;
+	private:
+		void _write(size_t _slot, const glm::vec2& _value);
+		void _upload();
+		/* Damages the points in [_first, _last] only, plus their neighbors whose joins they bend */
+		void _damage_points(size_t _first, size_t _last);
 	};
 
 	class ColorRect final : public ColoredObject {
@@ -309,15 +1219,25 @@ namespace glwu {
 		void set_size(const glm::vec2& _value);
 	public:
 		const glm::vec2& get_size() const;
+	public:
+		bool get_bounds(glm::vec4& _out) const override;
 	};
 
 	class RoundedColorRect final : public ColoredObject {
+	public:
+		static constexpr size_t instance_stride = sizeof(float) * 32ULL;
 	private:
 		float m_outline_width = 1.0f;
 		glm::vec4 m_outline_color { 1.0f, 1.0f, 1.0f, 1.0f };
 	private:
-		float m_corner_radius = 0.5f;
+		/* Normalized to half of the shorter side, ordered as (top-left, top-right, bottom-right, bottom-left) */
+		glm::vec4 m_corner_radii { 0.5f, 0.5f, 0.5f, 0.5f };
 		glm::vec2 m_size { 100.0f, 100.0f };
+	private:
+		bool m_shadow_enabled = false;
+		glm::vec4 m_shadow_color { 0.0f, 0.0f, 0.0f, 0.5f };
+		glm::vec2 m_shadow_offset { 0.0f, 4.0f };
+		float m_shadow_sigma = 8.0f;
 	public:
 		RoundedColorRect(Server* _owner);
 		~RoundedColorRect();
@@ -329,11 +1249,150 @@ namespace glwu {
 		void set_outline_width(const float& _value);
 		void set_outline_color(const glm::vec4& _value);
 		void set_corner_radius(const float& _value);
+		void set_corner_radii(const glm::vec4& _value);
+	public:
+		/*
+			Drop shadow drawn under the rect from a blurred mask that PostProcess caches per corner radius and sigma,
+			so panels sharing them skip the blur. The mask uses the largest corner radius.
+		*/
+		void set_shadow_enabled(bool _value);
+		void set_shadow_color(const glm::vec4& _value);
+		/* World units, with y pointing down like set_position() */
+		void set_shadow_offset(const glm::vec2& _value);
+		void set_shadow_sigma(const float& _value);
 	public:
 		const glm::vec2& get_size() const;
 		const float& get_outline_width() const;
 		const glm::vec4& get_outline_color() const;
 		const float& get_corner_radius() const;
+		const glm::vec4& get_corner_radii() const;
+		bool get_shadow_enabled() const;
+		const glm::vec4& get_shadow_color() const;
+		const glm::vec2& get_shadow_offset() const;
+		const float& get_shadow_sigma() const;
+	public:
+		/* Shadow included */
+		bool get_bounds(glm::vec4& _out) const override;
+	public:
+		/* Shadows of the whole batch go first, so no rect is covered by a neighbor's shadow */
+		static void draw_batch(Server* _owner, const std::vector<RoundedColorRect*>& _rects, Camera2D* _cam = nullptr);
+	private:
+		void _add_instance(glw::BufferData& _out) const;
+		void _add_shadow_instance(glw::BufferData& _out, const ShadowMask& _mask) const;
+		const ShadowMask& _fetch_shadow_mask();
+		/* Rounded and Outlined only when the rect needs them */
+		ShaderFeature _get_shader_features() const;
+		static void _draw_shadows(Server* _owner, const std::vector<RoundedColorRect*>& _rects, Camera2D* _cam);
+		/* _shadow is bound as the mask of the Shadow permutation */
+		static void _draw_instances(Server* _owner, const glw::BufferData& _instances, uint32_t _count, ShaderFeature _features, Camera2D* _cam, const ShadowMask* _shadow = nullptr);
+	};
+
+	/* Angles are in radians and sizes in world units; ranges are (min, max). */
+	struct ParticleEmitterConfig {
+		float Rate = 100.0f;
+		float Radius = 0.0f;
+		float Direction = -1.57079632679f;
+		float Spread = 0.5f;
+		glm::vec2 SpeedRange { 50.0f, 100.0f };
+		glm::vec2 LifetimeRange { 1.0f, 2.0f };
+		glm::vec2 Acceleration { 0.0f, 0.0f };
+		float Damping = 0.0f;
+		glm::vec4 StartColor { 1.0f, 1.0f, 1.0f, 1.0f };
+		glm::vec4 EndColor { 1.0f, 1.0f, 1.0f, 0.0f };
+		float StartSize = 4.0f;
+		float EndSize = 0.0f;
+		bool Additive = false;
+	};
+
+	/*
+		Particle state lives in two GPU buffers that are ping-ponged through transform feedback,
+		so the CPU only advances an emission cursor and issues two draw calls per frame.
+	*/
+	class ParticleSystem final : public Object {
+	public:
+		static constexpr size_t default_capacity = 4096ULL;
+		static constexpr size_t particle_stride = sizeof(float) * 8ULL;
+		static constexpr float maximum_delta_time = 0.1f;
+	private:
+		glw::VertexBufferObject* m_VBOs[2] = { nullptr, nullptr };
+		glw::VertexArrayObject* m_update_VAOs[2] = { nullptr, nullptr };
+		glw::VertexArrayObject* m_render_VAOs[2] = { nullptr, nullptr };
+		size_t m_current = 0ULL;
+	private:
+		const glw::Program* m_update_program = nullptr;
+		const glw::Program* m_program = nullptr;
+	private:
+		ParticleEmitterConfig m_config { };
+		size_t m_capacity = 0ULL;
+		bool   m_emitting = true;
+	private:
+		double   m_last_time = -1.0;
+		float    m_emit_accumulator = 0.0f;
+		size_t   m_emit_cursor = 0ULL;
+		size_t   m_pending_burst = 0ULL;
+		uint32_t m_seed = 0U;
+		/* Time the last emitted particle dies by. Until then every update damages everything. */
+		double   m_live_until = -1.0;
+		/* Set while particles live, so the update they all die in still damages the last drawn frame */
+		bool     m_was_live = false;
+	public:
+		ParticleSystem(Server* _owner);
+		~ParticleSystem() override;
+	public:
+		void update() override;
+		void draw(Camera2D* _cam) override;
+	public:
+		void set_config(const ParticleEmitterConfig& _value);
+		void set_capacity(size_t _value);
+		void set_emitting(bool _value);
+		void burst(size_t _count);
+	public:
+		const ParticleEmitterConfig& get_config() const;
+		size_t get_capacity() const;
+		bool get_emitting() const;
+	private:
+		void _simulate(float _delta, size_t _emit_count);
+	};
+
+	/*
+		Static rects grouped into chunks and submitted with a single multi-draw-indirect call, one command per group.
+		With culling enabled, a compute pass zeroes the instance count of every group outside the view first.
+		Requires GL 4.3.
+	*/
+	class RectBatch final : public Object {
+	public:
+		static constexpr size_t instance_stride = sizeof(float) * 8ULL;
+	private:
+		glw::VertexArrayObject* m_batch_VAO = nullptr;
+		glw::VertexBufferObject* m_instance_VBO = nullptr;
+		glw::ShaderStorageBufferObject* m_group_SSBO = nullptr;
+		glw::DrawIndirectBufferObject* m_command_buffer = nullptr;
+	private:
+		const glw::Program* m_program = nullptr;
+	private:
+		/* Each rect takes two entries : (center, size) and color */
+		std::vector<std::vector<glm::vec4>> m_groups { };
+		bool m_need_to_upload = true;
+		bool m_culling = false;
+	public:
+		RectBatch(Server* _owner);
+		~RectBatch() override;
+	public:
+		void update() override;
+		void draw(Camera2D* _cam) override;
+	public:
+		size_t add_group();
+		void add_rect(size_t _group, const glm::vec2& _position, const glm::vec2& _size, const glm::vec4& _color);
+		void clear_group(size_t _group);
+		void clear();
+	public:
+		void set_culling(bool _value);
+	public:
+		bool get_culling() const;
+		size_t get_group_count() const;
+		size_t get_rect_count() const;
+	private:
+		void _upload();
 	};
 }
 
@@ -0,0 +1,116 @@
+/*
+	glwu_pack
+	Builds a glwu asset pack from every image under a directory.
+	Entries are named by their path relative to the directory ('/' separated),
+	so mount the pack with that directory as prefix :
+		_server->mount_asset_pack("assets.glwp", "assets");
+
+	Usage
+		glwu_pack <input directory> <output file> [--no-flip]
+*/
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <glwu.hpp>
+
+#include <algorithm> // std::sort
+#include <iostream>  // std::cout, std::cerr
+
+struct PackedImage {
+	std::string Name { };
+	int Width = 0;
+	int Height = 0;
+	int Channels = 0;
+	unsigned char* Data = nullptr;
+};
+
+static uint64_t align_up(uint64_t _value) {
+	return (_value + glwu::AssetPackAlignment - 1U) & ~(glwu::AssetPackAlignment - 1U);
+}
+
+int main(int argc, char** argv) {
+	if (argc < 3) {
+		std::cerr << "Usage : glwu_pack <input directory> <output file> [--no-flip]" << std::endl;
+		return 1;
+	}
+	const std::filesystem::path _input = argv[1];
+	const std::filesystem::path _output = argv[2];
+	const bool _flip_y = !(argc > 3 && std::string(argv[3]) == "--no-flip");
+
+	std::error_code _error;
+	if (std::filesystem::is_directory(_input, _error) == false) {
+		std::cerr << "Not a directory : " << _input.string() << std::endl;
+		return 1;
+	}
+
+	/* Same orientation fetch_texture gives with TextureConfig::FilpY */
+	stbi_set_flip_vertically_on_load(_flip_y);
+
+	std::vector<PackedImage> _images { };
+	for (const auto& _file : std::filesystem::recursive_directory_iterator(_input)) {
+		if (_file.is_regular_file() == false) {
+			continue;
+		}
+		PackedImage _image;
+		_image.Name = std::filesystem::relative(_file.path(), _input).lexically_normal().generic_string();
+		_image.Data = stbi_load(_file.path().string().c_str(), &_image.Width, &_image.Height, &_image.Channels, 0);
+		if (_image.Data == nullptr) {
+			std::cout << "skip : " << _image.Name << " (" << stbi_failure_reason() << ")" << std::endl;
+			continue;
+		}
+		_images.emplace_back(std::move(_image));
+	}
+	std::sort(_images.begin(), _images.end(), [](const PackedImage& _a, const PackedImage& _b) { return _a.Name < _b.Name; });
+
+	glwu::AssetPackHeader _header;
+	_header.EntryCount = static_cast<uint32_t>(_images.size());
+
+	std::vector<glwu::AssetPackEntry> _entries(_images.size());
+	std::string _names { };
+	for (size_t i = 0; i < _images.size(); i++) {
+		_entries[i].NameOffset = static_cast<uint32_t>(_names.size());
+		_entries[i].NameLength = static_cast<uint32_t>(_images[i].Name.size());
+		_names += _images[i].Name;
+	}
+	_header.NameTableLength = static_cast<uint32_t>(_names.size());
+
+	uint64_t _offset = align_up(sizeof(glwu::AssetPackHeader) + _entries.size() * sizeof(glwu::AssetPackEntry) + _names.size());
+	for (size_t i = 0; i < _images.size(); i++) {
+		_entries[i].DataOffset = _offset;
+		_entries[i].DataLength = static_cast<uint64_t>(_images[i].Width) * _images[i].Height * _images[i].Channels;
+		_entries[i].Width = static_cast<uint32_t>(_images[i].Width);
+		_entries[i].Height = static_cast<uint32_t>(_images[i].Height);
+		_entries[i].Channels = static_cast<uint32_t>(_images[i].Channels);
+		_entries[i].FlippedY = _flip_y ? 1U : 0U;
+		_offset = align_up(_offset + _entries[i].DataLength);
+	}
+
+	std::ofstream _stream(_output, std::ios::binary | std::ios::trunc);
+	if (_stream.is_open() == false) {
+		std::cerr << "Cannot open output : " << _output.string() << std::endl;
+		return 1;
+	}
+	const char _padding[glwu::AssetPackAlignment] = { };
+	auto _pad = [&_stream, &_padding]() {
+		const uint64_t _position = static_cast<uint64_t>(_stream.tellp());
+		_stream.write(_padding, static_cast<std::streamsize>(align_up(_position) - _position));
+	};
+
+	_stream.write(reinterpret_cast<const char*>(&_header), sizeof(_header));
+	_stream.write(reinterpret_cast<const char*>(_entries.data()), static_cast<std::streamsize>(_entries.size() * sizeof(glwu::AssetPackEntry)));
+	_stream.write(_names.data(), static_cast<std::streamsize>(_names.size()));
+	_pad();
+	for (size_t i = 0; i < _images.size(); i++) {
+		_stream.write(reinterpret_cast<const char*>(_images[i].Data), static_cast<std::streamsize>(_entries[i].DataLength));
+		_pad();
+		stbi_image_free(_images[i].Data);
+		std::cout << "pack : " << _images[i].Name << " (" << _images[i].Width << "x" << _images[i].Height << "x" << _images[i].Channels << ")" << std::endl;
+	}
+	_stream.close();
+
+	if (_stream.fail()) {
+		std::cerr << "Failed to write : " << _output.string() << std::endl;
+		return 1;
+	}
+	std::cout << _images.size() << " images -> " << _output.string() << " (" << _offset << " bytes)" << std::endl;
+	return 0;
+}